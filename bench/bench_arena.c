@@ -0,0 +1,103 @@
+/**
+ * @file bench_arena.c
+ * @brief Compara a carga da Trie com nós no heap e com nós na arena.
+ *
+ * Cada cenário roda em um processo filho, para que o RSS medido
+ * não seja contaminado pelo cenário anterior.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "arena.h"
+#include "bench_util.h"
+#include "trie.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define PALAVRAS_PADRAO 2000000
+
+/*
+ * Implementação:
+ * - Insere todo o corpus e remove 1 a cada 4 palavras, medindo
+ *   tempo de carga, RSS após a carga e tempo de destruição.
+ */
+static void executar_cenario(const char* nome,
+                             bool usar_arena,
+                             const char* corpus,
+                             size_t n) {
+    arena_nos* arena = usar_arena ? arena_criar(0) : NULL;
+    no_trie* raiz = usar_arena ? arena_alocar_no(arena) : trie_criar();
+    if (!raiz) {
+        fprintf(stderr, "%s: falha ao criar raiz\n", nome);
+        exit(1);
+    }
+
+    long rss_inicial = rss_kib();
+
+    double inicio = agora_ms();
+    for (size_t i = 0; i < n; i++) {
+        trie_inserir(raiz, arena, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    double carga = agora_ms() - inicio;
+
+    long rss_carga = rss_kib() - rss_inicial;
+
+    inicio = agora_ms();
+    for (size_t i = 0; i < n; i += 4) {
+        trie_remover(raiz, arena, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    double remocao = agora_ms() - inicio;
+
+    inicio = agora_ms();
+    if (usar_arena) {
+        arena_destruir(arena);
+    } else {
+        trie_destruir(raiz);
+    }
+    double destruicao = agora_ms() - inicio;
+
+    printf("%-6s carga=%9.1f ms  rss=%8ld KiB  remocao=%8.1f ms  "
+           "destruicao=%8.1f ms\n",
+           nome,
+           carga,
+           rss_carga,
+           remocao,
+           destruicao);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    if (!corpus) {
+        fprintf(stderr, "falha ao gerar corpus\n");
+        return 1;
+    }
+
+    printf("bench_arena: %zu palavras\n", n);
+    fflush(stdout);
+
+    const char* nomes[] = {"heap", "arena"};
+    for (int i = 0; i < 2; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            executar_cenario(nomes[i], i == 1, corpus, n);
+            fflush(stdout);
+            _exit(0);
+        }
+        if (pid > 0) {
+            waitpid(pid, NULL, 0);
+        }
+    }
+
+    free(corpus);
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file bench_balanceado.c
+ * @brief Compara a carga em ordem de arquivo com a carga balanceada.
+ *
+ * O arquivo de entrada está em ordem alfabética, o pior caso para a
+ * carga em ordem de arquivo. A carga balanceada ordena as palavras e
+ * insere as medianas primeiro; a carga com rotações lê o arquivo em
+ * ordem com os irmãos mantidos balanceados
+ * (dicionario_balancear_irmaos).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PALAVRAS_PADRAO 500000
+#define TAM_MAX_PALAVRA 16
+
+typedef enum { CARGA_ARQUIVO, CARGA_MEDIANAS, CARGA_ROTACOES } modo_carga;
+
+static int comparar(const void* a, const void* b) {
+    return strcmp((const char*) a, (const char*) b);
+}
+
+/*
+ * Implementação:
+ * - Gera 'n' palavras aleatórias, ordena e grava uma por linha
+ *   em um arquivo temporário, cujo caminho é copiado para 'caminho'.
+ */
+static char* gerar_arquivo_ordenado(size_t n, char* caminho) {
+    char* corpus = malloc(n * TAM_MAX_PALAVRA);
+    if (!corpus) {
+        return NULL;
+    }
+
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < n; i++) {
+        char* palavra = corpus + (i * TAM_MAX_PALAVRA);
+        size_t tam = 3 + (proximo_aleatorio(&estado) % 13);
+        for (size_t j = 0; j < tam; j++) {
+            palavra[j] = (char) ('a' + (proximo_aleatorio(&estado) % 26));
+        }
+        palavra[tam] = '\0';
+    }
+    qsort(corpus, n, TAM_MAX_PALAVRA, comparar);
+
+    int fd = mkstemp(caminho);
+    FILE* f = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!f) {
+        free(corpus);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        fprintf(f, "%s\n", corpus + (i * TAM_MAX_PALAVRA));
+    }
+    fclose(f);
+
+    return corpus;
+}
+
+/*
+ * Implementação:
+ * - Carrega o arquivo no modo informado e busca cada palavra do
+ *   corpus com uma busca por prefixo limitada a 1 resultado.
+ */
+static void executar_cenario(const char* nome,
+                             modo_carga modo,
+                             const char* caminho,
+                             const char* corpus,
+                             size_t n) {
+    dicionario* d = dicionario_criar();
+    if (!d) {
+        return;
+    }
+
+    double inicio = agora_ms();
+    if (modo == CARGA_MEDIANAS) {
+        dicionario_adicionar_de_arquivo_balanceado(d, caminho);
+    } else {
+        if (modo == CARGA_ROTACOES) {
+            dicionario_balancear_irmaos(d);
+        }
+        dicionario_adicionar_de_arquivo(d, caminho);
+    }
+    double carga = agora_ms() - inicio;
+
+    double media = 0.0;
+    size_t maximo = 0;
+    dicionario_medir_caminhos(d, &media, &maximo);
+
+    estatisticas_dicionario estatisticas;
+    dicionario_estatisticas(d, &estatisticas, true);
+
+    inicio = agora_ms();
+    for (size_t i = 0; i < n; i++) {
+        size_t quantidade = 0;
+        char** r = dicionario_buscar_por_prefixo_limitado(
+            d, corpus + (i * TAM_MAX_PALAVRA), 1, &quantidade);
+        trie_liberar_lista(r, quantidade);
+    }
+    double busca = agora_ms() - inicio;
+
+    printf("%-11s carga=%8.1f ms  caminho medio=%6.2f  maximo=%4zu  "
+           "irmaos: altura maxima=%3zu media=%5.2f  busca=%8.1f ms\n",
+           nome,
+           carga,
+           media,
+           maximo,
+           estatisticas.varredura.altura_maxima_irmaos,
+           estatisticas.varredura.altura_media_irmaos,
+           busca);
+
+    dicionario_destruir(d);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+
+    char caminho[] = "/tmp/bench_balanceadoXXXXXX";
+    char* corpus = gerar_arquivo_ordenado(n, caminho);
+    if (!corpus) {
+        fprintf(stderr, "falha ao gerar corpus\n");
+        return 1;
+    }
+
+    printf("bench_balanceado: %zu palavras ordenadas\n", n);
+    executar_cenario("arquivo", CARGA_ARQUIVO, caminho, corpus, n);
+    executar_cenario("balanceado", CARGA_MEDIANAS, caminho, corpus, n);
+    executar_cenario("rotacoes", CARGA_ROTACOES, caminho, corpus, n);
+
+    unlink(caminho);
+    free(corpus);
+    return 0;
+}
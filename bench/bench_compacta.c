@@ -0,0 +1,137 @@
+/**
+ * @file bench_compacta.c
+ * @brief Compara a Trie de ponteiros com a Trie compacta de índices.
+ *
+ * Mede memória por palavra, tempo de carga e latência de consulta
+ * sobre o mesmo corpus. O dicionário padrão ocupa bem mais que o
+ * cache de último nível, de modo que o tamanho do nó pesa nas faltas
+ * de cache de cada descida.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "arena.h"
+#include "bench_util.h"
+#include "trie.h"
+#include "trie_compacta.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PALAVRAS_PADRAO 2000000
+#define CONSULTAS_PADRAO 2000000
+
+/*
+ * Implementação:
+ * - Imprime uma linha de resultado no mesmo formato para as duas
+ *   representações.
+ */
+static void imprimir(const char* nome,
+                     double carga,
+                     size_t bytes_usados,
+                     size_t bytes_reservados,
+                     size_t palavras,
+                     double consulta,
+                     size_t m,
+                     size_t acertos) {
+    printf("%-9s carga=%8.1f ms  bytes/palavra=%6.1f (reservados %6.1f)"
+           "  consulta=%6.1f ns  acertos=%zu\n",
+           nome,
+           carga,
+           (double) bytes_usados / (double) palavras,
+           (double) bytes_reservados / (double) palavras,
+           consulta * 1e6 / (double) m,
+           acertos);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t m = CONSULTAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        m = strtoul(argv[2], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    char* ausentes = gerar_corpus(m, 0xD1B54A32D192ED03ULL);
+    const char** consultas = malloc(m * sizeof *consultas);
+    arena_nos* arena = arena_criar(0);
+    no_trie* raiz = arena ? arena_alocar_no(arena) : NULL;
+    trie_compacta* compacta = trie_compacta_criar();
+    if (!corpus || !ausentes || !consultas || !raiz || !compacta) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    // Metade das consultas são palavras do corpus, em ordem aleatória
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        if (proximo_aleatorio(&estado) & 1) {
+            size_t j = proximo_aleatorio(&estado) % n;
+            consultas[i] = corpus + (j * TAM_PALAVRA_CORPUS);
+        } else {
+            consultas[i] = ausentes + (i * TAM_PALAVRA_CORPUS);
+        }
+    }
+
+    double inicio = agora_ms();
+    size_t palavras = 0;
+    for (size_t i = 0; i < n; i++) {
+        palavras += trie_inserir(
+            raiz, arena, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    double carga = agora_ms() - inicio;
+
+    size_t acertos = 0;
+    inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        acertos += trie_contem(raiz, consultas[i]);
+    }
+    double consulta = agora_ms() - inicio;
+
+    printf("bench_compacta: %zu palavras, %zu consultas, nó %zu vs %zu bytes\n",
+           palavras,
+           m,
+           sizeof(no_trie),
+           sizeof(no_compacto));
+    imprimir("ponteiros",
+             carga,
+             arena->nos_ativos * sizeof(no_trie),
+             arena_bytes_reservados(arena),
+             palavras,
+             consulta,
+             m,
+             acertos);
+    arena_destruir(arena);
+
+    inicio = agora_ms();
+    for (size_t i = 0; i < n; i++) {
+        trie_compacta_inserir(compacta, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    carga = agora_ms() - inicio;
+
+    acertos = 0;
+    inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        acertos += trie_compacta_contem(compacta, consultas[i]);
+    }
+    consulta = agora_ms() - inicio;
+
+    imprimir("compacta",
+             carga,
+             (size_t) compacta->nos_ativos * sizeof(no_compacto),
+             trie_compacta_bytes_reservados(compacta),
+             compacta->total_palavras,
+             consulta,
+             m,
+             acertos);
+
+    trie_compacta_destruir(compacta);
+    free((void*) consultas);
+    free(ausentes);
+    free(corpus);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file bench_dawg.c
+ * @brief Compara o dicionário em Trie com o dicionário congelado (DAWG).
+ *
+ * O corpus combina radicais aleatórios com terminações comuns do
+ * português, de modo que muitas palavras compartilham sufixos, como
+ * em uma lista de palavras real. Um arquivo (uma palavra por linha)
+ * pode ser usado no lugar do corpus gerado.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RADICAIS_PADRAO 100000
+#define CONSULTAS_PADRAO 1000000
+#define TAM_MAX_PALAVRA 32
+
+static const char* const terminacoes[] = {
+    "",      "a",     "o",      "as",    "os",     "ar",    "er",
+    "ir",    "ado",   "ada",    "ando",  "endo",   "ção",   "ções",
+    "mente", "dor",   "dora",   "ável",  "ível",   "ismo",  "ista",
+    "eza",   "ava",   "avam",   "aria",  "ariam",  "ou",    "aram",
+};
+
+#define TOTAL_TERMINACOES (sizeof terminacoes / sizeof *terminacoes)
+
+/*
+ * Implementação:
+ * - Para cada radical de 3 a 8 letras, adiciona entre 1 e 8 palavras
+ *   com terminações sorteadas.
+ */
+static void gerar_radicais(dicionario* d, size_t radicais) {
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    char palavra[TAM_MAX_PALAVRA];
+
+    for (size_t i = 0; i < radicais; i++) {
+        size_t tam = 3 + (proximo_aleatorio(&estado) % 6);
+        for (size_t j = 0; j < tam; j++) {
+            palavra[j] = (char) ('a' + (proximo_aleatorio(&estado) % 26));
+        }
+
+        size_t variantes = 1 + (proximo_aleatorio(&estado) % 8);
+        for (size_t v = 0; v < variantes; v++) {
+            const char* terminacao =
+                terminacoes[proximo_aleatorio(&estado) % TOTAL_TERMINACOES];
+            snprintf(palavra + tam,
+                     sizeof palavra - tam,
+                     "%s",
+                     terminacao);
+            dicionario_adicionar_palavra(d, palavra);
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Consulta as palavras sorteadas e mede o tempo total.
+ */
+static double medir_consultas(const dicionario* d,
+                              char* const* consultas,
+                              size_t m,
+                              size_t* acertos) {
+    *acertos = 0;
+    double inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        *acertos += dicionario_contem(d, consultas[i]);
+    }
+    return agora_ms() - inicio;
+}
+
+/*
+ * Implementação:
+ * - Imprime uma linha de resultado no mesmo formato para as duas
+ *   representações.
+ */
+static void imprimir(const char* nome,
+                     const estatisticas_dicionario* e,
+                     double consulta,
+                     size_t m,
+                     size_t acertos) {
+    printf("%-9s nós=%9zu  bytes/palavra=%6.1f  consulta=%6.1f ns"
+           "  acertos=%zu\n",
+           nome,
+           e->nos,
+           (double) e->bytes_usados / (double) e->palavras,
+           consulta * 1e6 / (double) m,
+           acertos);
+}
+
+int main(int argc, char** argv) {
+    size_t m = CONSULTAS_PADRAO;
+    dicionario* d = dicionario_criar();
+    if (!d) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    if (argc > 1 && strtoul(argv[1], NULL, 10) == 0) {
+        if (!dicionario_adicionar_de_arquivo(d, argv[1])) {
+            fprintf(stderr, "falha ao ler %s\n", argv[1]);
+            dicionario_destruir(d);
+            return 1;
+        }
+    } else {
+        gerar_radicais(d, argc > 1 ? strtoul(argv[1], NULL, 10)
+                                 : RADICAIS_PADRAO);
+    }
+
+    size_t n = 0;
+    char** palavras = dicionario_listar_palavras(d, &n);
+    char** consultas = malloc(m * sizeof *consultas);
+    if (!palavras || !consultas) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        consultas[i] = palavras[proximo_aleatorio(&estado) % n];
+    }
+
+    printf("bench_dawg: %zu palavras, %zu consultas\n", n, m);
+
+    estatisticas_dicionario e;
+    size_t acertos = 0;
+    double consulta = medir_consultas(d, consultas, m, &acertos);
+    dicionario_estatisticas(d, &e, false);
+    imprimir("trie", &e, consulta, m, acertos);
+
+    double inicio = agora_ms();
+    if (!dicionario_congelar(d)) {
+        fprintf(stderr, "falha ao congelar\n");
+        return 1;
+    }
+    double congelamento = agora_ms() - inicio;
+
+    consulta = medir_consultas(d, consultas, m, &acertos);
+    dicionario_estatisticas(d, &e, false);
+    imprimir("dawg", &e, consulta, m, acertos);
+    printf("congelamento=%.1f ms\n", congelamento);
+
+    free(consultas);
+    trie_liberar_lista(palavras, n);
+    dicionario_destruir(d);
+    return 0;
+}
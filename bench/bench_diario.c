@@ -0,0 +1,174 @@
+/**
+ * @file bench_diario.c
+ * @brief Mede o custo do diário de alterações e o tempo de reabertura.
+ *
+ * Primeiro insere as mesmas palavras em um dicionário comum e em
+ * dicionários persistentes com lotes de sincronização diferentes
+ * (lote 1 sincroniza a cada palavra e usa só as primeiras palavras).
+ * Depois compara a reabertura só pelo diário (reaplicando todos os
+ * registros) com a reabertura pelo snapshot consolidado mais uma
+ * cauda de 'cauda' registros.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PALAVRAS_PADRAO 200000
+#define CAUDA_PADRAO 1000
+#define PALAVRAS_LOTE_UNITARIO 2000
+#define TAM_CAMINHO 512
+
+/*
+ * Implementação:
+ * - Remove o snapshot e o diário de uma execução anterior.
+ */
+static void limpar(const char* snapshot, const char* diario) {
+    unlink(snapshot);
+    unlink(diario);
+}
+
+/*
+ * Implementação:
+ * - Insere 'n' palavras; com caminhos, em um dicionário persistente
+ *   com o lote informado (sem consolidação), incluindo o fechamento
+ *   na medição.
+ */
+static void medir_insercao(const char* nome,
+                           const char* corpus,
+                           size_t n,
+                           const char* snapshot,
+                           const char* diario,
+                           size_t lote) {
+    if (snapshot) {
+        limpar(snapshot, diario);
+    }
+
+    double inicio = agora_ms();
+    dicionario* d = NULL;
+    if (snapshot) {
+        d = dicionario_abrir_persistente(snapshot, diario, lote, 0);
+    } else {
+        d = dicionario_criar();
+    }
+    if (!d) {
+        fprintf(stderr, "falha ao abrir o dicionário\n");
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        dicionario_adicionar_palavra(d, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    dicionario_destruir(d);
+    double tempo = agora_ms() - inicio;
+
+    printf("%-14s %8zu palavras %9.1f ms  %8.1f ns/palavra\n",
+           nome,
+           n,
+           tempo,
+           tempo * 1e6 / (double) n);
+}
+
+/*
+ * Implementação:
+ * - Reabre o dicionário persistente (sem consolidação automática) e
+ *   relata o tempo e as palavras carregadas.
+ */
+static void medir_reabertura(const char* nome,
+                             const char* snapshot,
+                             const char* diario) {
+    double inicio = agora_ms();
+    dicionario* d = dicionario_abrir_persistente(snapshot, diario, 0, 0);
+    double tempo = agora_ms() - inicio;
+    if (!d) {
+        fprintf(stderr, "falha ao reabrir o dicionário\n");
+        return;
+    }
+
+    printf("%-14s %9.1f ms  palavras=%zu\n",
+           nome,
+           tempo,
+           d->total_palavras);
+    dicionario_destruir(d);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t cauda = CAUDA_PADRAO;
+    const char* diretorio = "/tmp";
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        cauda = strtoul(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        diretorio = argv[3];
+    }
+    if (cauda > n) {
+        cauda = n;
+    }
+
+    char snapshot[TAM_CAMINHO];
+    char diario[TAM_CAMINHO];
+    snprintf(snapshot, sizeof snapshot, "%s/bench_diario.snap", diretorio);
+    snprintf(diario, sizeof diario, "%s/bench_diario.log", diretorio);
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    if (!corpus) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    printf("bench_diario: %zu palavras, cauda %zu, em %s\n",
+           n,
+           cauda,
+           diretorio);
+
+    medir_insercao("sem diário", corpus, n, NULL, NULL, 0);
+    size_t unitario = n < PALAVRAS_LOTE_UNITARIO ? n : PALAVRAS_LOTE_UNITARIO;
+    medir_insercao("lote 1", corpus, unitario, snapshot, diario, 1);
+    medir_insercao("lote 64", corpus, n, snapshot, diario, 64);
+    medir_insercao("lote 4096", corpus, n, snapshot, diario, 4096);
+    medir_insercao("só ao fechar", corpus, n, snapshot, diario, 0);
+
+    // O diário da última medição tem todas as palavras
+    medir_reabertura("só diário", snapshot, diario);
+
+    dicionario* d = dicionario_abrir_persistente(snapshot, diario, 0, 0);
+    if (!d) {
+        fprintf(stderr, "falha ao reabrir o dicionário\n");
+        free(corpus);
+        return 1;
+    }
+    double inicio = agora_ms();
+    dicionario_consolidar(d);
+    double consolidacao = agora_ms() - inicio;
+    dicionario_destruir(d);
+    printf("%-14s %9.1f ms\n", "consolidação", consolidacao);
+
+    medir_reabertura("snapshot", snapshot, diario);
+
+    // Cauda: remove metade das primeiras palavras e muda o peso da outra
+    d = dicionario_abrir_persistente(snapshot, diario, 0, 0);
+    for (size_t i = 0; d && i < cauda; i++) {
+        const char* palavra = corpus + (i * TAM_PALAVRA_CORPUS);
+        if (i % 2 == 0) {
+            dicionario_remover_palavra(d, palavra);
+        } else {
+            dicionario_adicionar_palavra_com_peso(d, palavra, (uint32_t) i);
+        }
+    }
+    dicionario_destruir(d);
+    medir_reabertura("snapshot+cauda", snapshot, diario);
+
+    limpar(snapshot, diario);
+    free(corpus);
+    return 0;
+}
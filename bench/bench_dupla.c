@@ -0,0 +1,112 @@
+/**
+ * @file bench_dupla.c
+ * @brief Compara o motor de Trie ternária com o de vetor duplo.
+ *
+ * Mede tempo de carga, memória por palavra e latência de consulta e
+ * de remoção dos dois motores de dicionário sobre o mesmo corpus.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PALAVRAS_PADRAO 1000000
+#define CONSULTAS_PADRAO 2000000
+
+/*
+ * Implementação:
+ * - Carrega o corpus, consulta as palavras sorteadas e remove um
+ *   décimo do corpus, medindo cada etapa.
+ */
+static void executar_motor(const char* nome,
+                           motor_dicionario motor,
+                           const char* corpus,
+                           size_t n,
+                           const char* const* consultas,
+                           size_t m) {
+    dicionario* d = dicionario_criar_com_motor(motor);
+    if (!d) {
+        fprintf(stderr, "falha de alocação\n");
+        return;
+    }
+
+    double inicio = agora_ms();
+    for (size_t i = 0; i < n; i++) {
+        dicionario_adicionar_palavra(d, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    double carga = agora_ms() - inicio;
+
+    size_t acertos = 0;
+    inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        acertos += dicionario_contem(d, consultas[i]);
+    }
+    double consulta = agora_ms() - inicio;
+
+    estatisticas_dicionario e;
+    dicionario_estatisticas(d, &e, false);
+
+    inicio = agora_ms();
+    for (size_t i = 0; i < n; i += 10) {
+        dicionario_remover_palavra(d, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    double remocao = agora_ms() - inicio;
+
+    printf("%-12s carga=%8.1f ms  bytes/palavra=%6.1f (reservados %6.1f)"
+           "  consulta=%6.1f ns  remoção=%6.1f ns  acertos=%zu\n",
+           nome,
+           carga,
+           (double) e.bytes_usados / (double) e.palavras,
+           (double) e.bytes_reservados / (double) e.palavras,
+           consulta * 1e6 / (double) m,
+           remocao * 1e6 / (double) ((n + 9) / 10),
+           acertos);
+
+    dicionario_destruir(d);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t m = CONSULTAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        m = strtoul(argv[2], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    char* ausentes = gerar_corpus(m, 0xD1B54A32D192ED03ULL);
+    const char** consultas = malloc(m * sizeof *consultas);
+    if (!corpus || !ausentes || !consultas) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    // Metade das consultas são palavras do corpus, em ordem aleatória
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        if (proximo_aleatorio(&estado) & 1) {
+            size_t j = proximo_aleatorio(&estado) % n;
+            consultas[i] = corpus + (j * TAM_PALAVRA_CORPUS);
+        } else {
+            consultas[i] = ausentes + (i * TAM_PALAVRA_CORPUS);
+        }
+    }
+
+    printf("bench_dupla: %zu palavras, %zu consultas\n", n, m);
+    executar_motor(
+        "ternária", DICIONARIO_MOTOR_TRIE, corpus, n, consultas, m);
+    executar_motor(
+        "vetor duplo", DICIONARIO_MOTOR_VETOR_DUPLO, corpus, n, consultas, m);
+
+    free((void*) consultas);
+    free(ausentes);
+    free(corpus);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench_lote.c
+ * @brief Compara a consulta palavra a palavra com a consulta em lote.
+ *
+ * O dicionário padrão ocupa centenas de MiB, bem mais que o cache de
+ * último nível, de modo que cada descida sofre faltas de cache.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PALAVRAS_PADRAO 1000000
+#define CONSULTAS_PADRAO 2000000
+#define TAM_LOTE 4096
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t m = CONSULTAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        m = strtoul(argv[2], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    char* ausentes = gerar_corpus(m, 0xD1B54A32D192ED03ULL);
+    const char** consultas = malloc(m * sizeof *consultas);
+    bool* resultados = malloc(m * sizeof *resultados);
+    dicionario* d = dicionario_criar();
+    if (!corpus || !ausentes || !consultas || !resultados || !d) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        dicionario_adicionar_palavra(d, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+
+    // Metade das consultas são palavras do dicionário, em ordem aleatória
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        if (proximo_aleatorio(&estado) & 1) {
+            size_t j = proximo_aleatorio(&estado) % n;
+            consultas[i] = corpus + (j * TAM_PALAVRA_CORPUS);
+        } else {
+            consultas[i] = ausentes + (i * TAM_PALAVRA_CORPUS);
+        }
+    }
+
+    printf("bench_lote: %zu palavras, %zu consultas, rss=%ld KiB\n",
+           d->total_palavras,
+           m,
+           rss_kib());
+
+    size_t acertos = 0;
+    double inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        acertos += dicionario_contem(d, consultas[i]);
+    }
+    double individual = agora_ms() - inicio;
+    printf("individual  %8.1f ms  %6.2f M consultas/s  acertos=%zu\n",
+           individual,
+           (double) m / individual / 1e3,
+           acertos);
+
+    acertos = 0;
+    inicio = agora_ms();
+    for (size_t i = 0; i < m; i += TAM_LOTE) {
+        size_t tamanho = m - i < TAM_LOTE ? m - i : TAM_LOTE;
+        dicionario_contem_lote(d, consultas + i, tamanho, resultados + i);
+    }
+    double lote = agora_ms() - inicio;
+    for (size_t i = 0; i < m; i++) {
+        acertos += resultados[i];
+    }
+    printf("lote        %8.1f ms  %6.2f M consultas/s  acertos=%zu\n",
+           lote,
+           (double) m / lote / 1e3,
+           acertos);
+
+    dicionario_destruir(d);
+    free(resultados);
+    free((void*) consultas);
+    free(ausentes);
+    free(corpus);
+    return 0;
+}
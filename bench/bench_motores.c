@@ -0,0 +1,147 @@
+/**
+ * @file bench_motores.c
+ * @brief Compara os motores de armazenamento pela interface motor.h.
+ *
+ * Mede tempo de carga, memória por palavra, latência de consulta e o
+ * custo de percorrer palavras em ordem (listagem completa e cursores
+ * de prefixos de duas letras) da Trie ternária, do vetor duplo e da
+ * Trie de rajada sobre o mesmo corpus.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "motor.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PALAVRAS_PADRAO 1000000
+#define CONSULTAS_PADRAO 2000000
+
+/*
+ * Implementação:
+ * - Percorre o cursor do prefixo até o fim, somando os tamanhos das
+ *   palavras para que o percurso não seja descartado.
+ */
+static size_t percorrer(const motor* m, const char* prefixo, size_t* soma) {
+    motor_cursor cursor;
+    size_t palavras = 0;
+    if (motor_cursor_abrir(&cursor, m, prefixo)) {
+        const char* palavra;
+        while ((palavra = motor_cursor_proximo(&cursor))) {
+            palavras++;
+            *soma += (unsigned char) palavra[0];
+        }
+    }
+    motor_cursor_fechar(&cursor);
+    return palavras;
+}
+
+/*
+ * Implementação:
+ * - Carrega o corpus, consulta as palavras sorteadas, lista tudo em
+ *   ordem e abre um cursor para cada prefixo de duas letras.
+ */
+static void executar_motor(const operacoes_motor* operacoes,
+                           const char* corpus,
+                           size_t n,
+                           const char* const* consultas,
+                           size_t m) {
+    motor* mt = motor_criar(operacoes);
+    if (!mt) {
+        fprintf(stderr, "falha de alocação\n");
+        return;
+    }
+
+    double inicio = agora_ms();
+    for (size_t i = 0; i < n; i++) {
+        motor_inserir(mt, corpus + (i * TAM_PALAVRA_CORPUS), NULL);
+    }
+    double carga = agora_ms() - inicio;
+
+    size_t acertos = 0;
+    inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        acertos += motor_contem(mt, consultas[i]);
+    }
+    double consulta = agora_ms() - inicio;
+
+    size_t soma = 0;
+    inicio = agora_ms();
+    size_t listadas = percorrer(mt, "", &soma);
+    double listagem = agora_ms() - inicio;
+
+    char prefixo[3] = {0};
+    size_t percorridas = 0;
+    inicio = agora_ms();
+    for (char a = 'a'; a <= 'z'; a++) {
+        for (char b = 'a'; b <= 'z'; b++) {
+            prefixo[0] = a;
+            prefixo[1] = b;
+            percorridas += percorrer(mt, prefixo, &soma);
+        }
+    }
+    double prefixos = agora_ms() - inicio;
+
+    medidas_motor medidas;
+    motor_medir(mt, &medidas);
+
+    printf("%-12s carga=%8.1f ms  bytes/palavra=%6.1f (reservados %6.1f)"
+           "  consulta=%6.1f ns  listagem=%7.1f ms  prefixos=%7.1f ms"
+           "  acertos=%zu (%zu/%zu/%zu)\n",
+           operacoes->nome,
+           carga,
+           (double) medidas.bytes_usados / (double) listadas,
+           (double) medidas.bytes_reservados / (double) listadas,
+           consulta * 1e6 / (double) m,
+           listagem,
+           prefixos,
+           acertos,
+           listadas,
+           percorridas,
+           soma);
+
+    motor_destruir(mt);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t m = CONSULTAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        m = strtoul(argv[2], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    char* ausentes = gerar_corpus(m, 0xD1B54A32D192ED03ULL);
+    const char** consultas = malloc(m * sizeof *consultas);
+    if (!corpus || !ausentes || !consultas) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    // Metade das consultas são palavras do corpus, em ordem aleatória
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        if (proximo_aleatorio(&estado) & 1) {
+            size_t j = proximo_aleatorio(&estado) % n;
+            consultas[i] = corpus + (j * TAM_PALAVRA_CORPUS);
+        } else {
+            consultas[i] = ausentes + (i * TAM_PALAVRA_CORPUS);
+        }
+    }
+
+    printf("bench_motores: %zu palavras, %zu consultas\n", n, m);
+    executar_motor(&MOTOR_TRIE_TERNARIA, corpus, n, consultas, m);
+    executar_motor(&MOTOR_VETOR_DUPLO, corpus, n, consultas, m);
+    executar_motor(&MOTOR_RAJADA, corpus, n, consultas, m);
+
+    free((void*) consultas);
+    free(ausentes);
+    free(corpus);
+    return 0;
+}
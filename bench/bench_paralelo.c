@@ -0,0 +1,99 @@
+/**
+ * @file bench_paralelo.c
+ * @brief Compara a carga sequencial com a carga paralela por letra.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define PALAVRAS_PADRAO 2000000
+
+/*
+ * Implementação:
+ * - Grava 'n' palavras aleatórias de 3 a 15 letras, uma por linha,
+ *   em um arquivo temporário cujo caminho é escrito em 'caminho'.
+ */
+static bool gerar_arquivo(size_t n, char* caminho) {
+    int fd = mkstemp(caminho);
+    FILE* f = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!f) {
+        return false;
+    }
+
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    char palavra[16];
+    for (size_t i = 0; i < n; i++) {
+        size_t tam = 3 + (proximo_aleatorio(&estado) % 13);
+        for (size_t j = 0; j < tam; j++) {
+            palavra[j] = (char) ('a' + (proximo_aleatorio(&estado) % 26));
+        }
+        palavra[tam] = '\0';
+        fprintf(f, "%s\n", palavra);
+    }
+
+    fclose(f);
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Carrega o arquivo com 'threads' threads (0 = carga sequencial).
+ */
+static void executar_cenario(const char* caminho, size_t threads) {
+    dicionario* d = dicionario_criar();
+    if (!d) {
+        return;
+    }
+
+    double inicio = agora_ms();
+    if (threads == 0) {
+        dicionario_adicionar_de_arquivo(d, caminho);
+    } else {
+        dicionario_adicionar_de_arquivo_paralelo(d, caminho, threads);
+    }
+    double carga = agora_ms() - inicio;
+
+    if (threads == 0) {
+        printf("sequencial   carga=%8.1f ms  palavras=%zu\n",
+               carga,
+               d->total_palavras);
+    } else {
+        printf("%2zu thread(s) carga=%8.1f ms  palavras=%zu\n",
+               threads,
+               carga,
+               d->total_palavras);
+    }
+
+    dicionario_destruir(d);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+
+    char caminho[] = "/tmp/bench_paraleloXXXXXX";
+    if (!gerar_arquivo(n, caminho)) {
+        fprintf(stderr, "falha ao gerar corpus\n");
+        return 1;
+    }
+
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("bench_paralelo: %zu palavras, %ld nucleo(s)\n", n, nucleos);
+
+    executar_cenario(caminho, 0);
+    for (size_t threads = 1; threads <= 8; threads *= 2) {
+        executar_cenario(caminho, threads);
+    }
+
+    unlink(caminho);
+    return 0;
+}
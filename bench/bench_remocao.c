@@ -0,0 +1,178 @@
+/**
+ * @file bench_remocao.c
+ * @brief Compara a remoção palavra a palavra com a remoção em lote.
+ *
+ * Carrega o mesmo corpus em dois dicionários e remove deles a mesma
+ * lista de palavras (metade presentes, metade ausentes): no primeiro
+ * com uma chamada de dicionario_remover_palavra por palavra, no
+ * segundo com uma única chamada de dicionario_remover_lote.
+ * Repete a remoção palavra a palavra com a remoção adiada, ao final
+ * compactando explicitamente e, por último, com a compactação
+ * automática a cada 'limite' remoções, relatando os nós antes e
+ * depois da compactação.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PALAVRAS_PADRAO 1000000
+#define REMOCOES_PADRAO 100000
+#define LIMITE_PADRAO 50000
+
+/*
+ * Implementação:
+ * - Cria um dicionário com todas as palavras do corpus.
+ */
+static dicionario* carregar(const char* corpus, size_t n) {
+    dicionario* d = dicionario_criar();
+    if (!d) {
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        dicionario_adicionar_palavra(d, corpus + (i * TAM_PALAVRA_CORPUS));
+    }
+    return d;
+}
+
+/*
+ * Implementação:
+ * - Quantidade de nós alocados na arena do dicionário.
+ */
+static size_t nos_alocados(const dicionario* d) {
+    estatisticas_dicionario estatisticas;
+    dicionario_estatisticas(d, &estatisticas, false);
+    return estatisticas.nos;
+}
+
+/*
+ * Implementação:
+ * - Remove a lista palavra a palavra com a remoção adiada e o limite
+ *   informado; com SIZE_MAX, compacta uma vez ao final, fora da
+ *   medição da remoção.
+ */
+static void executar_adiada(const char* nome,
+                            const char* corpus,
+                            size_t n,
+                            const char* const* lista,
+                            size_t m,
+                            size_t limite) {
+    dicionario* d = carregar(corpus, n);
+    if (!d) {
+        fprintf(stderr, "falha de alocação\n");
+        return;
+    }
+    dicionario_adiar_remocoes(d, limite);
+
+    size_t antes = nos_alocados(d);
+    size_t removidas = 0;
+    double inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        removidas += dicionario_remover_palavra(d, lista[i]);
+    }
+    double remocao = agora_ms() - inicio;
+    size_t mortos = nos_alocados(d);
+
+    inicio = agora_ms();
+    if (limite == SIZE_MAX) {
+        dicionario_compactar(d);
+    }
+    double compactacao = agora_ms() - inicio;
+
+    printf("%-12s %8.1f ms  %6.1f ns/palavra  removidas=%zu"
+           "  compactação=%6.1f ms  nós %zu -> %zu -> %zu\n",
+           nome,
+           remocao,
+           remocao * 1e6 / (double) m,
+           removidas,
+           compactacao,
+           antes,
+           mortos,
+           nos_alocados(d));
+    dicionario_destruir(d);
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    size_t m = REMOCOES_PADRAO;
+    size_t limite = LIMITE_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        m = strtoul(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        limite = strtoul(argv[3], NULL, 10);
+    }
+
+    char* corpus = gerar_corpus(n, 0x9E3779B97F4A7C15ULL);
+    char* ausentes = gerar_corpus(m, 0xD1B54A32D192ED03ULL);
+    const char** lista = malloc(m * sizeof *lista);
+    if (!corpus || !ausentes || !lista) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+
+    // Metade da lista são palavras do corpus, em ordem aleatória
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < m; i++) {
+        if (proximo_aleatorio(&estado) & 1) {
+            size_t j = proximo_aleatorio(&estado) % n;
+            lista[i] = corpus + (j * TAM_PALAVRA_CORPUS);
+        } else {
+            lista[i] = ausentes + (i * TAM_PALAVRA_CORPUS);
+        }
+    }
+
+    printf("bench_remocao: %zu palavras, %zu remoções, limite %zu\n",
+           n,
+           m,
+           limite);
+
+    dicionario* d = carregar(corpus, n);
+    if (!d) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+    size_t removidas = 0;
+    double inicio = agora_ms();
+    for (size_t i = 0; i < m; i++) {
+        removidas += dicionario_remover_palavra(d, lista[i]);
+    }
+    double individual = agora_ms() - inicio;
+    printf("%-12s %8.1f ms  %6.1f ns/palavra  removidas=%zu\n",
+           "individual",
+           individual,
+           individual * 1e6 / (double) m,
+           removidas);
+    dicionario_destruir(d);
+
+    d = carregar(corpus, n);
+    if (!d) {
+        fprintf(stderr, "falha de alocação\n");
+        return 1;
+    }
+    inicio = agora_ms();
+    removidas = dicionario_remover_lote(d, lista, m);
+    double lote = agora_ms() - inicio;
+    printf("%-12s %8.1f ms  %6.1f ns/palavra  removidas=%zu\n",
+           "lote",
+           lote,
+           lote * 1e6 / (double) m,
+           removidas);
+    dicionario_destruir(d);
+
+    executar_adiada("adiada", corpus, n, lista, m, SIZE_MAX);
+    executar_adiada("automática", corpus, n, lista, m, limite);
+
+    free((void*) lista);
+    free(ausentes);
+    free(corpus);
+    return 0;
+}
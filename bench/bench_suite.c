@@ -0,0 +1,639 @@
+/**
+ * @file bench_suite.c
+ * @brief Mede as operações do dicionário sobre vários corpora (JSON).
+ *
+ * Para cada corpus são medidas carga de arquivo, inserção, consulta,
+ * busca por prefixo, listagem e remoção, além da vazão (GB/s) de cada
+ * núcleo de normalização suportado pela CPU. O resultado é escrito em JSON
+ * na saída padrão, para que execuções possam ser comparadas; o
+ * progresso vai para a saída de erro.
+ *
+ * Uso: bench_suite [palavras] [arquivo...]
+ * Cada arquivo informado (uma palavra por linha) é medido como um
+ * corpus adicional, além dos corpora sintéticos.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include "dicionario.h"
+#include "normalizacao.h"
+#include "util.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define PALAVRAS_PADRAO 200000
+#define MAX_CONSULTAS_PREFIXO 10000
+#define REPETICOES 3
+#define FAMILIAS_PREFIXO 8
+#define TAM_PREFIXO_LONGO 24
+#define TAM_MAX_PALAVRA 64
+
+/**
+ * @struct corpus
+ * @brief Palavras de um corpus, na ordem em que são carregadas.
+ */
+typedef struct {
+    const char* nome;
+    char** palavras;
+    size_t quantidade;
+    bool zipf;
+} corpus;
+
+/**
+ * @struct medicao
+ * @brief Amostras de latência (ns) de uma operação.
+ *
+ * Operações em massa (carga, listagem e remoção de arquivo) são
+ * repetidas; cada amostra é o custo por palavra de uma repetição.
+ */
+typedef struct {
+    const char* nome;
+    double* amostras;
+    size_t quantidade;
+    size_t capacidade;
+    size_t ops;
+    uint64_t total_ns;
+} medicao;
+
+/*
+ * Implementação:
+ * - Registra uma amostra e soma 'ops' operações com custo 'ns'.
+ */
+static void
+medicao_registrar(medicao* m, double amostra, size_t ops, uint64_t ns) {
+    if (m->quantidade == m->capacidade) {
+        size_t nova_cap = m->capacidade ? m->capacidade * 2 : 1024;
+        double* tmp = realloc(m->amostras, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            return;
+        }
+        m->amostras = tmp;
+        m->capacidade = nova_cap;
+    }
+
+    m->amostras[m->quantidade++] = amostra;
+    m->ops += ops;
+    m->total_ns += ns;
+}
+
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+static int comparar_palavras(const void* a, const void* b) {
+    return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+/*
+ * Implementação:
+ * - Ordena as amostras para obter os percentis e escreve o objeto.
+ * - Libera as amostras.
+ */
+static void medicao_emitir(medicao* m, bool ultima) {
+    double p50 = 0;
+    double p99 = 0;
+    if (m->quantidade > 0) {
+        qsort(m->amostras,
+              m->quantidade,
+              sizeof *m->amostras,
+              comparar_double);
+        p50 = m->amostras[(m->quantidade - 1) * 50 / 100];
+        p99 = m->amostras[(m->quantidade - 1) * 99 / 100];
+    }
+
+    double ns_por_op = m->ops ? (double) m->total_ns / (double) m->ops : 0;
+    printf("        {\"nome\": \"%s\", \"ops\": %zu, \"ns_por_op\": %.1f, "
+           "\"ops_por_s\": %.0f, \"p50_ns\": %.1f, \"p99_ns\": %.1f}%s\n",
+           m->nome,
+           m->ops,
+           ns_por_op,
+           ns_por_op > 0 ? 1e9 / ns_por_op : 0,
+           p50,
+           p99,
+           ultima ? "" : ",");
+
+    free(m->amostras);
+    *m = (medicao){0};
+}
+
+/*
+ * Implementação:
+ * - Preenche 'destino' com 'tam' letras aleatórias.
+ */
+static void letras_aleatorias(char* destino, size_t tam, uint64_t* estado) {
+    for (size_t i = 0; i < tam; i++) {
+        destino[i] = (char) ('a' + (proximo_aleatorio(estado) % 26));
+    }
+    destino[tam] = '\0';
+}
+
+/*
+ * Implementação:
+ * - Palavra aleatória de 3 a 15 letras.
+ */
+static char* palavra_aleatoria(uint64_t* estado) {
+    char palavra[16];
+    letras_aleatorias(palavra, 3 + (proximo_aleatorio(estado) % 13), estado);
+    return string_dup(palavra);
+}
+
+/*
+ * Implementação:
+ * - Amostra o índice de uma distribuição de Zipf (expoente 1) pela
+ *   busca binária na distribuição acumulada.
+ */
+static size_t
+amostrar_zipf(const double* acumulada, size_t n, uint64_t* estado) {
+    double u = (double) (proximo_aleatorio(estado) >> 11) / 9007199254740992.0;
+    u *= acumulada[n - 1];
+
+    size_t baixo = 0;
+    size_t alto = n - 1;
+    while (baixo < alto) {
+        size_t meio = baixo + ((alto - baixo) / 2);
+        if (acumulada[meio] < u) {
+            baixo = meio + 1;
+        } else {
+            alto = meio;
+        }
+    }
+    return baixo;
+}
+
+/*
+ * Implementação:
+ * - "aleatorio": palavras aleatórias de 3 a 15 letras.
+ * - "ordenado": as mesmas palavras, em ordem lexicográfica.
+ * - "zipf": n ocorrências sorteadas com lei de Zipf de um vocabulário
+ *   de n/4 palavras (muitas repetições).
+ * - "prefixo_longo": famílias que compartilham prefixos de 24 letras,
+ *   com sufixos de 3 a 8 letras.
+ */
+static bool criar_corpus(corpus* c, const char* nome, size_t n) {
+    *c = (corpus){.nome = nome, .quantidade = n};
+    c->palavras = calloc(n ? n : 1, sizeof *c->palavras);
+    if (!c->palavras) {
+        return false;
+    }
+
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    if (strcmp(nome, "zipf") == 0) {
+        size_t v = n / 4 ? n / 4 : 1;
+        char** vocabulario = malloc(v * sizeof *vocabulario);
+        double* acumulada = malloc(v * sizeof *acumulada);
+        if (!vocabulario || !acumulada) {
+            free(vocabulario);
+            free(acumulada);
+            return false;
+        }
+
+        double soma = 0;
+        for (size_t i = 0; i < v; i++) {
+            vocabulario[i] = palavra_aleatoria(&estado);
+            soma += 1.0 / (double) (i + 1);
+            acumulada[i] = soma;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t j = amostrar_zipf(acumulada, v, &estado);
+            c->palavras[i] = string_dup(vocabulario[j]);
+        }
+        for (size_t i = 0; i < v; i++) {
+            free(vocabulario[i]);
+        }
+        free(vocabulario);
+        free(acumulada);
+        c->zipf = true;
+    } else if (strcmp(nome, "prefixo_longo") == 0) {
+        char familias[FAMILIAS_PREFIXO][TAM_PREFIXO_LONGO + 1];
+        for (size_t f = 0; f < FAMILIAS_PREFIXO; f++) {
+            letras_aleatorias(familias[f], TAM_PREFIXO_LONGO, &estado);
+        }
+        for (size_t i = 0; i < n; i++) {
+            char palavra[TAM_PREFIXO_LONGO + 9];
+            memcpy(palavra,
+                   familias[proximo_aleatorio(&estado) % FAMILIAS_PREFIXO],
+                   TAM_PREFIXO_LONGO);
+            letras_aleatorias(palavra + TAM_PREFIXO_LONGO,
+                              3 + (proximo_aleatorio(&estado) % 6),
+                              &estado);
+            c->palavras[i] = string_dup(palavra);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            c->palavras[i] = palavra_aleatoria(&estado);
+        }
+        if (strcmp(nome, "ordenado") == 0) {
+            qsort(c->palavras, n, sizeof *c->palavras, comparar_palavras);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (!c->palavras[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Lê as linhas do arquivo como palavras (a normalização fica a
+ *   cargo do dicionário).
+ */
+static bool ler_corpus(corpus* c, const char* caminho) {
+    *c = (corpus){.nome = caminho};
+    FILE* f = fopen(caminho, "r");
+    if (!f) {
+        return false;
+    }
+
+    size_t capacidade = 0;
+    char* linha = NULL;
+    size_t tam_linha = 0;
+    ssize_t lidos = 0;
+    bool ok = true;
+    while (ok && (lidos = getline(&linha, &tam_linha, f)) != -1) {
+        while (lidos > 0 &&
+               (linha[lidos - 1] == '\n' || linha[lidos - 1] == '\r')) {
+            linha[--lidos] = '\0';
+        }
+        if (lidos == 0) {
+            continue;
+        }
+        if (c->quantidade == capacidade) {
+            capacidade = capacidade ? capacidade * 2 : 4096;
+            char** tmp = realloc(c->palavras, capacidade * sizeof *tmp);
+            if (!tmp) {
+                ok = false;
+                break;
+            }
+            c->palavras = tmp;
+        }
+        c->palavras[c->quantidade] = string_dup(linha);
+        ok = c->palavras[c->quantidade++] != NULL;
+    }
+
+    free(linha);
+    fclose(f);
+    return ok;
+}
+
+static void liberar_corpus(corpus* c) {
+    for (size_t i = 0; i < c->quantidade; i++) {
+        free(c->palavras[i]);
+    }
+    free(c->palavras);
+}
+
+/*
+ * Implementação:
+ * - Grava o corpus, uma palavra por linha, em um arquivo temporário
+ *   cujo caminho é escrito em 'caminho'.
+ */
+static bool gravar_corpus(const corpus* c, char* caminho) {
+    int fd = mkstemp(caminho);
+    FILE* f = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!f) {
+        return false;
+    }
+
+    for (size_t i = 0; i < c->quantidade; i++) {
+        fprintf(f, "%s\n", c->palavras[i]);
+    }
+
+    return fclose(f) == 0;
+}
+
+/*
+ * Implementação:
+ * - Repete carga de arquivo, listagem e remoção de arquivo sobre um
+ *   dicionário novo a cada repetição.
+ * - Carga e remoção custam por linha do arquivo; a listagem, por
+ *   palavra distinta.
+ */
+static void medir_em_massa(const char* caminho,
+                           size_t linhas,
+                           medicao* carga,
+                           medicao* listagem,
+                           medicao* remocao) {
+    for (size_t r = 0; r < REPETICOES; r++) {
+        dicionario* d = dicionario_criar();
+        if (!d) {
+            return;
+        }
+
+        linhas = linhas ? linhas : 1;
+        uint64_t inicio = agora_ns();
+        dicionario_adicionar_de_arquivo(d, caminho);
+        uint64_t ns = agora_ns() - inicio;
+        medicao_registrar(carga, (double) ns / (double) linhas, linhas, ns);
+        size_t total = d->total_palavras ? d->total_palavras : 1;
+
+        size_t quantidade = 0;
+        inicio = agora_ns();
+        char** lista = dicionario_listar_palavras(d, &quantidade);
+        ns = agora_ns() - inicio;
+        trie_liberar_lista(lista, quantidade);
+        medicao_registrar(listagem, (double) ns / (double) total, total, ns);
+
+        inicio = agora_ns();
+        dicionario_remover_de_arquivo(d, caminho);
+        ns = agora_ns() - inicio;
+        medicao_registrar(
+            remocao, (double) ns / (double) linhas, linhas, ns);
+
+        dicionario_destruir(d);
+    }
+}
+
+/*
+ * Implementação:
+ * - Mede cada chamada isoladamente: inserção de todo o corpus,
+ *   consultas (metade presentes, metade ausentes), buscas por prefixo
+ *   e remoção palavra a palavra em ordem aleatória.
+ */
+static void medir_isoladas(const corpus* c,
+                           medicao* insercao,
+                           medicao* consulta,
+                           medicao* prefixo,
+                           medicao* remocao) {
+    dicionario* d = dicionario_criar();
+    if (!d || c->quantidade == 0) {
+        dicionario_destruir(d);
+        return;
+    }
+
+    for (size_t i = 0; i < c->quantidade; i++) {
+        uint64_t inicio = agora_ns();
+        dicionario_adicionar_palavra(d, c->palavras[i]);
+        uint64_t ns = agora_ns() - inicio;
+        medicao_registrar(insercao, (double) ns, 1, ns);
+    }
+
+    uint64_t estado = 0xA0761D6478BD642FULL;
+    for (size_t i = 0; i < c->quantidade; i++) {
+        char* ausente = NULL;
+        const char* palavra = NULL;
+        if (proximo_aleatorio(&estado) & 1) {
+            palavra = c->palavras[proximo_aleatorio(&estado) % c->quantidade];
+        } else {
+            ausente = palavra_aleatoria(&estado);
+            palavra = ausente;
+        }
+
+        uint64_t inicio = agora_ns();
+        dicionario_contem(d, palavra);
+        uint64_t ns = agora_ns() - inicio;
+        medicao_registrar(consulta, (double) ns, 1, ns);
+        free(ausente);
+    }
+
+    size_t consultas = c->quantidade < MAX_CONSULTAS_PREFIXO
+                           ? c->quantidade
+                           : MAX_CONSULTAS_PREFIXO;
+    for (size_t i = 0; i < consultas; i++) {
+        const char* palavra =
+            c->palavras[proximo_aleatorio(&estado) % c->quantidade];
+        char busca[TAM_MAX_PALAVRA];
+        size_t tam = strlen(palavra);
+        size_t tam_prefixo = tam > 5 ? tam - 2 : (tam < 3 ? tam : 3);
+        if (tam_prefixo >= sizeof busca) {
+            tam_prefixo = sizeof busca - 1;
+        }
+        memcpy(busca, palavra, tam_prefixo);
+        busca[tam_prefixo] = '\0';
+
+        size_t quantidade = 0;
+        uint64_t inicio = agora_ns();
+        char** lista = dicionario_buscar_por_prefixo(d, busca, &quantidade);
+        uint64_t ns = agora_ns() - inicio;
+        trie_liberar_lista(lista, quantidade);
+        medicao_registrar(prefixo, (double) ns, 1, ns);
+    }
+
+    size_t* ordem = malloc(c->quantidade * sizeof *ordem);
+    if (ordem) {
+        for (size_t i = 0; i < c->quantidade; i++) {
+            ordem[i] = i;
+        }
+        for (size_t i = c->quantidade - 1; i > 0; i--) {
+            size_t j = proximo_aleatorio(&estado) % (i + 1);
+            size_t tmp = ordem[i];
+            ordem[i] = ordem[j];
+            ordem[j] = tmp;
+        }
+        for (size_t i = 0; i < c->quantidade; i++) {
+            uint64_t inicio = agora_ns();
+            dicionario_remover_palavra(d, c->palavras[ordem[i]]);
+            uint64_t ns = agora_ns() - inicio;
+            medicao_registrar(remocao, (double) ns, 1, ns);
+        }
+        free(ordem);
+    }
+
+    dicionario_destruir(d);
+}
+
+/*
+ * Implementação:
+ * - Monta o texto do arquivo do corpus (uma palavra por linha) e, para
+ *   cada núcleo suportado, mede a melhor de REPETICOES passadas de
+ *   normalizar_linhas sobre o texto inteiro e de normalizar_trecho
+ *   linha a linha.
+ * - Restaura o núcleo escolhido automaticamente ao final.
+ */
+static void emitir_normalizacao(const corpus* c) {
+    size_t tamanho = 0;
+    for (size_t i = 0; i < c->quantidade; i++) {
+        tamanho += strlen(c->palavras[i]) + 1;
+    }
+
+    char* texto = malloc(tamanho + 1);
+    char* destino = malloc(tamanho + 1);
+    size_t* inicios = malloc((c->quantidade + 1) * sizeof *inicios);
+    if (!texto || !destino || !inicios) {
+        free(texto);
+        free(destino);
+        free(inicios);
+        printf("      \"normalizacao\": [],\n");
+        return;
+    }
+
+    char* p = texto;
+    for (size_t i = 0; i < c->quantidade; i++) {
+        size_t tam = strlen(c->palavras[i]);
+        inicios[i] = (size_t) (p - texto);
+        memcpy(p, c->palavras[i], tam);
+        p[tam] = '\n';
+        p += tam + 1;
+    }
+    inicios[c->quantidade] = tamanho;
+
+    nucleo_normalizacao automatico = normalizacao_nucleo();
+    bool primeiro = true;
+    printf("      \"normalizacao\": [\n");
+    for (int n = NORMALIZACAO_ESCALAR; n <= NORMALIZACAO_AVX2; n++) {
+        if (!normalizacao_selecionar((nucleo_normalizacao) n)) {
+            continue;
+        }
+
+        uint64_t melhor_linhas = UINT64_MAX;
+        uint64_t melhor_trecho = UINT64_MAX;
+        size_t palavras = 0;
+        for (size_t r = 0; r < REPETICOES; r++) {
+            size_t usados = 0;
+            uint64_t inicio = agora_ns();
+            palavras = normalizar_linhas(texto, tamanho, destino, &usados);
+            uint64_t ns = agora_ns() - inicio;
+            melhor_linhas = ns < melhor_linhas ? ns : melhor_linhas;
+
+            size_t validas = 0;
+            inicio = agora_ns();
+            for (size_t i = 0; i < c->quantidade; i++) {
+                validas += (size_t) normalizar_trecho(
+                    texto + inicios[i],
+                    inicios[i + 1] - inicios[i] - 1,
+                    destino + inicios[i]);
+            }
+            ns = agora_ns() - inicio;
+            melhor_trecho = ns < melhor_trecho ? ns : melhor_trecho;
+            palavras = validas < palavras ? validas : palavras;
+        }
+
+        melhor_linhas = melhor_linhas ? melhor_linhas : 1;
+        melhor_trecho = melhor_trecho ? melhor_trecho : 1;
+        printf("%s        {\"nucleo\": \"%s\", \"bytes\": %zu, "
+               "\"validas\": %zu, \"linhas_gb_por_s\": %.2f, "
+               "\"trecho_gb_por_s\": %.2f}",
+               primeiro ? "" : ",\n",
+               normalizacao_nome((nucleo_normalizacao) n),
+               tamanho,
+               palavras,
+               (double) tamanho / (double) melhor_linhas,
+               (double) tamanho / (double) melhor_trecho);
+        primeiro = false;
+    }
+    printf("\n      ],\n");
+    normalizacao_selecionar(automatico);
+
+    free(inicios);
+    free(destino);
+    free(texto);
+}
+
+/*
+ * Implementação:
+ * - Executa todas as medições de um corpus e escreve seu objeto JSON.
+ * - Roda em um processo filho, de modo que o pico de RSS informado
+ *   seja apenas o deste corpus.
+ */
+static int executar_corpus(const corpus* c, bool ultimo) {
+    char caminho[] = "/tmp/bench_suiteXXXXXX";
+    if (!gravar_corpus(c, caminho)) {
+        fprintf(stderr, "falha ao gravar corpus %s\n", c->nome);
+        return 1;
+    }
+
+    fprintf(stderr, "bench_suite: %s (%zu palavras)\n", c->nome, c->quantidade);
+
+    medicao carga = {.nome = "carga_arquivo"};
+    medicao listagem = {.nome = "listagem"};
+    medicao remocao_arquivo = {.nome = "remocao_arquivo"};
+    medicao insercao = {.nome = "insercao"};
+    medicao consulta = {.nome = "consulta"};
+    medicao prefixo = {.nome = "busca_prefixo"};
+    medicao remocao = {.nome = "remocao"};
+
+    medir_em_massa(caminho, c->quantidade, &carga, &listagem, &remocao_arquivo);
+    medir_isoladas(c, &insercao, &consulta, &prefixo, &remocao);
+    unlink(caminho);
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+
+    printf("    {\n");
+    printf("      \"nome\": \"%s\",\n", c->nome);
+    printf("      \"palavras\": %zu,\n", c->quantidade);
+    printf("      \"rss_pico_kib\": %ld,\n", uso.ru_maxrss);
+    emitir_normalizacao(c);
+    printf("      \"operacoes\": [\n");
+    medicao_emitir(&carga, false);
+    medicao_emitir(&insercao, false);
+    medicao_emitir(&consulta, false);
+    medicao_emitir(&prefixo, false);
+    medicao_emitir(&listagem, false);
+    medicao_emitir(&remocao, false);
+    medicao_emitir(&remocao_arquivo, true);
+    printf("      ]\n");
+    printf("    }%s\n", ultimo ? "" : ",");
+    fflush(stdout);
+    return 0;
+}
+
+/*
+ * Implementação:
+ * - Gera (ou lê) o corpus no processo filho e espera seu término.
+ */
+static int
+medir_em_filho(const char* nome, size_t n, bool arquivo, bool ultimo) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        return 1;
+    }
+
+    if (pid == 0) {
+        corpus c;
+        bool ok = arquivo ? ler_corpus(&c, nome) : criar_corpus(&c, nome, n);
+        int status = ok ? executar_corpus(&c, ultimo) : 1;
+        if (!ok) {
+            fprintf(stderr, "falha ao preparar corpus %s\n", nome);
+        }
+        liberar_corpus(&c);
+        _exit(status);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
+
+int main(int argc, char** argv) {
+    size_t n = PALAVRAS_PADRAO;
+    if (argc > 1) {
+        n = strtoul(argv[1], NULL, 10);
+    }
+
+    static const char* const sinteticos[] = {
+        "aleatorio", "ordenado", "zipf", "prefixo_longo"};
+    size_t total_sinteticos = sizeof sinteticos / sizeof *sinteticos;
+    int arquivos = argc > 2 ? argc - 2 : 0;
+    int falhas = 0;
+
+    printf("{\n");
+    printf("  \"benchmark\": \"bench_suite\",\n");
+    printf("  \"palavras\": %zu,\n", n);
+    printf("  \"repeticoes\": %d,\n", REPETICOES);
+    printf("  \"corpora\": [\n");
+
+    for (size_t i = 0; i < total_sinteticos; i++) {
+        bool ultimo = i + 1 == total_sinteticos && arquivos == 0;
+        falhas += medir_em_filho(sinteticos[i], n, false, ultimo);
+    }
+    for (int i = 0; i < arquivos; i++) {
+        falhas += medir_em_filho(argv[i + 2], 0, true, i + 1 == arquivos);
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+/**
+ * @file bench_util.h
+ * @brief Funções auxiliares compartilhadas pelos benchmarks.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @brief Espaço reservado para cada palavra do corpus gerado. */
+#define TAM_PALAVRA_CORPUS 16
+
+/*
+ * Implementação:
+ * - Gerador xorshift64; com semente fixa, o corpus é reprodutível.
+ */
+static inline uint64_t proximo_aleatorio(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+/*
+ * Implementação:
+ * - Gera 'n' palavras de 3 a 15 letras em um único buffer contíguo, uma a
+ *   cada TAM_PALAVRA_CORPUS bytes; a mesma semente repete o corpus.
+ */
+static inline char* gerar_corpus(size_t n, uint64_t semente) {
+    char* corpus = malloc(n * TAM_PALAVRA_CORPUS);
+    if (!corpus) {
+        return NULL;
+    }
+
+    uint64_t estado = semente;
+    for (size_t i = 0; i < n; i++) {
+        char* palavra = corpus + (i * TAM_PALAVRA_CORPUS);
+        size_t tam = 3 + (proximo_aleatorio(&estado) % 13);
+        for (size_t j = 0; j < tam; j++) {
+            palavra[j] = (char) ('a' + (proximo_aleatorio(&estado) % 26));
+        }
+        palavra[tam] = '\0';
+    }
+
+    return corpus;
+}
+
+/*
+ * Implementação:
+ * - Relógio monotônico em milissegundos.
+ */
+static inline double agora_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e3) + ((double) ts.tv_nsec / 1e6);
+}
+
+/*
+ * Implementação:
+ * - Relógio monotônico em nanossegundos, para medir operações isoladas.
+ */
+static inline uint64_t agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Implementação:
+ * - Lê o RSS atual (em KiB) de /proc/self/statm.
+ */
+static inline long rss_kib(void) {
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) {
+        return -1;
+    }
+
+    long total = 0;
+    long residente = 0;
+    if (fscanf(f, "%ld %ld", &total, &residente) != 2) {
+        residente = -1;
+    }
+    fclose(f);
+
+    return residente < 0 ? -1 : residente * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * @file arena.h
+ * @brief Definição de um alocador em blocos (arena) para nós da Trie.
+ */
+
+#include <stddef.h>
+
+typedef struct no_trie no_trie;
+
+typedef struct bloco_arena bloco_arena;
+
+/**
+ * @struct arena_nos
+ * @brief Arena de nós da Trie.
+ *
+ * Os nós são servidos a partir de blocos grandes. Nós devolvidos
+ * formam uma lista livre (encadeada pelo campo no_meio) e são
+ * reaproveitados antes de novos nós do bloco atual.
+ */
+typedef struct arena_nos {
+    bloco_arena* blocos;
+    no_trie* livres;
+    size_t nos_por_bloco;
+    size_t nos_ativos;
+} arena_nos;
+
+/**
+ * @brief Cria uma arena vazia.
+ *
+ * @param nos_por_bloco Quantidade de nós por bloco (0 usa o padrão).
+ *
+ * @return Ponteiro para a arena criada ou NULL em caso de falha.
+ */
+arena_nos* arena_criar(size_t nos_por_bloco);
+
+/**
+ * @brief Libera a arena e todos os nós alocados nela.
+ *
+ * Custo proporcional à quantidade de blocos, não de nós.
+ *
+ * @param arena Arena a ser liberada.
+ */
+void arena_destruir(arena_nos* arena);
+
+/**
+ * @brief Obtém um nó zerado da arena.
+ *
+ * @param arena Arena utilizada.
+ *
+ * @return Ponteiro para o nó ou NULL em caso de falha.
+ */
+no_trie* arena_alocar_no(arena_nos* arena);
+
+/**
+ * @brief Devolve um nó à lista livre da arena.
+ *
+ * @param arena Arena de onde o nó foi obtido.
+ * @param no Nó a ser devolvido.
+ */
+void arena_liberar_no(arena_nos* arena, no_trie* no);
+
+/**
+ * @brief Transfere todos os blocos e nós livres de uma arena para outra.
+ *
+ * Após a chamada, os nós alocados em origem pertencem a destino e
+ * origem fica vazia, podendo ser destruída sem afetar esses nós.
+ *
+ * @param destino Arena que recebe os blocos.
+ * @param origem Arena esvaziada.
+ */
+void arena_absorver(arena_nos* destino, arena_nos* origem);
+
+/**
+ * @brief Quantidade de bytes reservados pela arena.
+ *
+ * @param arena Arena consultada.
+ *
+ * @return Total de bytes reservados em blocos.
+ */
+size_t arena_bytes_reservados(const arena_nos* arena);
+
+#endif
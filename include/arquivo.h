@@ -0,0 +1,82 @@
+#ifndef ARQUIVO_H
+#define ARQUIVO_H
+
+/**
+ * @file arquivo.h
+ * @brief Mapeamento de arquivos somente leitura em memória e gravação
+ * durável.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @struct arquivo_mapeado
+ * @brief Conteúdo de um arquivo mapeado em memória.
+ *
+ * Os dados não são terminados em '\0' e não devem ser alterados.
+ */
+typedef struct arquivo_mapeado {
+    const char* dados;
+    size_t tamanho;
+} arquivo_mapeado;
+
+/**
+ * @brief Mapeia o arquivo informado em memória, somente leitura.
+ *
+ * Um arquivo vazio é mapeado com dados NULL e tamanho 0.
+ *
+ * @param caminho Caminho para o arquivo.
+ * @param sequencial true se o arquivo será lido do início ao fim uma vez,
+ * false se será consultado em ordem aleatória.
+ * @param arquivo Estrutura preenchida com o mapeamento.
+ *
+ * @return true se o arquivo foi mapeado, false se não.
+ */
+bool arquivo_mapear(const char* caminho,
+                    bool sequencial,
+                    arquivo_mapeado* arquivo);
+
+/**
+ * @brief Desfaz o mapeamento criado por arquivo_mapear.
+ *
+ * @param arquivo Mapeamento a ser desfeito.
+ */
+void arquivo_desmapear(arquivo_mapeado* arquivo);
+
+/**
+ * @brief Grava o buffer do arquivo e o sincroniza com o disco.
+ *
+ * Ao retornar true, os dados já gravados sobrevivem a uma queda do
+ * sistema.
+ *
+ * @param arquivo Arquivo aberto para gravação.
+ *
+ * @return true se o arquivo foi sincronizado, false se não.
+ */
+bool arquivo_sincronizar(FILE* arquivo);
+
+/**
+ * @brief Corta o arquivo no tamanho informado.
+ *
+ * @param arquivo Arquivo aberto para gravação.
+ * @param tamanho Novo tamanho, em bytes.
+ *
+ * @return true se o arquivo foi cortado, false se não.
+ */
+bool arquivo_cortar(FILE* arquivo, size_t tamanho);
+
+/**
+ * @brief Sincroniza com o disco o diretório que contém o caminho.
+ *
+ * Necessário para que a criação ou a troca de nome de um arquivo
+ * sobreviva a uma queda do sistema.
+ *
+ * @param caminho Caminho de um arquivo do diretório.
+ *
+ * @return true se o diretório foi sincronizado, false se não.
+ */
+bool arquivo_sincronizar_diretorio(const char* caminho);
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef DAWG_H
+#define DAWG_H
+
+/**
+ * @file dawg.h
+ * @brief Autômato acíclico mínimo de palavras (DAWG) somente leitura.
+ *
+ * Construído a partir de uma Trie pronta, o autômato compartilha não
+ * só prefixos, como a Trie, mas também sufixos: estados com as mesmas
+ * transições (mesmos caracteres, marcas e destinos) são um só.
+ *
+ * Cada estado é uma sequência de transições em ordem de caractere,
+ * contíguas no vetor 'transicoes' e terminadas pela marca
+ * DAWG_ULTIMA; o estado é identificado pelo índice de sua primeira
+ * transição. O índice 0 não é usado, de modo que destino 0 representa
+ * o estado sem transições.
+ *
+ * Os pesos das palavras não são guardados (palavras com pesos
+ * diferentes compartilhariam os mesmos estados); as contagens, sim,
+ * uma por transição, o que permite contagem por prefixo, rank e
+ * seleção sem percorrer as palavras.
+ */
+
+#include "trie.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DAWG_TERMINAL 1
+#define DAWG_ULTIMA 2
+
+/**
+ * @struct transicao_dawg
+ * @brief Transição por um caractere (8 bytes).
+ *
+ * DAWG_TERMINAL indica que a palavra lida até este caractere existe.
+ */
+typedef struct transicao_dawg {
+    uint32_t destino;
+    char caractere;
+    uint8_t marcas;
+    uint8_t reservado[2];
+} transicao_dawg;
+
+/**
+ * @struct dawg
+ * @brief Autômato mínimo de palavras.
+ *
+ * contagens[i] é a quantidade de palavras lidas passando pela
+ * transição i (ela mesma, se terminal, mais as do seu destino).
+ */
+typedef struct dawg {
+    transicao_dawg* transicoes;
+    uint32_t* contagens;
+    size_t total_transicoes;
+    size_t total_estados;
+    uint32_t raiz;
+} dawg;
+
+/**
+ * @struct dawg_quadro
+ * @brief Quadro da pilha do cursor: próxima transição a visitar.
+ */
+typedef struct dawg_quadro {
+    uint32_t transicao;
+    size_t profundidade;
+} dawg_quadro;
+
+/**
+ * @struct dawg_cursor
+ * @brief Cursor de percurso em ordem lexicográfica sobre o autômato.
+ *
+ * Mesmo comportamento de trie_cursor.
+ */
+typedef struct dawg_cursor {
+    const dawg* dawg;
+    dawg_quadro* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    char* buffer;
+    size_t capacidade_buffer;
+    bool prefixo_pendente;
+    bool falhou;
+} dawg_cursor;
+
+/**
+ * @brief Constrói o autômato mínimo com as palavras da Trie.
+ *
+ * Os estados são registrados de baixo para cima: um estado só é
+ * montado depois de seus destinos, e um estado igual a um já
+ * registrado é reaproveitado. A Trie não é alterada.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ *
+ * @return Autômato construído ou NULL em caso de falha.
+ */
+dawg* dawg_construir(const no_trie* raiz);
+
+/**
+ * @brief Libera o autômato.
+ *
+ * @param dawg Autômato a ser liberado (pode ser NULL).
+ */
+void dawg_destruir(dawg* dawg);
+
+/**
+ * @brief Verifica se a palavra está no autômato.
+ *
+ * @param dawg Autômato consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra está no autômato.
+ */
+bool dawg_contem(const dawg* dawg, const char* palavra);
+
+/**
+ * @brief Busca palavras a até max_distancia edições da palavra dada.
+ *
+ * Mesmo contrato de trie_buscar_aproximado.
+ *
+ * @param dawg Autômato consultado.
+ * @param palavra Palavra já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** dawg_buscar_aproximado(const dawg* dawg,
+                              const char* palavra,
+                              size_t max_distancia,
+                              size_t* quantidade);
+
+/**
+ * @brief Busca palavras que casam com um padrão com curingas.
+ *
+ * Mesmo contrato de trie_buscar_padrao.
+ *
+ * @param dawg Autômato consultado.
+ * @param padrao Padrão já normalizado.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** dawg_buscar_padrao(const dawg* dawg,
+                          const char* padrao,
+                          size_t* quantidade);
+
+/**
+ * @brief Conta as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_contar_prefixo.
+ *
+ * @param dawg Autômato consultado.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo.
+ */
+size_t dawg_contar_prefixo(const dawg* dawg, const char* prefixo);
+
+/**
+ * @brief Posição da palavra na ordem lexicográfica.
+ *
+ * Mesmo contrato de trie_rank.
+ *
+ * @param dawg Autômato consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Quantidade de palavras menores que a palavra.
+ */
+size_t dawg_rank(const dawg* dawg, const char* palavra);
+
+/**
+ * @brief Retorna a k-ésima palavra (a partir de 0) em ordem lexicográfica.
+ *
+ * Mesmo contrato de trie_selecionar.
+ *
+ * @param dawg Autômato consultado.
+ * @param k Posição da palavra.
+ *
+ * @return Cópia da palavra (liberada pelo chamador) ou NULL.
+ */
+char* dawg_selecionar(const dawg* dawg, size_t k);
+
+/**
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_cursor_abrir.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param dawg Autômato consultado.
+ * @param prefixo String do prefixo (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool dawg_cursor_abrir(dawg_cursor* cursor,
+                       const dawg* dawg,
+                       const char* prefixo);
+
+/**
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * Mesmo contrato de trie_cursor_proximo.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim (ou em falha).
+ */
+const char* dawg_cursor_proximo(dawg_cursor* cursor);
+
+/**
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void dawg_cursor_fechar(dawg_cursor* cursor);
+
+#endif
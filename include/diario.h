@@ -0,0 +1,137 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+/**
+ * @file diario.h
+ * @brief Diário de alterações (registro somente de acréscimo).
+ *
+ * Cada adição ou remoção é acrescentada ao fim do arquivo como um
+ * registro com soma de verificação. Ao abrir, os registros existentes
+ * são reaplicados em ordem; um registro incompleto ou corrompido (de
+ * uma gravação interrompida) encerra a leitura e é cortado do arquivo
+ * junto com o que vier depois.
+ * Os registros são acumulados em um buffer e gravados e sincronizados
+ * com o disco em lotes: só os registros já sincronizados sobrevivem a
+ * uma queda do sistema.
+ *
+ * Formato: cabeçalho de 16 bytes (mágico e versão) seguido dos
+ * registros. Cada registro tem o tamanho da palavra (uint32), o peso
+ * (uint32), a operação (uint8), a palavra sem '\0' e a soma FNV-1a de
+ * 32 bits dos bytes anteriores do registro, na ordem de bytes da
+ * máquina.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define DIARIO_VERSAO 1
+
+/**
+ * @enum operacao_diario
+ * @brief Alteração descrita por um registro.
+ */
+typedef enum operacao_diario {
+    DIARIO_ADICIONAR = 1,
+    DIARIO_ADICIONAR_COM_PESO,
+    DIARIO_REMOVER,
+} operacao_diario;
+
+/**
+ * @brief Reaplica um registro lido do arquivo.
+ *
+ * @return false para interromper a abertura (por exemplo, em falha de
+ * alocação).
+ */
+typedef bool (*diario_aplicar)(operacao_diario operacao,
+                               const char* palavra,
+                               uint32_t peso,
+                               void* contexto);
+
+/**
+ * @struct diario
+ * @brief Diário aberto para acréscimo.
+ *
+ * 'buffer' guarda os registros ainda não gravados; 'pendentes' conta
+ * os registros ainda não sincronizados e 'registros', os registros do
+ * arquivo (inclusive os do buffer) desde o último esvaziamento.
+ * Depois de uma falha de gravação, 'falhou' fica marcado e nada mais
+ * é gravado.
+ */
+typedef struct diario {
+    FILE* arquivo;
+    char* buffer;
+    size_t usados;
+    size_t capacidade;
+    size_t pendentes;
+    size_t lote;
+    size_t registros;
+    bool falhou;
+} diario;
+
+/**
+ * @brief Abre (ou cria) o diário e reaplica seus registros.
+ *
+ * @param caminho Caminho do arquivo.
+ * @param lote Registros por sincronização (1 sincroniza a cada
+ *        registro; 0 só em diario_sincronizar e diario_fechar).
+ * @param aplicar Função chamada para cada registro válido, em ordem.
+ * @param contexto Ponteiro repassado a 'aplicar'.
+ *
+ * @return Diário pronto para acréscimo ou NULL se o arquivo não puder
+ * ser aberto, não for um diário ou a reaplicação for interrompida.
+ */
+diario* diario_abrir(const char* caminho,
+                     size_t lote,
+                     diario_aplicar aplicar,
+                     void* contexto);
+
+/**
+ * @brief Acrescenta um registro ao diário.
+ *
+ * O registro vai para o buffer; o lote é gravado e sincronizado
+ * quando completo.
+ *
+ * @param diario Diário utilizado.
+ * @param operacao Alteração registrada.
+ * @param palavra Palavra alterada (já normalizada).
+ * @param peso Peso da palavra (usado só em DIARIO_ADICIONAR_COM_PESO).
+ *
+ * @return false se o diário falhou (o registro não foi aceito).
+ */
+bool diario_registrar(diario* diario,
+                      operacao_diario operacao,
+                      const char* palavra,
+                      uint32_t peso);
+
+/**
+ * @brief Grava o buffer e sincroniza o arquivo com o disco.
+ *
+ * @param diario Diário utilizado.
+ *
+ * @return true se todos os registros aceitos estão no disco.
+ */
+bool diario_sincronizar(diario* diario);
+
+/**
+ * @brief Descarta todos os registros (após uma consolidação).
+ *
+ * Corta o arquivo de volta ao cabeçalho e descarta o buffer.
+ *
+ * @param diario Diário utilizado.
+ *
+ * @return true se o arquivo foi cortado e sincronizado.
+ */
+bool diario_esvaziar(diario* diario);
+
+/**
+ * @brief Sincroniza e fecha o diário.
+ *
+ * @param diario Diário a ser fechado (NULL é ignorado).
+ *
+ * @return true se todos os registros aceitos estão no disco.
+ */
+bool diario_fechar(diario* diario);
+
+#endif
@@ -6,21 +6,113 @@
  * @brief Definição de estrutura e API de um dicionário.
  */
 
+#include "dawg.h"
+#include "epoca.h"
+#include "motor.h"
+#include "snapshot.h"
 #include "trie.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * @struct dicionario
  * @brief Representa um dicionário (conjunto de palavras únicas).
  *
- * É armazenado a raiz da árvore TRIE e a quantidade total de palavras.
+ * É armazenado a raiz da árvore TRIE, a arena de onde seus nós
+ * são alocados e a quantidade total de palavras.
+ * Um dicionário aberto de um snapshot não possui raiz nem arena:
+ * as consultas são feitas direto no arquivo e ele é somente leitura.
+ * Um dicionário congelado (ver dicionario_congelar) também não possui
+ * raiz nem arena: as consultas são feitas no autômato 'dawg'.
+ * Um dicionário criado com outro motor (ver motor_dicionario) guarda
+ * as palavras em 'motor', também sem raiz nem arena.
+ * No modo concorrente (ver dicionario_ativar_concorrencia), a raiz
+ * publicada fica em 'concorrencia' e o campo raiz é NULL.
+ * Com a remoção adiada (ver dicionario_adiar_remocoes), 'lixo' conta
+ * as remoções desde a última compactação, feita automaticamente
+ * quando chega a 'limite_lixo' (0 desliga o modo).
+ * Um dicionário persistente (ver dicionario_abrir_persistente) guarda
+ * em 'persistencia' o diário de alterações e o snapshot em que ele é
+ * consolidado.
  */
 typedef struct dicionario {
     no_trie* raiz;
+    arena_nos* arena;
+    snapshot* snapshot;
+    dawg* dawg;
+    motor* motor;
+    struct concorrencia_dicionario* concorrencia;
+    struct persistencia_dicionario* persistencia;
     size_t total_palavras;
+    size_t lixo;
+    size_t limite_lixo;
 } dicionario;
 
+/**
+ * @struct dicionario_cursor
+ * @brief Cursor sobre as palavras de um dicionário.
+ *
+ * Encapsula o cursor da Trie, do snapshot, do autômato ou do motor,
+ * conforme o dicionário.
+ * No modo concorrente, o cursor mantém uma seção de leitura aberta
+ * ('epoca' e 'vaga') até ser fechado e ocupa uma das
+ * EPOCA_MAX_LEITORES vagas de leitor.
+ */
+typedef struct dicionario_cursor {
+    bool em_snapshot;
+    bool em_dawg;
+    bool em_motor;
+    epoca_dominio* epoca;
+    size_t vaga;
+    union {
+        trie_cursor trie;
+        snapshot_cursor snapshot;
+        dawg_cursor dawg;
+        motor_cursor motor;
+    };
+} dicionario_cursor;
+
+/**
+ * @struct estatisticas_dicionario
+ * @brief Medidas de ocupação e forma de um dicionário.
+ *
+ * Os campos do topo vêm de contadores mantidos a cada inserção e
+ * remoção e custam O(1). 'varredura' só é preenchida (e 'completo'
+ * só é true) quando a varredura completa é pedida e o dicionário não
+ * está congelado.
+ * Em um snapshot, nós e bytes se referem ao arquivo mapeado; em um
+ * dicionário congelado, 'nos' conta os estados do autômato e os bytes
+ * se referem aos vetores de transições e de contagens.
+ */
+typedef struct estatisticas_dicionario {
+    size_t palavras;
+    size_t nos;
+    size_t bytes_usados;
+    size_t bytes_reservados;
+    double proporcao_terminais;
+    bool completo;
+    estatisticas_trie varredura;
+} estatisticas_dicionario;
+
+/**
+ * @enum motor_dicionario
+ * @brief Estrutura usada para guardar as palavras de um dicionário.
+ *
+ * DICIONARIO_MOTOR_TRIE é a Trie ternária de ponteiros, mantida no
+ * próprio dicionário. Os demais usam a interface de motor.h:
+ * DICIONARIO_MOTOR_VETOR_DUPLO é a Trie de vetor duplo (um acesso por
+ * caractere) e DICIONARIO_MOTOR_RAJADA a Trie de rajada (sufixos em
+ * recipientes contíguos, para cargas e percursos em massa). Esses
+ * motores não têm modo concorrente nem carga paralela (que passa a
+ * ser sequencial).
+ */
+typedef enum motor_dicionario {
+    DICIONARIO_MOTOR_TRIE,
+    DICIONARIO_MOTOR_VETOR_DUPLO,
+    DICIONARIO_MOTOR_RAJADA,
+} motor_dicionario;
+
 /*
  * @brief Inicializa uma estrutura de dicionário
  *
@@ -28,9 +120,236 @@ typedef struct dicionario {
  */
 dicionario* dicionario_criar();
 
+/*
+ * @brief Inicializa um dicionário com o motor informado.
+ *
+ * @param motor Estrutura usada para guardar as palavras.
+ *
+ * @return Ponteiro para o dicionário criado ou NULL em caso de falha.
+ */
+dicionario* dicionario_criar_com_motor(motor_dicionario motor);
+
+/*
+ * @brief Abre um dicionário somente leitura a partir de um snapshot.
+ *
+ * O arquivo é mapeado em memória e consultado diretamente, sem
+ * reconstruir a árvore; vários processos podem compartilhar as
+ * mesmas páginas do arquivo.
+ *
+ * @param caminho Caminho para o arquivo de snapshot.
+ *
+ * @return Ponteiro para o dicionário ou NULL se o arquivo for inválido.
+ */
+dicionario* dicionario_abrir_snapshot(const char* caminho);
+
+/*
+ * @brief Carrega um snapshot em um dicionário que pode ser alterado.
+ *
+ * Ao contrário de dicionario_abrir_snapshot, os nós são copiados
+ * para uma Trie em memória (em sequência, na ordem do arquivo), sem
+ * percorrer palavra a palavra; o arquivo é fechado em seguida.
+ *
+ * @param caminho Caminho para o arquivo de snapshot.
+ *
+ * @return Ponteiro para o dicionário ou NULL se o arquivo for inválido
+ *         ou em falha de alocação.
+ */
+dicionario* dicionario_carregar_snapshot(const char* caminho);
+
+/*
+ * @brief Abre um dicionário persistente: snapshot mais diário.
+ *
+ * Carrega o snapshot (se o arquivo existir; do contrário começa
+ * vazio) e reaplica as alterações do diário. A partir daí, cada
+ * adição (inclusive de arquivo) e remoção é acrescentada ao diário e
+ * gravada no disco em lotes de 'lote' registros. Quando o diário
+ * chega a 'limite' registros, o dicionário é consolidado (ver
+ * dicionario_consolidar), de modo que reabrir custa carregar o
+ * snapshot mais no máximo 'limite' registros.
+ * Uma queda do sistema perde no máximo os registros do lote ainda
+ * não sincronizado; uma gravação interrompida no fim do diário é
+ * descartada ao reabrir. Se o diário não aceitar um registro (em
+ * falha de gravação ou de sincronização), o dicionário é consolidado
+ * na hora. Se a consolidação também falhar, a alteração fica só na
+ * memória: a função que a fez retorna false (dicionario_remover_lote
+ * retorna SIZE_MAX) e dicionario_sincronizar retorna false até a
+ * próxima consolidação bem-sucedida.
+ * A carga paralela passa a ser sequencial. Só se aplica ao motor
+ * DICIONARIO_MOTOR_TRIE.
+ *
+ * @param caminho_snapshot Caminho do snapshot de consolidação.
+ * @param caminho_diario Caminho do diário (criado se não existir).
+ * @param lote Registros por sincronização (1 sincroniza a cada
+ *        alteração; 0 só em dicionario_sincronizar e ao destruir).
+ * @param limite Registros que disparam a consolidação (0 para só
+ *        consolidar explicitamente).
+ *
+ * @return Ponteiro para o dicionário ou NULL se algum dos arquivos
+ *         for inválido ou não puder ser aberto.
+ */
+dicionario* dicionario_abrir_persistente(const char* caminho_snapshot,
+                                         const char* caminho_diario,
+                                         size_t lote,
+                                         size_t limite);
+
+/*
+ * @brief Grava no disco as alterações ainda no lote do diário.
+ *
+ * @param dicionario Dicionário persistente.
+ *
+ * @return true se todas as alterações estão no disco, false se o
+ *         dicionário não é persistente ou se alguma alteração desde a
+ *         última consolidação não pôde ser gravada.
+ */
+bool dicionario_sincronizar(dicionario* dicionario);
+
+/*
+ * @brief Consolida o diário no snapshot do dicionário persistente.
+ *
+ * Compacta as remoções adiadas pendentes, grava o dicionário inteiro
+ * no snapshot (por troca atômica do arquivo) e só então esvazia o
+ * diário. Uma queda entre as duas etapas é inofensiva: reaplicar o
+ * diário sobre o snapshot novo leva ao mesmo conjunto, pois cada
+ * registro define o estado final da sua palavra.
+ * No modo concorrente, as escritas esperam a consolidação.
+ *
+ * @param dicionario Dicionário persistente.
+ *
+ * @return true se consolidou, false se o dicionário não é persistente
+ *         ou em falha (o diário continua válido).
+ */
+bool dicionario_consolidar(dicionario* dicionario);
+
+/*
+ * @brief Grava o dicionário em um arquivo de snapshot.
+ *
+ * @param dicionario Dicionário a ser gravado (não pode ser um snapshot).
+ * @param caminho Caminho para o arquivo de snapshot.
+ *
+ * @return true se o arquivo foi gravado, false se não.
+ */
+bool dicionario_salvar_snapshot(const dicionario* dicionario,
+                                const char* caminho);
+
+/*
+ * @brief Indica se o dicionário é somente leitura.
+ *
+ * @param dicionario Dicionário consultado.
+ *
+ * @return true se o dicionário foi aberto de um snapshot ou congelado.
+ */
+bool dicionario_somente_leitura(const dicionario* dicionario);
+
+/*
+ * @brief Congela o dicionário em um autômato mínimo (DAWG).
+ *
+ * A Trie é convertida em um autômato que compartilha também os
+ * sufixos comuns (como "-ção" e "-mente") e depois liberada. A partir
+ * daí o dicionário é somente leitura. Pertinência, buscas por
+ * prefixo, aproximada e por padrão, listagem e cursores percorrem o
+ * autômato; contagem por prefixo, rank e seleção usam as contagens
+ * guardadas em cada transição. Só a busca ranqueada não se aplica,
+ * pois os pesos não são guardados (ver
+ * dicionario_buscar_por_prefixo_ranqueado).
+ * Não se aplica a snapshots nem ao modo concorrente.
+ *
+ * @param dicionario Dicionário a ser congelado.
+ *
+ * @return true se o dicionário foi congelado (ou já estava), false se
+ *         não se aplica ou em falha (o dicionário fica inalterado).
+ */
+bool dicionario_congelar(dicionario* dicionario);
+
+/*
+ * @brief Permite consultas concorrentes com alterações.
+ *
+ * A partir desta chamada, buscas, listagens e cursores podem ser
+ * usados por várias threads ao mesmo tempo que adições e remoções,
+ * sem bloqueio: cada escrita copia os nós do caminho alterado e
+ * publica atomicamente uma nova raiz, e os nós substituídos só são
+ * reaproveitados quando nenhum leitor pode mais alcançá-los.
+ * As escritas são serializadas entre si. Até EPOCA_MAX_LEITORES
+ * leituras (cursores abertos incluídos) ficam abertas ao mesmo tempo
+ * sem bloqueio; além disso, as leituras esperam pelo mutex de escrita
+ * e novos cursores não são abertos. Deve ser chamada antes de o
+ * dicionário ser compartilhado entre threads. O campo total_palavras
+ * só é estável enquanto não houver escritas em andamento.
+ * Só se aplica ao motor DICIONARIO_MOTOR_TRIE.
+ *
+ * @param dicionario Dicionário utilizado.
+ *
+ * @return true se o modo foi ativado (ou já estava), false se não se
+ *         aplica ou em falha.
+ */
+bool dicionario_ativar_concorrencia(dicionario* dicionario);
+
+/*
+ * @brief Mantém balanceados os irmãos de cada nível da Trie.
+ *
+ * Os irmãos de um nível (os caracteres possíveis após um mesmo
+ * prefixo) formam uma árvore binária cujo formato depende da ordem de
+ * inserção: um arquivo em ordem alfabética gera listas. A partir
+ * desta chamada, que rebalanceia os níveis existentes, inserções e
+ * remoções mantêm cada nível balanceado com rotações, e cada
+ * caractere de uma busca custa no máximo 6 comparações, qualquer que
+ * seja a ordem de carga. O modo continua ativo no modo concorrente e
+ * após a compactação.
+ * Não se aplica ao modo concorrente (deve ser chamada antes) nem aos
+ * demais motores.
+ *
+ * @param dicionario Dicionário utilizado.
+ *
+ * @return true se o modo foi ativado, false se não se aplica ou em
+ *         falha.
+ */
+bool dicionario_balancear_irmaos(dicionario* dicionario);
+
+/*
+ * @brief Liga ou desliga a remoção adiada.
+ *
+ * Com a remoção adiada, remover uma palavra só desmarca o seu fim na
+ * Trie, sem podar nós: rajadas de remoções custam apenas a descida.
+ * Os nós que ficam sem palavras continuam alocados (e são
+ * reaproveitados se a palavra voltar) até a próxima compactação,
+ * feita automaticamente quando o número de remoções desde a última
+ * chega a 'limite', ou com dicionario_compactar. Como a compactação
+ * percorre a Trie inteira, 'limite' deve crescer com o dicionário.
+ * No modo concorrente as remoções continuam podando na hora.
+ * Só se aplica ao motor DICIONARIO_MOTOR_TRIE.
+ *
+ * @param dicionario Dicionário utilizado.
+ * @param limite Remoções que disparam a compactação (SIZE_MAX para
+ *        só compactar explicitamente; 0 desliga o modo e compacta o
+ *        que estiver pendente).
+ *
+ * @return true se o modo foi alterado, false se não se aplica ou em
+ *         falha.
+ */
+bool dicionario_adiar_remocoes(dicionario* dicionario, size_t limite);
+
+/*
+ * @brief Reconstrói a Trie sem os nós que não levam a nenhuma palavra.
+ *
+ * Copia os nós que ainda levam a alguma palavra para uma nova arena,
+ * em sequência, e libera a antiga de uma vez: os nós deixados pela
+ * remoção adiada são recuperados em bloco e a Trie fica contígua na
+ * memória. Cursores abertos ficam inválidos. Precisa de memória para
+ * as duas cópias durante a operação.
+ * Não se aplica ao modo concorrente nem aos demais motores.
+ *
+ * @param dicionario Dicionário utilizado.
+ *
+ * @return true se compactou, false se não se aplica ou em falha (o
+ *         dicionário fica inalterado).
+ */
+bool dicionario_compactar(dicionario* dicionario);
+
 /*
  * @brief Libera a estrutura de dicionário.
  *
+ * Todos os nós são liberados de uma vez junto com a arena. O diário
+ * de um dicionário persistente é sincronizado e fechado.
+ *
  * @param dicionario Dicionário a ser liberado.
  */
 void dicionario_destruir(dicionario* dicionario);
@@ -39,15 +358,39 @@ void dicionario_destruir(dicionario* dicionario);
  * @brief Adiciona palavra ao dicionário.
  *
  * Se palavra for adicionada com sucesso
- * quantidade de palavras é incrementada.
+ * quantidade de palavras é incrementada. Uma palavra válida tem
+ * apenas letras e no máximo NORMALIZACAO_MAX_LETRAS (255) delas,
+ * desconsiderando os espaços das pontas.
  *
  * @param dicionario Ponteiro para dicionário utilizado.
  * @param palavra Palavra a ser adicionada no dicionário.
  *
- * @return true se foi possível adicionar, false se não.
+ * @return true se foi possível adicionar, false se não (inclusive se,
+ *         em um dicionário persistente, a adição não pôde ser
+ *         registrada; ver dicionario_abrir_persistente).
  */
 bool dicionario_adicionar_palavra(dicionario* dicionario, const char* palavra);
 
+/*
+ * @brief Adiciona palavra ao dicionário com um peso.
+ *
+ * O peso (por exemplo, a frequência de uso) ordena as sugestões de
+ * dicionario_buscar_por_prefixo_ranqueado. Se a palavra já existir,
+ * apenas seu peso é substituído. Palavras adicionadas sem peso têm
+ * peso 0.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavra Palavra a ser adicionada no dicionário.
+ * @param peso Peso da palavra.
+ *
+ * @return true se a palavra foi adicionada, false se já existia ou
+ *         não foi possível adicionar ou registrar a alteração (ver
+ *         dicionario_abrir_persistente).
+ */
+bool dicionario_adicionar_palavra_com_peso(dicionario* dicionario,
+                                           const char* palavra,
+                                           uint32_t peso);
+
 /*
  * @brief Remove uma palavra no dicionário.
  *
@@ -57,10 +400,62 @@ bool dicionario_adicionar_palavra(dicionario* dicionario, const char* palavra);
  * @param dicionario Ponteiro para dicionário utilizado.
  * @param palavra Palavra que será removida no dicionário.
  *
- * @return true se foi possível remover, false se não.
+ * @return true se foi possível remover, false se não (inclusive se,
+ *         em um dicionário persistente, a remoção não pôde ser
+ *         registrada; ver dicionario_abrir_persistente).
  */
 bool dicionario_remover_palavra(dicionario* dicionario, const char* palavra);
 
+/*
+ * @brief Remove um conjunto de palavras de uma só vez.
+ *
+ * As palavras são normalizadas, ordenadas e removidas em um único
+ * percurso da Trie (trie_remover_lote), em vez de uma descida a partir
+ * da raiz por palavra. Palavras inválidas ou NULL são ignoradas.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavras Palavras a serem removidas, em qualquer ordem.
+ * @param quantidade Quantidade de palavras.
+ *
+ * @return Quantidade de palavras removidas ou SIZE_MAX se, em um
+ *         dicionário persistente, as remoções não puderam ser
+ *         registradas (ver dicionario_abrir_persistente).
+ */
+size_t dicionario_remover_lote(dicionario* dicionario,
+                               const char* const* palavras,
+                               size_t quantidade);
+
+/*
+ * @brief Verifica se a palavra está no dicionário.
+ *
+ * A palavra é normalizada como nas demais operações, em um buffer na
+ * pilha, e a busca não aloca memória (exceto para palavras muito
+ * longas).
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavra Palavra procurada.
+ *
+ * @return true se a palavra existir, false se não ou se for inválida.
+ */
+bool dicionario_contem(const dicionario* dicionario, const char* palavra);
+
+/*
+ * @brief Verifica várias palavras de uma vez.
+ *
+ * Equivale a chamar dicionario_contem para cada palavra, mas as
+ * buscas na árvore são intercaladas para sobrepor as faltas de cache;
+ * compensa em dicionários maiores que o cache do processador.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavras Palavras procuradas (posições NULL resultam false).
+ * @param n Quantidade de palavras.
+ * @param resultados Recebe, na posição de cada palavra, se ela existe.
+ */
+void dicionario_contem_lote(const dicionario* dicionario,
+                            const char* const* palavras,
+                            size_t n,
+                            bool* resultados);
+
 /*
  * @brief Busca palavras por prefixo no dicionário.
  *
@@ -76,6 +471,133 @@ char** dicionario_buscar_por_prefixo(dicionario* dicionario,
                                      const char* prefixo,
                                      size_t* quantidade);
 
+/*
+ * @brief Busca as k primeiras palavras com o prefixo no dicionário.
+ *
+ * As palavras são retornadas em ordem lexicográfica e a busca termina
+ * assim que k palavras são encontradas, de modo que o custo depende
+ * de k e não do tamanho da subárvore do prefixo.
+ * O retorno deve ser liberado pelo chamador.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param prefixo Prefixo das palavras que serão retornadas.
+ * @param k Quantidade máxima de palavras retornadas.
+ * @param quantidade Ponteiro informando a quantidade de palavras retornadas.
+ *
+ * @return Array de strings armazenando as palavras encontradas.
+ */
+char** dicionario_buscar_por_prefixo_limitado(dicionario* dicionario,
+                                              const char* prefixo,
+                                              size_t k,
+                                              size_t* quantidade);
+
+/*
+ * @brief Busca as k palavras de maior peso com o prefixo no dicionário.
+ *
+ * As palavras são retornadas em ordem decrescente de peso (a ordem
+ * entre pesos iguais não é definida). Cada subárvore guarda o maior
+ * peso de suas palavras, de modo que a busca só visita os caminhos
+ * que levam às k palavras retornadas e seus vizinhos imediatos.
+ * O retorno deve ser liberado pelo chamador.
+ * Um dicionário congelado não guarda pesos: a busca retorna NULL e
+ * informa quantidade SIZE_MAX, para não ser confundida com um
+ * resultado vazio.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param prefixo Prefixo das palavras (NULL ou vazio = todas).
+ * @param k Quantidade máxima de palavras retornadas.
+ * @param quantidade Ponteiro informando a quantidade de palavras retornadas
+ *        (SIZE_MAX se a busca não se aplica).
+ *
+ * @return Array de strings armazenando as palavras encontradas.
+ */
+char** dicionario_buscar_por_prefixo_ranqueado(const dicionario* dicionario,
+                                               const char* prefixo,
+                                               size_t k,
+                                               size_t* quantidade);
+
+/*
+ * @brief Busca palavras parecidas com a palavra informada.
+ *
+ * Retorna, em ordem lexicográfica, as palavras a até max_distancia
+ * edições (inserção, remoção ou substituição de uma letra) da palavra
+ * normalizada. Útil para sugestões do tipo "você quis dizer".
+ * O retorno deve ser liberado pelo chamador.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavra Palavra de referência.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro informando a quantidade de palavras retornadas.
+ *
+ * @return Array de strings armazenando as palavras encontradas.
+ */
+char** dicionario_buscar_aproximado(const dicionario* dicionario,
+                                    const char* palavra,
+                                    size_t max_distancia,
+                                    size_t* quantidade);
+
+/*
+ * @brief Busca palavras que casam com um padrão com curingas.
+ *
+ * '?' casa exatamente uma letra e '*' casa zero ou mais letras; por
+ * exemplo, "c?s*" casa "casa" e "cosmos". O padrão é normalizado como
+ * as palavras (trim e minúsculas). Subárvores que não podem casar não
+ * são visitadas, de modo que padrões que começam com letras custam
+ * próximo da quantidade de palavras encontradas.
+ * O retorno deve ser liberado pelo chamador.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param padrao Padrão procurado.
+ * @param quantidade Ponteiro informando a quantidade de palavras retornadas.
+ *
+ * @return Array de strings armazenando as palavras encontradas.
+ */
+char** dicionario_buscar_padrao(const dicionario* dicionario,
+                                const char* padrao,
+                                size_t* quantidade);
+
+/*
+ * @brief Conta as palavras com o prefixo no dicionário.
+ *
+ * Cada nó guarda a quantidade de palavras de sua subárvore, de modo
+ * que o custo depende do tamanho do prefixo e não da quantidade de
+ * palavras contadas.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param prefixo Prefixo das palavras (NULL ou vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo (0 se inválido).
+ */
+size_t dicionario_contar_prefixo(const dicionario* dicionario,
+                                 const char* prefixo);
+
+/*
+ * @brief Posição da palavra na ordem lexicográfica do dicionário.
+ *
+ * Retorna a quantidade de palavras menores que a informada, que não
+ * precisa estar no dicionário. Se ela estiver, dicionario_selecionar
+ * com esse valor retorna a própria palavra.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param palavra Palavra de referência.
+ *
+ * @return Posição da palavra ou SIZE_MAX se a palavra for inválida.
+ */
+size_t dicionario_rank(const dicionario* dicionario, const char* palavra);
+
+/*
+ * @brief Retorna a k-ésima palavra do dicionário em ordem lexicográfica.
+ *
+ * Permite paginar a listagem sem percorrer as palavras anteriores.
+ * O retorno deve ser liberado pelo chamador.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param k Posição da palavra, a partir de 0.
+ *
+ * @return Cópia da palavra ou NULL se k >= total de palavras.
+ */
+char* dicionario_selecionar(const dicionario* dicionario, size_t k);
+
 /*
  * @brief Obtém todas as palavras contidas no dicionário.
  *
@@ -88,30 +610,168 @@ char** dicionario_buscar_por_prefixo(dicionario* dicionario,
  */
 char** dicionario_listar_palavras(dicionario* dicionario, size_t* quantidade);
 
+/*
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * O prefixo é normalizado como nas demais operações; se for NULL,
+ * o cursor percorre todo o dicionário. As palavras são obtidas com
+ * dicionario_cursor_proximo, sem alocação por palavra, e o cursor
+ * deve ser fechado com dicionario_cursor_fechar mesmo em caso de falha.
+ *
+ * @param dicionario Ponteiro para dicionário utilizado.
+ * @param prefixo Prefixo das palavras percorridas (ou NULL).
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ *
+ * @return true se o cursor foi aberto, false se o prefixo for inválido
+ * ou em caso de falha (inclusive, no modo concorrente, se já houver
+ * EPOCA_MAX_LEITORES seções de leitura abertas).
+ */
+bool dicionario_cursor_abrir(dicionario* dicionario,
+                             const char* prefixo,
+                             dicionario_cursor* cursor);
+
+/*
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * A string retornada pertence ao cursor e só é válida até a próxima
+ * chamada. O dicionário não deve ser alterado com o cursor aberto,
+ * exceto no modo concorrente, em que o cursor enxerga a versão
+ * publicada na sua abertura.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim.
+ */
+const char* dicionario_cursor_proximo(dicionario_cursor* cursor);
+
+/*
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void dicionario_cursor_fechar(dicionario_cursor* cursor);
+
 /*
  * @brief Adiciona palavras contidas no arquivo informado.
  *
- * Lê o arquivo informado e adiciona as palavras que forem válidas.
- * Deve haver uma palavra por linha apenas no arquivo.
+ * Lê o arquivo informado e adiciona as palavras que forem válidas
+ * (ver dicionario_adicionar_palavra); linhas mais longas que o limite
+ * de letras são ignoradas. Deve haver uma palavra por linha apenas no
+ * arquivo.
  *
  * @param dicionario Ponteiro para o dicionário utilizado.
  * @param caminho Caminho para o arquivo utilizado.
  *
- * @return true se foi possível abrir o arquivo, false se não.
+ * @return true se foi possível abrir o arquivo, false se não ou se
+ *         uma alteração não pôde ser registrada no diário de um
+ *         dicionário persistente.
  */
 bool dicionario_adicionar_de_arquivo(dicionario* dicionario,
                                      const char* caminho);
 
+/*
+ * @brief Adiciona palavras com peso contidas no arquivo informado.
+ *
+ * Cada linha tem a forma "palavra<TAB>peso", com peso decimal de até
+ * 32 bits. Linhas sem tabulação são adicionadas sem alterar o peso e
+ * linhas com peso inválido são ignoradas.
+ *
+ * @param dicionario Ponteiro para o dicionário utilizado.
+ * @param caminho Caminho para o arquivo utilizado.
+ *
+ * @return true se foi possível abrir o arquivo, false se não ou se
+ *         uma alteração não pôde ser registrada no diário de um
+ *         dicionário persistente.
+ */
+bool dicionario_adicionar_de_arquivo_com_peso(dicionario* dicionario,
+                                              const char* caminho);
+
+/*
+ * @brief Adiciona palavras do arquivo montando uma árvore balanceada.
+ *
+ * Normaliza, ordena e remove duplicatas das palavras válidas do
+ * arquivo e as insere em ordem "mediana primeiro". Assim, as
+ * subárvores esquerda/direita de cada nível ficam balanceadas mesmo
+ * quando o arquivo já está em ordem alfabética.
+ *
+ * @param dicionario Ponteiro para o dicionário utilizado.
+ * @param caminho Caminho para o arquivo utilizado.
+ *
+ * @return true se foi possível abrir o arquivo, false se não ou se
+ *         uma alteração não pôde ser registrada no diário de um
+ *         dicionário persistente.
+ */
+bool dicionario_adicionar_de_arquivo_balanceado(dicionario* dicionario,
+                                                const char* caminho);
+
+/*
+ * @brief Adiciona palavras do arquivo usando várias threads.
+ *
+ * As linhas são separadas pela primeira letra e cada thread monta,
+ * com sua própria arena, as subárvores das letras que assumir. Ao
+ * final, as subárvores são ligadas sob a raiz sentinela em uma árvore
+ * de irmãos balanceada e os nós passam para a arena do dicionário.
+ * No modo concorrente, a carga é feita por dicionario_adicionar_de_arquivo.
+ *
+ * @param dicionario Ponteiro para o dicionário utilizado.
+ * @param caminho Caminho para o arquivo utilizado.
+ * @param threads Quantidade de threads (0 usa a quantidade de núcleos).
+ *
+ * @return true se o arquivo foi carregado, false se não ou se uma
+ *         alteração não pôde ser registrada no diário de um dicionário
+ *         persistente.
+ */
+bool dicionario_adicionar_de_arquivo_paralelo(dicionario* dicionario,
+                                              const char* caminho,
+                                              size_t threads);
+
+/*
+ * @brief Mede os caminhos de busca das palavras do dicionário.
+ *
+ * Um dicionário congelado não é uma Trie: mede 0.
+ *
+ * @param dicionario Ponteiro para o dicionário utilizado.
+ * @param media Ponteiro para a quantidade média de nós visitados por busca.
+ * @param maximo Ponteiro para a maior quantidade de nós visitados.
+ */
+void dicionario_medir_caminhos(const dicionario* dicionario,
+                               double* media,
+                               size_t* maximo);
+
+/*
+ * @brief Obtém as estatísticas do dicionário.
+ *
+ * Sem varredura, apenas os contadores mantidos pela inserção e pela
+ * remoção são lidos. Com varredura, todos os nós são percorridos para
+ * obter profundidades, comprimentos e o histograma das alturas dos
+ * conjuntos de irmãos (ver estatisticas_trie), útil para encontrar
+ * árvores de irmãos degeneradas. Em um snapshot, a varredura percorre
+ * os nós do arquivo. Um dicionário congelado não é uma Trie e não é
+ * varrido ('completo' fica false).
+ *
+ * @param dicionario Ponteiro para o dicionário utilizado.
+ * @param estatisticas Estrutura preenchida.
+ * @param varredura true para percorrer todos os nós.
+ *
+ * @return true se obtidas, false se algum parâmetro for NULL.
+ */
+bool dicionario_estatisticas(const dicionario* dicionario,
+                             estatisticas_dicionario* estatisticas,
+                             bool varredura);
+
 /*
  * @brief Remove palavras contidas no arquivo informado do dicionário.
  *
- * Lê o arquivo informado e remove as palavras que forem válidas.
+ * Lê o arquivo informado e remove as palavras que forem válidas,
+ * todas em um único percurso, como em dicionario_remover_lote.
  * Deve haver uma palavra por linha apenas no arquivo.
  *
  * @param dicionario Ponteiro para o dicionário utilizado.
  * @param caminho Caminho para o arquivo utilizado.
  *
- * @return true se foi possível abrir o arquivo, false se não.
+ * @return true se foi possível abrir o arquivo, false se não ou se
+ *         uma alteração não pôde ser registrada no diário de um
+ *         dicionário persistente.
  */
 bool dicionario_remover_de_arquivo(dicionario* dicionario, const char* caminho);
 
@@ -0,0 +1,83 @@
+#ifndef DISTANCIA_H
+#define DISTANCIA_H
+
+/**
+ * @file distancia.h
+ * @brief Busca por distância de edição (Levenshtein) limitada.
+ *
+ * O estado é independente da representação da árvore: o percurso
+ * (da Trie ou do snapshot) informa cada caractere visitado e a
+ * profundidade em que ele está, e decide se desce pelo filho do meio
+ * conforme o mínimo da linha calculada.
+ */
+
+#include "util.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct busca_aproximada
+ * @brief Linhas da matriz de Levenshtein por profundidade do percurso.
+ *
+ * A linha p corresponde ao prefixo de p caracteres atualmente em
+ * 'prefixo'; cada linha tem tamanho + 1 posições.
+ */
+typedef struct busca_aproximada {
+    const char* palavra;
+    size_t tamanho;
+    size_t max_distancia;
+    size_t* linhas;
+    size_t capacidade_linhas;
+    char* prefixo;
+    size_t capacidade_prefixo;
+    lista_palavras resultado;
+    bool falhou;
+} busca_aproximada;
+
+/**
+ * @brief Inicializa a busca com a linha da profundidade 0.
+ *
+ * @param busca Estado a ser inicializado (alocado pelo chamador).
+ * @param palavra Palavra procurada, já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ *
+ * @return true se inicializada, false em caso de falha de alocação.
+ */
+bool busca_aproximada_iniciar(busca_aproximada* busca,
+                              const char* palavra,
+                              size_t max_distancia);
+
+/**
+ * @brief Calcula a linha do prefixo estendido por um caractere.
+ *
+ * @param busca Estado da busca.
+ * @param profundidade Tamanho do prefixo antes do caractere.
+ * @param caractere Caractere do nó visitado.
+ *
+ * @return Menor valor da nova linha; se for maior que max_distancia,
+ * nenhuma palavra abaixo do nó pode ser aceita (SIZE_MAX em falha).
+ */
+size_t busca_aproximada_avancar(busca_aproximada* busca,
+                                size_t profundidade,
+                                char caractere);
+
+/**
+ * @brief Guarda o prefixo atual se ele estiver dentro da distância.
+ *
+ * @param busca Estado da busca.
+ * @param profundidade Tamanho do prefixo (linha já calculada).
+ */
+void busca_aproximada_aceitar(busca_aproximada* busca, size_t profundidade);
+
+/**
+ * @brief Libera o estado e entrega as palavras aceitas.
+ *
+ * @param busca Estado da busca.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras (NULL se nenhuma ou em falha).
+ */
+char** busca_aproximada_concluir(busca_aproximada* busca, size_t* quantidade);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef EPOCA_H
+#define EPOCA_H
+
+/**
+ * @file epoca.h
+ * @brief Recuperação de nós baseada em épocas para leitores concorrentes.
+ *
+ * Leitores marcam a época global ao entrar e desmarcam ao sair, sem
+ * bloqueio. Um escritor (sempre um por vez) aposenta os nós que deixou
+ * de publicar; eles só voltam à arena quando a época global avançou
+ * duas vezes, o que garante que nenhum leitor ainda os enxerga.
+ */
+
+#include "arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EPOCA_MAX_LEITORES 64
+#define EPOCA_SEM_VAGA SIZE_MAX
+
+typedef struct epoca_dominio epoca_dominio;
+
+/**
+ * @brief Cria um domínio de épocas sem leitores nem nós aposentados.
+ *
+ * @return Ponteiro para o domínio ou NULL em caso de falha.
+ */
+epoca_dominio* epoca_criar(void);
+
+/**
+ * @brief Libera o domínio, devolvendo à arena os nós aposentados.
+ *
+ * Não pode haver leitores ativos.
+ *
+ * @param dominio Domínio a ser liberado.
+ * @param arena Arena de onde os nós foram obtidos (ou NULL).
+ */
+void epoca_destruir(epoca_dominio* dominio, arena_nos* arena);
+
+/**
+ * @brief Inicia uma seção de leitura.
+ *
+ * Cada thread usa sua própria vaga enquanto houver no máximo
+ * EPOCA_MAX_LEITORES seções abertas; a entrada então é uma única
+ * operação atômica. Seções aninhadas usam vagas distintas.
+ * Com todas as vagas ocupadas, a entrada falha em vez de esperar: o
+ * chamador deve ler de outra forma (por exemplo, excluindo o escritor)
+ * ou desistir.
+ *
+ * @param dominio Domínio utilizado.
+ *
+ * @return Vaga ocupada, a ser informada em epoca_sair, ou
+ * EPOCA_SEM_VAGA se todas estiverem ocupadas.
+ */
+size_t epoca_entrar(epoca_dominio* dominio);
+
+/**
+ * @brief Encerra a seção de leitura iniciada por epoca_entrar.
+ *
+ * @param dominio Domínio utilizado.
+ * @param vaga Vaga retornada por epoca_entrar.
+ */
+void epoca_sair(epoca_dominio* dominio, size_t vaga);
+
+/**
+ * @brief Registra um nó que deixará de ser publicado.
+ *
+ * O nó fica pendente até epoca_confirmar ou epoca_descartar. Tem a
+ * assinatura de trie_aposentar, com o domínio como contexto.
+ * Se não houver memória para registrá-lo, o nó nunca é reaproveitado.
+ *
+ * @param no Nó substituído.
+ * @param dominio Domínio utilizado (void* por compatibilidade).
+ */
+void epoca_aposentar(no_trie* no, void* dominio);
+
+/**
+ * @brief Confirma os nós pendentes, depois de publicada a nova versão.
+ *
+ * Em seguida tenta avançar a época e devolve à arena os nós que
+ * nenhum leitor pode mais alcançar. Uso exclusivo do escritor.
+ *
+ * @param dominio Domínio utilizado.
+ * @param arena Arena de onde os nós foram obtidos (ou NULL).
+ */
+void epoca_confirmar(epoca_dominio* dominio, arena_nos* arena);
+
+/**
+ * @brief Descarta os nós pendentes de uma alteração que falhou.
+ *
+ * Os nós continuam publicados e, portanto, em uso.
+ *
+ * @param dominio Domínio utilizado.
+ */
+void epoca_descartar(epoca_dominio* dominio);
+
+#endif
@@ -30,4 +30,17 @@ dicionario* menu_inicial();
  */
 void menu_principal(dicionario* dicionario);
 
+/*
+ * @brief Executa um comando em lote, sem interação com o usuário.
+ *
+ * Comando aceito: "estatisticas <arquivo>", que carrega o arquivo
+ * (lista de palavras ou snapshot) e imprime suas estatísticas.
+ *
+ * @param argc Quantidade de argumentos (sem o nome do programa).
+ * @param argv Argumentos do comando.
+ *
+ * @return Código de saída do programa.
+ */
+int menu_lote(int argc, char** argv);
+
 #endif
@@ -0,0 +1,322 @@
+#ifndef MOTOR_H
+#define MOTOR_H
+
+/**
+ * @file motor.h
+ * @brief Interface comum dos motores de armazenamento de palavras.
+ *
+ * Um motor é uma tabela de operações (operacoes_motor) e os dados da
+ * estrutura que ela manipula. As operações obrigatórias cobrem
+ * inserção, remoção, pertinência, peso, cursor em ordem lexicográfica,
+ * medidas e liberação. As buscas ranqueada, aproximada e por padrão,
+ * a contagem por prefixo, o rank e a seleção são opcionais: se o motor
+ * não as fornecer (NULL), as funções motor_* as resolvem percorrendo
+ * o cursor, em tempo linear no número de palavras percorridas.
+ *
+ * Todas as palavras, prefixos e padrões recebidos já estão
+ * normalizados.
+ */
+
+#include "trie.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct medidas_motor
+ * @brief Ocupação de um motor, obtida de contadores em O(1).
+ */
+typedef struct medidas_motor {
+    size_t nos;
+    size_t bytes_usados;
+    size_t bytes_reservados;
+} medidas_motor;
+
+/**
+ * @struct operacoes_motor
+ * @brief Tabela de operações de um motor.
+ *
+ * Os contratos são os das funções motor_* correspondentes. O cursor
+ * é alocado por cursor_abrir (NULL em falha) e liberado por
+ * cursor_fechar; a string de cursor_proximo pertence ao cursor.
+ */
+typedef struct operacoes_motor {
+    const char* nome;
+    void* (*criar)(void);
+    void (*destruir)(void* dados);
+    bool (*inserir)(void* dados, const char* palavra, const uint32_t* peso);
+    bool (*remover)(void* dados, const char* palavra);
+    bool (*contem)(const void* dados, const char* palavra);
+    uint32_t (*peso)(const void* dados, const char* palavra);
+    void* (*cursor_abrir)(const void* dados, const char* prefixo);
+    const char* (*cursor_proximo)(void* cursor);
+    bool (*cursor_falhou)(const void* cursor);
+    void (*cursor_fechar)(void* cursor);
+    void (*medir)(const void* dados, medidas_motor* medidas);
+    void (*coletar_estatisticas)(const void* dados,
+                                 estatisticas_trie* estatisticas);
+
+    char** (*buscar_ranqueado)(const void* dados,
+                               const char* prefixo,
+                               size_t k,
+                               size_t* quantidade);
+    char** (*buscar_aproximado)(const void* dados,
+                                const char* palavra,
+                                size_t max_distancia,
+                                size_t* quantidade);
+    char** (*buscar_padrao)(const void* dados,
+                            const char* padrao,
+                            size_t* quantidade);
+    size_t (*contar_prefixo)(const void* dados, const char* prefixo);
+    size_t (*rank)(const void* dados, const char* palavra);
+    char* (*selecionar)(const void* dados, size_t k);
+} operacoes_motor;
+
+/**
+ * @struct motor
+ * @brief Operações e dados de um motor criado.
+ */
+typedef struct motor {
+    const operacoes_motor* operacoes;
+    void* dados;
+} motor;
+
+/**
+ * @struct motor_cursor
+ * @brief Cursor aberto sobre um motor.
+ */
+typedef struct motor_cursor {
+    const operacoes_motor* operacoes;
+    void* estado;
+} motor_cursor;
+
+/**
+ * @brief Trie ternária de ponteiros (trie.h) com arena própria.
+ */
+extern const operacoes_motor MOTOR_TRIE_TERNARIA;
+
+/**
+ * @brief Trie de vetor duplo (trie_dupla.h).
+ */
+extern const operacoes_motor MOTOR_VETOR_DUPLO;
+
+/**
+ * @brief Trie de rajada com recipientes de hash (trie_rajada.h).
+ *
+ * Não fornece as operações opcionais.
+ */
+extern const operacoes_motor MOTOR_RAJADA;
+
+/**
+ * @brief Cria um motor vazio.
+ *
+ * @param operacoes Tabela de operações do motor.
+ *
+ * @return Ponteiro para o motor ou NULL em caso de falha.
+ */
+motor* motor_criar(const operacoes_motor* operacoes);
+
+/**
+ * @brief Libera o motor e todas as suas palavras.
+ *
+ * @param motor Motor a ser liberado (pode ser NULL).
+ */
+void motor_destruir(motor* motor);
+
+/**
+ * @brief Insere a palavra, gravando o peso se informado.
+ *
+ * Se a palavra já existir, apenas o seu peso é atualizado (quando
+ * 'peso' não for NULL).
+ *
+ * @param motor Motor utilizado.
+ * @param palavra Palavra já normalizada.
+ * @param peso Peso da palavra (ou NULL).
+ *
+ * @return true se a palavra foi inserida, false se já existia ou em
+ *         falha.
+ */
+bool motor_inserir(motor* motor, const char* palavra, const uint32_t* peso);
+
+/**
+ * @brief Remove a palavra.
+ *
+ * @param motor Motor utilizado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra foi removida, false se não existia.
+ */
+bool motor_remover(motor* motor, const char* palavra);
+
+/**
+ * @brief Verifica se a palavra está no motor.
+ *
+ * @param motor Motor consultado.
+ * @param palavra Palavra já normalizada (ou NULL).
+ *
+ * @return true se a palavra está no motor.
+ */
+bool motor_contem(const motor* motor, const char* palavra);
+
+/**
+ * @brief Peso da palavra.
+ *
+ * @param motor Motor consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Peso da palavra (0 se ela não estiver no motor).
+ */
+uint32_t motor_peso(const motor* motor, const char* palavra);
+
+/**
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_cursor_abrir: o cursor deve ser fechado com
+ * motor_cursor_fechar, mesmo se esta função retornar false.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param motor Motor consultado.
+ * @param prefixo String do prefixo (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool motor_cursor_abrir(motor_cursor* cursor,
+                        const motor* motor,
+                        const char* prefixo);
+
+/**
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim (ou em falha).
+ */
+const char* motor_cursor_proximo(motor_cursor* cursor);
+
+/**
+ * @brief Indica se o cursor parou por falha de alocação.
+ *
+ * @param cursor Cursor consultado.
+ *
+ * @return true se houve falha (ou se o cursor não foi aberto).
+ */
+bool motor_cursor_falhou(const motor_cursor* cursor);
+
+/**
+ * @brief Libera os recursos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void motor_cursor_fechar(motor_cursor* cursor);
+
+/**
+ * @brief Lista todas as palavras em ordem lexicográfica.
+ *
+ * @param motor Motor consultado.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras (NULL se nenhuma ou em falha).
+ */
+char** motor_listar(const motor* motor, size_t* quantidade);
+
+/**
+ * @brief Ocupação do motor.
+ *
+ * @param motor Motor consultado.
+ * @param medidas Estrutura preenchida.
+ */
+void motor_medir(const motor* motor, medidas_motor* medidas);
+
+/**
+ * @brief Mede o motor percorrendo toda a sua estrutura.
+ *
+ * @param motor Motor consultado.
+ * @param estatisticas Estrutura preenchida.
+ */
+void motor_coletar_estatisticas(const motor* motor,
+                                estatisticas_trie* estatisticas);
+
+/**
+ * @brief Busca as k palavras de maior peso com o prefixo.
+ *
+ * Sem a operação no motor, percorre o cursor do prefixo mantendo as
+ * k melhores; empates de peso saem em ordem lexicográfica.
+ *
+ * @param motor Motor consultado.
+ * @param prefixo Prefixo já normalizado (vazio = todas).
+ * @param k Quantidade máxima de palavras.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem decrescente de peso.
+ */
+char** motor_buscar_por_prefixo_ranqueado(const motor* motor,
+                                          const char* prefixo,
+                                          size_t k,
+                                          size_t* quantidade);
+
+/**
+ * @brief Busca as palavras a no máximo 'max_distancia' edições.
+ *
+ * Sem a operação no motor, percorre todas as palavras reaproveitando
+ * as linhas da matriz do prefixo comum com a palavra anterior.
+ *
+ * @param motor Motor consultado.
+ * @param palavra Palavra já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem lexicográfica.
+ */
+char** motor_buscar_aproximado(const motor* motor,
+                               const char* palavra,
+                               size_t max_distancia,
+                               size_t* quantidade);
+
+/**
+ * @brief Busca as palavras que casam com o padrão.
+ *
+ * Sem a operação no motor, percorre todas as palavras como em
+ * motor_buscar_aproximado.
+ *
+ * @param motor Motor consultado.
+ * @param padrao Padrão já normalizado.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem lexicográfica.
+ */
+char** motor_buscar_padrao(const motor* motor,
+                           const char* padrao,
+                           size_t* quantidade);
+
+/**
+ * @brief Conta as palavras com o prefixo informado.
+ *
+ * @param motor Motor consultado.
+ * @param prefixo Prefixo já normalizado (vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo.
+ */
+size_t motor_contar_prefixo(const motor* motor, const char* prefixo);
+
+/**
+ * @brief Posição da palavra na ordem lexicográfica.
+ *
+ * @param motor Motor consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Quantidade de palavras menores que a palavra.
+ */
+size_t motor_rank(const motor* motor, const char* palavra);
+
+/**
+ * @brief Retorna a k-ésima palavra (a partir de 0) em ordem lexicográfica.
+ *
+ * @param motor Motor consultado.
+ * @param k Posição da palavra.
+ *
+ * @return Cópia da palavra (liberada pelo chamador) ou NULL.
+ */
+char* motor_selecionar(const motor* motor, size_t k);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef NORMALIZACAO_H
+#define NORMALIZACAO_H
+
+/**
+ * @file normalizacao.h
+ * @brief Núcleos vetorizados de normalização de palavras.
+ *
+ * O núcleo copia as letras ASCII iniciais de um trecho convertendo-as
+ * para minúsculo, em blocos de 16 (SSE2) ou 32 (AVX2) bytes. A versão
+ * é escolhida na primeira chamada conforme a CPU; fora de x86-64 só
+ * existe a versão escalar. normalizar_trecho (util.h) e
+ * normalizar_linhas são montadas sobre ele.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Maior palavra aceita, em letras. Linhas mais longas são rejeitadas:
+ * a inserção na Trie desce um nível de recursão por letra.
+ */
+#define NORMALIZACAO_MAX_LETRAS 255
+
+/**
+ * @enum nucleo_normalizacao
+ * @brief Versões do núcleo de normalização.
+ */
+typedef enum {
+    NORMALIZACAO_ESCALAR,
+    NORMALIZACAO_SSE2,
+    NORMALIZACAO_AVX2
+} nucleo_normalizacao;
+
+/**
+ * @brief Copia as letras iniciais do trecho, em minúsculo.
+ *
+ * Para no primeiro byte que não for letra de a–z ou A–Z. Bytes de
+ * destino além do valor retornado (até 'tamanho') podem ser
+ * sobrescritos; nenhum terminador é escrito.
+ *
+ * @param origem Início do trecho.
+ * @param tamanho Quantidade de bytes do trecho.
+ * @param destino Buffer com ao menos 'tamanho' bytes (distinto de origem).
+ *
+ * @return Quantidade de letras copiadas.
+ */
+size_t normalizar_letras(const char* origem, size_t tamanho, char* destino);
+
+/**
+ * @brief Normaliza todas as linhas de um texto em uma passada.
+ *
+ * Cada linha é tratada como por normalizar_trecho; as válidas, não
+ * vazias e com até NORMALIZACAO_MAX_LETRAS letras são escritas em
+ * sequência no destino, cada uma seguida de
+ * '\0'. Para cada linha, o mesmo percurso encontra o fim da linha,
+ * converte e valida as letras.
+ *
+ * @param texto Início do texto (não precisa ser terminado em '\0').
+ * @param tamanho Quantidade de bytes do texto.
+ * @param destino Buffer com ao menos tamanho + 1 bytes (distinto de texto).
+ * @param usados Ponteiro para indicar quantos bytes foram escritos.
+ *
+ * @return Quantidade de palavras escritas.
+ */
+size_t normalizar_linhas(const char* texto,
+                         size_t tamanho,
+                         char* destino,
+                         size_t* usados);
+
+/**
+ * @brief Versão do núcleo em uso.
+ *
+ * @return Núcleo escolhido (ou o selecionado por normalizacao_selecionar).
+ */
+nucleo_normalizacao normalizacao_nucleo(void);
+
+/**
+ * @brief Troca a versão do núcleo em uso, para comparações.
+ *
+ * @param nucleo Versão desejada.
+ *
+ * @return true se a CPU suporta a versão, false caso contrário (o
+ *         núcleo em uso não muda).
+ */
+bool normalizacao_selecionar(nucleo_normalizacao nucleo);
+
+/**
+ * @brief Nome da versão do núcleo ("escalar", "sse2" ou "avx2").
+ *
+ * @param nucleo Versão consultada.
+ *
+ * @return String constante com o nome.
+ */
+const char* normalizacao_nome(nucleo_normalizacao nucleo);
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef PADRAO_H
+#define PADRAO_H
+
+/**
+ * @file padrao.h
+ * @brief Busca por padrão com curingas ('?' e '*').
+ *
+ * '?' casa exatamente uma letra e '*' casa zero ou mais letras. O
+ * padrão é simulado como um autômato: para cada profundidade do
+ * percurso guarda-se o conjunto de posições do padrão ainda ativas.
+ * Assim, cada palavra é aceita uma única vez e o percurso só desce
+ * por nós que mantêm alguma posição ativa.
+ */
+
+#include "util.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct busca_padrao
+ * @brief Conjuntos de posições ativas por profundidade do percurso.
+ *
+ * A linha p tem tamanho + 1 posições; a posição 'tamanho' indica que
+ * o padrão foi consumido por inteiro.
+ */
+typedef struct busca_padrao {
+    const char* padrao;
+    size_t tamanho;
+    bool* estados;
+    size_t capacidade_linhas;
+    char* prefixo;
+    size_t capacidade_prefixo;
+    lista_palavras resultado;
+    bool falhou;
+} busca_padrao;
+
+/**
+ * @brief Normaliza um padrão no próprio buffer.
+ *
+ * Aplica trim e minúsculas, valida (apenas letras, '?' e '*') e
+ * junta asteriscos consecutivos.
+ *
+ * @param padrao Padrão a ser normalizado.
+ *
+ * @return true se o padrão for válido e não vazio, false se não.
+ */
+bool padrao_normalizar(char* padrao);
+
+/**
+ * @brief Inicializa a busca com o conjunto da profundidade 0.
+ *
+ * @param busca Estado a ser inicializado (alocado pelo chamador).
+ * @param padrao Padrão já normalizado.
+ *
+ * @return true se inicializada, false em caso de falha de alocação.
+ */
+bool busca_padrao_iniciar(busca_padrao* busca, const char* padrao);
+
+/**
+ * @brief Informa o intervalo de letras aceitas na profundidade.
+ *
+ * Irmãos fora do intervalo [minimo, maximo] não podem casar; com um
+ * curinga ativo, o intervalo cobre todos os caracteres.
+ *
+ * @param busca Estado da busca.
+ * @param profundidade Profundidade dos irmãos visitados.
+ * @param minimo Menor caractere aceito.
+ * @param maximo Maior caractere aceito.
+ */
+void busca_padrao_limites(const busca_padrao* busca,
+                          size_t profundidade,
+                          char* minimo,
+                          char* maximo);
+
+/**
+ * @brief Calcula o conjunto do prefixo estendido por um caractere.
+ *
+ * @param busca Estado da busca.
+ * @param profundidade Tamanho do prefixo antes do caractere.
+ * @param caractere Caractere do nó visitado.
+ *
+ * @return true se o padrão ainda pode consumir letras após o caractere
+ * (vale a pena descer pelo filho do meio).
+ */
+bool busca_padrao_avancar(busca_padrao* busca,
+                          size_t profundidade,
+                          char caractere);
+
+/**
+ * @brief Guarda o prefixo atual se o padrão foi consumido por inteiro.
+ *
+ * @param busca Estado da busca.
+ * @param profundidade Tamanho do prefixo (conjunto já calculado).
+ */
+void busca_padrao_aceitar(busca_padrao* busca, size_t profundidade);
+
+/**
+ * @brief Libera o estado e entrega as palavras aceitas.
+ *
+ * @param busca Estado da busca.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras (NULL se nenhuma ou em falha).
+ */
+char** busca_padrao_concluir(busca_padrao* busca, size_t* quantidade);
+
+#endif
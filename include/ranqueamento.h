@@ -0,0 +1,134 @@
+#ifndef RANQUEAMENTO_H
+#define RANQUEAMENTO_H
+
+/**
+ * @file ranqueamento.h
+ * @brief Busca das k palavras de maior peso (melhor primeiro).
+ *
+ * Cada candidato é uma subárvore, com chave igual ao maior peso de
+ * palavra dentro dela, ou uma palavra completa, com chave igual ao
+ * seu peso. Retirar sempre o candidato de maior chave garante que as
+ * palavras saem em ordem decrescente de peso, e apenas subárvores no
+ * caminho dessas palavras são abertas.
+ *
+ * O estado é independente da representação da árvore: o nó de cada
+ * candidato é um ponteiro ou um índice, conforme o percurso.
+ */
+
+#include "util.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct candidato_ranqueado
+ * @brief Subárvore ou palavra completa aguardando na fila.
+ *
+ * 'elo' identifica o prefixo antes do caractere do nó (subárvore) ou
+ * a própria palavra (completo).
+ */
+typedef struct candidato_ranqueado {
+    uintptr_t no;
+    size_t elo;
+    uint32_t peso;
+    bool completo;
+} candidato_ranqueado;
+
+/**
+ * @struct elo_prefixo
+ * @brief Um caractere acrescentado ao prefixo de um elo anterior.
+ *
+ * O elo 0 representa o prefixo buscado, sem caracteres acrescentados.
+ */
+typedef struct elo_prefixo {
+    size_t anterior;
+    size_t profundidade;
+    char caractere;
+} elo_prefixo;
+
+/**
+ * @struct busca_ranqueada
+ * @brief Fila de prioridade de candidatos e elos de prefixo.
+ */
+typedef struct busca_ranqueada {
+    const char* prefixo;
+    size_t tamanho_prefixo;
+    candidato_ranqueado* fila;
+    size_t tamanho_fila;
+    size_t capacidade_fila;
+    elo_prefixo* elos;
+    size_t quantidade_elos;
+    size_t capacidade_elos;
+    char* buffer;
+    size_t capacidade_buffer;
+    lista_palavras resultado;
+    bool falhou;
+} busca_ranqueada;
+
+/**
+ * @brief Inicializa a busca com o elo do prefixo.
+ *
+ * @param busca Estado a ser inicializado (alocado pelo chamador).
+ * @param prefixo Prefixo já normalizado (pode ser vazio).
+ *
+ * @return true se inicializada, false em caso de falha de alocação.
+ */
+bool busca_ranqueada_iniciar(busca_ranqueada* busca, const char* prefixo);
+
+/**
+ * @brief Acrescenta um candidato à fila.
+ *
+ * @param busca Estado da busca.
+ * @param candidato Candidato a ser acrescentado.
+ */
+void busca_ranqueada_inserir(busca_ranqueada* busca,
+                             candidato_ranqueado candidato);
+
+/**
+ * @brief Retira o candidato de maior peso.
+ *
+ * Em caso de empate, palavras completas saem antes de subárvores.
+ *
+ * @param busca Estado da busca.
+ * @param candidato Recebe o candidato retirado.
+ *
+ * @return false se a fila estiver vazia ou a busca tiver falhado.
+ */
+bool busca_ranqueada_retirar(busca_ranqueada* busca,
+                             candidato_ranqueado* candidato);
+
+/**
+ * @brief Cria o elo do prefixo 'elo' seguido de 'caractere'.
+ *
+ * @param busca Estado da busca.
+ * @param elo Elo anterior.
+ * @param caractere Caractere acrescentado.
+ * @param novo Recebe o índice do novo elo.
+ *
+ * @return true se criado, false em caso de falha de alocação.
+ */
+bool busca_ranqueada_estender(busca_ranqueada* busca,
+                              size_t elo,
+                              char caractere,
+                              size_t* novo);
+
+/**
+ * @brief Monta a palavra do elo e a acrescenta ao resultado.
+ *
+ * @param busca Estado da busca.
+ * @param elo Elo da palavra.
+ */
+void busca_ranqueada_aceitar(busca_ranqueada* busca, size_t elo);
+
+/**
+ * @brief Libera o estado e entrega as palavras aceitas.
+ *
+ * @param busca Estado da busca.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras (NULL se nenhuma ou em falha).
+ */
+char** busca_ranqueada_concluir(busca_ranqueada* busca, size_t* quantidade);
+
+#endif
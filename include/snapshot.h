@@ -0,0 +1,299 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/**
+ * @file snapshot.h
+ * @brief Formato binário da Trie e consultas diretas sobre o arquivo.
+ *
+ * O arquivo é composto por um cabeçalho seguido de um vetor de nós de
+ * 28 bytes. Os filhos são referenciados por índice no vetor, de modo
+ * que o arquivo pode ser mapeado em qualquer endereço e consultado
+ * sem desserialização. O índice 0 é a raiz sentinela, que nunca é
+ * filho de outro nó; por isso 0 também representa "sem filho".
+ * Os campos são gravados na ordem de bytes da máquina.
+ */
+
+#include "arquivo.h"
+#include "trie.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPSHOT_VERSAO 3
+
+/**
+ * @struct cabecalho_snapshot
+ * @brief Cabeçalho do arquivo de snapshot.
+ */
+typedef struct cabecalho_snapshot {
+    char magico[8];
+    uint32_t versao;
+    uint32_t tamanho_no;
+    uint64_t total_palavras;
+    uint64_t total_nos;
+} cabecalho_snapshot;
+
+/**
+ * @struct no_snapshot
+ * @brief Nó da Trie ternária no formato do arquivo.
+ */
+typedef struct no_snapshot {
+    uint32_t esquerdo;
+    uint32_t meio;
+    uint32_t direito;
+    uint32_t peso;
+    uint32_t peso_maximo;
+    uint32_t contagem;
+    char caractere;
+    uint8_t terminal;
+    uint8_t altura;
+    uint8_t reservado;
+} no_snapshot;
+
+/**
+ * @struct snapshot
+ * @brief Snapshot aberto (mapeado em memória) para consulta.
+ */
+typedef struct snapshot {
+    arquivo_mapeado arquivo;
+    const no_snapshot* nos;
+    size_t total_nos;
+    size_t total_palavras;
+} snapshot;
+
+/**
+ * @struct snapshot_quadro
+ * @brief Quadro da pilha explícita usada pelo cursor de snapshot.
+ *
+ * As fases têm o mesmo significado que em trie_quadro.
+ */
+typedef struct snapshot_quadro {
+    uint32_t no;
+    int fase;
+    size_t profundidade;
+} snapshot_quadro;
+
+/**
+ * @struct snapshot_cursor
+ * @brief Cursor em ordem lexicográfica sobre um snapshot.
+ */
+typedef struct snapshot_cursor {
+    const snapshot* snapshot;
+    snapshot_quadro* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    char* buffer;
+    size_t capacidade_buffer;
+    bool prefixo_pendente;
+    bool falhou;
+} snapshot_cursor;
+
+/**
+ * @brief Grava a Trie informada em um arquivo de snapshot.
+ *
+ * O arquivo é escrito em um temporário, sincronizado com o disco e
+ * renomeado ao final, de modo que um snapshot existente nunca fica
+ * parcialmente gravado, nem mesmo após uma queda do sistema.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param total_palavras Quantidade de palavras da Trie.
+ * @param caminho Caminho do arquivo a ser gravado.
+ *
+ * @return true se o arquivo foi gravado, false se não.
+ */
+bool snapshot_salvar(const no_trie* raiz,
+                     size_t total_palavras,
+                     const char* caminho);
+
+/**
+ * @brief Abre um arquivo de snapshot para consulta.
+ *
+ * Além do cabeçalho, o grafo de nós é validado uma única vez: todo
+ * nó além da sentinela tem exatamente um pai, que vem antes dele no
+ * vetor, os irmãos respeitam a ordem de caracteres de uma árvore de
+ * busca e o total de palavras do cabeçalho confere com a contagem da
+ * raiz. Assim as consultas sempre terminam e a recursão por irmãos
+ * fica limitada ao alfabeto, mesmo com um arquivo corrompido ou
+ * malicioso. Essa passagem lê todos os nós uma vez; depois eles são
+ * lidos sob demanda.
+ *
+ * @param caminho Caminho do arquivo.
+ *
+ * @return Ponteiro para o snapshot ou NULL se o arquivo for inválido.
+ */
+snapshot* snapshot_abrir(const char* caminho);
+
+/**
+ * @brief Copia o snapshot para uma Trie em memória, que pode ser alterada.
+ *
+ * Os nós são alocados em sequência, na ordem do arquivo, e os
+ * agregados e alturas gravados são mantidos. O resultado é sempre uma
+ * árvore, pois snapshot_abrir já validou o grafo de nós.
+ *
+ * @param snapshot Snapshot aberto.
+ * @param destino Arena que recebe os nós.
+ *
+ * @return Sentinela da Trie ou NULL em falha de alocação (os nós já
+ * copiados ficam em 'destino').
+ */
+no_trie* snapshot_copiar_para_trie(const snapshot* snapshot,
+                                   arena_nos* destino);
+
+/**
+ * @brief Verifica se o arquivo informado é um snapshot.
+ *
+ * @param caminho Caminho do arquivo.
+ *
+ * @return true se o arquivo começar com o cabeçalho de snapshot.
+ */
+bool snapshot_eh_arquivo(const char* caminho);
+
+/**
+ * @brief Fecha o snapshot, desfazendo o mapeamento.
+ *
+ * @param snapshot Snapshot a ser fechado.
+ */
+void snapshot_fechar(snapshot* snapshot);
+
+/**
+ * @brief Verifica se a palavra está no snapshot.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra existir, false se não.
+ */
+bool snapshot_contem(const snapshot* snapshot, const char* palavra);
+
+/**
+ * @brief Busca palavras a até max_distancia edições da palavra dada.
+ *
+ * Mesmo contrato de trie_buscar_aproximado.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param palavra Palavra já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** snapshot_buscar_aproximado(const snapshot* snapshot,
+                                  const char* palavra,
+                                  size_t max_distancia,
+                                  size_t* quantidade);
+
+/**
+ * @brief Busca palavras que casam com um padrão com curingas.
+ *
+ * Mesmo contrato de trie_buscar_padrao.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param padrao Padrão já normalizado.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** snapshot_buscar_padrao(const snapshot* snapshot,
+                              const char* padrao,
+                              size_t* quantidade);
+
+/**
+ * @brief Busca as k palavras de maior peso com o prefixo informado.
+ *
+ * Mesmo contrato de trie_buscar_por_prefixo_ranqueado.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ * @param k Número máximo de palavras a retornar.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** snapshot_buscar_por_prefixo_ranqueado(const snapshot* snapshot,
+                                             const char* prefixo,
+                                             size_t k,
+                                             size_t* quantidade);
+
+/**
+ * @brief Abre um cursor sobre as palavras do snapshot com o prefixo.
+ *
+ * Mesmo contrato de trie_cursor_abrir.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param snapshot Snapshot consultado.
+ * @param prefixo Prefixo já normalizado (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool snapshot_cursor_abrir(snapshot_cursor* cursor,
+                           const snapshot* snapshot,
+                           const char* prefixo);
+
+/**
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * Mesmo contrato de trie_cursor_proximo.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim.
+ */
+const char* snapshot_cursor_proximo(snapshot_cursor* cursor);
+
+/**
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void snapshot_cursor_fechar(snapshot_cursor* cursor);
+
+/**
+ * @brief Conta as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_contar_prefixo.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo.
+ */
+size_t snapshot_contar_prefixo(const snapshot* snapshot, const char* prefixo);
+
+/**
+ * @brief Posição da palavra na ordem lexicográfica.
+ *
+ * Mesmo contrato de trie_rank.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Quantidade de palavras menores que a palavra.
+ */
+size_t snapshot_rank(const snapshot* snapshot, const char* palavra);
+
+/**
+ * @brief Retorna a k-ésima palavra (a partir de 0) em ordem lexicográfica.
+ *
+ * Mesmo contrato de trie_selecionar.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param k Posição da palavra.
+ *
+ * @return Cópia da palavra (liberada pelo chamador) ou NULL.
+ */
+char* snapshot_selecionar(const snapshot* snapshot, size_t k);
+
+/**
+ * @brief Mede o snapshot percorrendo todos os seus nós.
+ *
+ * Mesmo contrato de trie_coletar_estatisticas.
+ *
+ * @param snapshot Snapshot consultado.
+ * @param estatisticas Estrutura preenchida (zerada se o snapshot for
+ *        vazio).
+ */
+void snapshot_coletar_estatisticas(const snapshot* snapshot,
+                                   estatisticas_trie* estatisticas);
+
+#endif
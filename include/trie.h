@@ -6,7 +6,10 @@
  * @brief Definição da estrutura e API de uma Trie ternária (TST).
  */
 
+#include "arena.h"
+
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /**
@@ -19,16 +22,66 @@
  * - no_direito: caracteres maiores
  *
  * O campo terminal indica se o caminho até este nó
- * representa o fim de uma palavra válida.
+ * representa o fim de uma palavra válida, e peso é o peso dessa
+ * palavra (0 se nenhum for informado). peso_maximo é o maior peso de
+ * palavra na subárvore do nó (o próprio nó e as três subárvores) e
+ * contagem é a quantidade de palavras nessa mesma subárvore.
+ * altura é a altura da árvore de irmãos do nó (só pelas ligações
+ * esquerda e direita), mantida apenas em Tries balanceadas; na
+ * sentinela, altura diferente de 0 marca a Trie como balanceada (ver
+ * trie_balancear). O campo ocupa o espaço de alinhamento do nó.
  */
 typedef struct no_trie {
     struct no_trie* no_esquerdo;
     struct no_trie* no_meio;
     struct no_trie* no_direito;
+    uint32_t peso;
+    uint32_t peso_maximo;
+    uint32_t contagem;
     bool terminal;
     char caractere;
+    uint8_t altura;
 } no_trie;
 
+/**
+ * @brief Recebe um nó substituído durante uma alteração com cópia.
+ *
+ * Também recebe os nós já publicados que a remoção poda da árvore.
+ * O nó ainda pode estar sendo lido por outras threads e não deve ser
+ * alterado nem liberado antes que isso seja seguro.
+ */
+typedef void (*trie_aposentar)(no_trie* no, void* contexto);
+
+/**
+ * @struct trie_quadro
+ * @brief Quadro da pilha explícita usada pelo cursor.
+ *
+ * A fase indica o que resta visitar do nó: 0 a subárvore esquerda,
+ * 1 o próprio nó e a subárvore do meio, 2 a subárvore direita.
+ */
+typedef struct trie_quadro {
+    const no_trie* no;
+    size_t profundidade;
+    int fase;
+} trie_quadro;
+
+/**
+ * @struct trie_cursor
+ * @brief Cursor de percurso em ordem lexicográfica sobre a Trie.
+ *
+ * Percorre a árvore com pilha explícita, montando cada palavra em um
+ * buffer interno reutilizado. Nenhuma alocação é feita por palavra.
+ */
+typedef struct trie_cursor {
+    trie_quadro* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    char* buffer;
+    size_t capacidade_buffer;
+    bool prefixo_pendente;
+    bool falhou;
+} trie_cursor;
+
 /**
  * @brief Cria um novo nó de Trie inicializado.
  *
@@ -52,14 +105,60 @@ void trie_destruir(no_trie* raiz);
  * @brief Insere palavra na Trie.
  *
  * Assume raiz como nó sentinela e começa a inserir a partir
- * do no_meio da raiz.
+ * do no_meio da raiz. Novos nós são obtidos da arena informada;
+ * se arena for NULL, cada nó é alocado individualmente no heap.
  *
  * @param raiz Ponteiro para a raiz da Trie.
+ * @param arena Arena de nós utilizada (ou NULL).
  * @param palavra String a ser inserida na Trie.
  *
  * @return true se for inserido, false se não for inserido.
  */
-bool trie_inserir(no_trie* raiz, const char* palavra);
+bool trie_inserir(no_trie* raiz, arena_nos* arena, const char* palavra);
+
+/*
+ * @brief Insere palavra na Trie com o peso informado.
+ *
+ * Se a palavra já existir, apenas o seu peso é atualizado.
+ *
+ * @param raiz Ponteiro para a raiz da Trie.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavra String a ser inserida na Trie.
+ * @param peso Peso da palavra.
+ *
+ * @return true se for inserido, false se não for inserido.
+ */
+bool trie_inserir_com_peso(no_trie* raiz,
+                           arena_nos* arena,
+                           const char* palavra,
+                           uint32_t peso);
+
+/*
+ * @brief Insere palavra sem alterar nenhum nó já existente.
+ *
+ * Os nós do caminho alterado são copiados (cópia de caminho) e os
+ * originais são entregues a 'aposentar'. A Trie anterior continua
+ * válida e consultável; a nova versão é a sentinela retornada.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da versão atual.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavra String a ser inserida na Trie.
+ * @param peso Peso da palavra (NULL mantém o peso de uma palavra já
+ * existente, ou 0 para uma nova).
+ * @param aposentar Função que recebe cada nó substituído.
+ * @param contexto Ponteiro repassado a 'aposentar'.
+ * @param inseriu Indica se a palavra foi inserida.
+ *
+ * @return Sentinela da nova versão (a própria raiz, se nada mudou) ou
+ * NULL em caso de falha de alocação.
+ */
+no_trie* trie_inserir_copiando(no_trie* raiz,
+                               arena_nos* arena,
+                               const char* palavra,
+                               const uint32_t* peso,
+                               trie_aposentar aposentar,
+                               void* contexto,
+                               bool* inseriu);
 
 /*
  * @brief Lista todas as palavras contidas na Trie informada.
@@ -75,6 +174,46 @@ bool trie_inserir(no_trie* raiz, const char* palavra);
  */
 char** trie_listar_palavras(no_trie* raiz, size_t* quantidade);
 
+/*
+ * @brief Verifica se a palavra está na Trie.
+ *
+ * A busca é iterativa e não aloca memória.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra existir, false se não.
+ */
+bool trie_contem(const no_trie* raiz, const char* palavra);
+
+/*
+ * @brief Peso da palavra.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Peso da palavra (0 se ela não existir).
+ */
+uint32_t trie_peso(const no_trie* raiz, const char* palavra);
+
+/*
+ * @brief Verifica várias palavras de uma vez.
+ *
+ * As buscas são intercaladas: várias descidas avançam juntas, um nó
+ * por vez, e o próximo nó de cada uma é pré-carregado no cache, de
+ * modo que a latência de memória de uma busca se sobrepõe à das
+ * outras.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavras Palavras já normalizadas.
+ * @param n Quantidade de palavras.
+ * @param resultados Recebe, na posição de cada palavra, se ela existe.
+ */
+void trie_contem_lote(const no_trie* raiz,
+                      const char* const* palavras,
+                      size_t n,
+                      bool* resultados);
+
 /*
  * @brief Realiza busca por prefixo na Trie.
  *
@@ -89,6 +228,174 @@ char** trie_listar_palavras(no_trie* raiz, size_t* quantidade);
 char**
 trie_buscar_por_prefixo(no_trie* raiz, const char* prefixo, size_t* quantidade);
 
+/*
+ * @brief Realiza busca por prefixo limitada às k primeiras palavras.
+ *
+ * Retorna as k primeiras palavras, em ordem lexicográfica, que contém
+ * o prefixo informado. O percurso é interrompido assim que k palavras
+ * são encontradas, sem visitar o restante da subárvore.
+ *
+ * @param raiz Ponteiro para a raiz da Trie.
+ * @param prefixo String do prefixo.
+ * @param k Quantidade máxima de palavras retornadas.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** trie_buscar_por_prefixo_limitado(no_trie* raiz,
+                                        const char* prefixo,
+                                        size_t k,
+                                        size_t* quantidade);
+
+/*
+ * @brief Busca palavras a até max_distancia edições da palavra dada.
+ *
+ * A distância é a de Levenshtein (inserção, remoção e substituição).
+ * Subárvores cujo prefixo já excede a distância não são visitadas.
+ * As palavras são retornadas em ordem lexicográfica.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavra Palavra já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** trie_buscar_aproximado(const no_trie* raiz,
+                              const char* palavra,
+                              size_t max_distancia,
+                              size_t* quantidade);
+
+/*
+ * @brief Busca palavras que casam com um padrão com curingas.
+ *
+ * '?' casa exatamente uma letra e '*' casa zero ou mais letras.
+ * Subárvores que não podem casar não são visitadas. As palavras são
+ * retornadas em ordem lexicográfica.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param padrao Padrão já normalizado (ver padrao_normalizar).
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** trie_buscar_padrao(const no_trie* raiz,
+                          const char* padrao,
+                          size_t* quantidade);
+
+/*
+ * @brief Busca as k palavras de maior peso com o prefixo informado.
+ *
+ * As palavras são retornadas em ordem decrescente de peso; a ordem
+ * entre palavras de mesmo peso não é definida. Apenas as subárvores
+ * cujo peso máximo pode superar as palavras já encontradas são
+ * visitadas.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ * @param k Número máximo de palavras a retornar.
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas.
+ */
+char** trie_buscar_por_prefixo_ranqueado(const no_trie* raiz,
+                                         const char* prefixo,
+                                         size_t k,
+                                         size_t* quantidade);
+
+/*
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * Se prefixo for NULL ou vazio, o cursor percorre todas as palavras.
+ * O cursor deve ser fechado com trie_cursor_fechar, mesmo se esta
+ * função retornar false.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param prefixo String do prefixo (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool trie_cursor_abrir(trie_cursor* cursor,
+                       const no_trie* raiz,
+                       const char* prefixo);
+
+/*
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * A string retornada pertence ao cursor e só é válida até a próxima
+ * chamada de trie_cursor_proximo ou trie_cursor_fechar. A Trie não
+ * deve ser alterada enquanto o cursor estiver aberto.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim (ou em falha, ver cursor->falhou).
+ */
+const char* trie_cursor_proximo(trie_cursor* cursor);
+
+/*
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void trie_cursor_fechar(trie_cursor* cursor);
+
+/*
+ * @brief Quantidade de faixas do histograma de alturas dos irmãos.
+ *
+ * A última faixa acumula as alturas maiores ou iguais a ela.
+ */
+#define TRIE_FAIXAS_IRMAOS 32
+
+/**
+ * @struct estatisticas_trie
+ * @brief Medidas obtidas por uma varredura completa da Trie.
+ *
+ * Um conjunto de irmãos é a árvore binária formada pelos filhos
+ * esquerdo e direito a partir de um filho do meio (ou do primeiro nó
+ * abaixo da sentinela). Sua altura é a quantidade de comparações
+ * feitas para escolher o próximo caractere naquele ponto da busca; um
+ * conjunto degenerado (altura igual ao tamanho, com 3 nós ou mais) é
+ * uma lista encadeada, típica de inserção em ordem.
+ */
+typedef struct estatisticas_trie {
+    double profundidade_media;
+    size_t profundidade_maxima;
+    double comprimento_medio;
+    size_t comprimento_maximo;
+    size_t conjuntos_irmaos;
+    size_t conjuntos_degenerados;
+    double altura_media_irmaos;
+    size_t altura_maxima_irmaos;
+    size_t histograma_irmaos[TRIE_FAIXAS_IRMAOS];
+} estatisticas_trie;
+
+/*
+ * @brief Mede a Trie percorrendo todos os seus nós.
+ *
+ * A profundidade de uma palavra é a quantidade de nós visitados para
+ * encontrá-la (ver trie_medir_caminhos) e seu comprimento é a
+ * quantidade de caracteres. histograma_irmaos[h] conta os conjuntos de
+ * irmãos de altura h.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param estatisticas Estrutura preenchida (zerada se a Trie for vazia).
+ */
+void trie_coletar_estatisticas(const no_trie* raiz,
+                               estatisticas_trie* estatisticas);
+
+/*
+ * @brief Mede o comprimento dos caminhos de busca das palavras.
+ *
+ * O comprimento de uma palavra é a quantidade de nós visitados
+ * (esquerda, direita ou meio) para encontrá-la a partir da raiz.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param media Ponteiro para o comprimento médio (0 se vazia).
+ * @param maximo Ponteiro para o maior comprimento (0 se vazia).
+ */
+void trie_medir_caminhos(const no_trie* raiz, double* media, size_t* maximo);
+
 /*
  * @brief Libera o array de palavras informado.
  *
@@ -103,12 +410,197 @@ void trie_liberar_lista(char** palavras, size_t n);
  * recursiva interna, lidando com a especificidade do nó sentinela.
  * * @note A implementação assume que a `raiz` passada é um nó sentinela
  * (dummy node) e que a árvore real começa no filho do meio (`no_meio`).
+ * @note Nós podados são devolvidos à arena informada, que deve ser a
+ * mesma usada na inserção (NULL para nós alocados no heap).
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavra String contendo a palavra a ser removida.
+ *
+ * @return true se foi removido, false se não foi.
+ */
+bool trie_remover(no_trie* raiz, arena_nos* arena, const char* palavra);
+
+/**
+ * @brief Remove uma palavra sem alterar nenhum nó já existente.
+ *
+ * Versão com cópia de caminho de trie_remover; mesmo contrato de
+ * trie_inserir_copiando.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da versão atual.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavra String contendo a palavra a ser removida.
+ * @param aposentar Função que recebe cada nó substituído.
+ * @param contexto Ponteiro repassado a 'aposentar'.
+ * @param removeu Indica se a palavra foi removida.
+ *
+ * @return Sentinela da nova versão (a própria raiz, se nada mudou) ou
+ * NULL em caso de falha de alocação.
+ */
+no_trie* trie_remover_copiando(no_trie* raiz,
+                               arena_nos* arena,
+                               const char* palavra,
+                               trie_aposentar aposentar,
+                               void* contexto,
+                               bool* removeu);
+
+/**
+ * @brief Remove um conjunto de palavras em um único percurso da Trie.
+ *
+ * As palavras devem estar em ordem crescente de strcmp (duplicatas e
+ * strings vazias são aceitas). O percurso desce ao mesmo tempo por
+ * todas as palavras que compartilham cada prefixo, visitando cada nó
+ * no máximo uma vez e podando os nós que ficam vazios.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavras Palavras ordenadas a serem removidas.
+ * @param quantidade Quantidade de palavras.
+ *
+ * @return Quantidade de palavras removidas.
+ */
+size_t trie_remover_lote(no_trie* raiz,
+                         arena_nos* arena,
+                         char* const* palavras,
+                         size_t quantidade);
+
+/**
+ * @brief Remove um conjunto de palavras sem alterar nenhum nó já
+ * existente.
+ *
+ * Versão com cópia de caminho de trie_remover_lote: cada nó alterado
+ * é copiado uma única vez, por maior que seja o lote. Mesmo contrato
+ * de trie_inserir_copiando.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da versão atual.
+ * @param arena Arena de nós utilizada (ou NULL).
+ * @param palavras Palavras ordenadas a serem removidas.
+ * @param quantidade Quantidade de palavras.
+ * @param aposentar Função que recebe cada nó substituído.
+ * @param contexto Ponteiro repassado a 'aposentar'.
+ * @param removidas Quantidade de palavras removidas.
+ *
+ * @return Sentinela da nova versão (a própria raiz, se nada mudou) ou
+ * NULL em caso de falha de alocação.
+ */
+no_trie* trie_remover_lote_copiando(no_trie* raiz,
+                                    arena_nos* arena,
+                                    char* const* palavras,
+                                    size_t quantidade,
+                                    trie_aposentar aposentar,
+                                    void* contexto,
+                                    size_t* removidas);
+
+/**
+ * @brief Remove uma palavra sem podar nenhum nó (remoção adiada).
+ *
+ * Só desmarca o terminal e atualiza os agregados do caminho; os nós
+ * que ficam sem palavras continuam na árvore até trie_compactar.
+ * Consultas, cursores e agregados não os enxergam, e reinserir a
+ * palavra reaproveita os mesmos nós. Nenhum nó é alocado ou liberado.
  *
  * @param raiz Ponteiro para a raiz (sentinela) da Trie.
  * @param palavra String contendo a palavra a ser removida.
  *
  * @return true se foi removido, false se não foi.
  */
-bool trie_remover(no_trie* raiz, const char* palavra);
+bool trie_desmarcar(no_trie* raiz, const char* palavra);
+
+/**
+ * @brief Remove um conjunto de palavras sem podar nenhum nó.
+ *
+ * Versão adiada de trie_remover_lote, nos termos de trie_desmarcar.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavras Palavras ordenadas a serem removidas.
+ * @param quantidade Quantidade de palavras.
+ *
+ * @return Quantidade de palavras removidas.
+ */
+size_t trie_desmarcar_lote(no_trie* raiz,
+                           char* const* palavras,
+                           size_t quantidade);
+
+/**
+ * @brief Copia a Trie para outra arena, descartando os nós sem palavras.
+ *
+ * Subárvores sem palavras (deixadas por trie_desmarcar) são
+ * descartadas em bloco, assim como nós que só separavam irmãos. Cada
+ * conjunto de irmãos é religado perfeitamente balanceado e os nós
+ * são alocados em sequência, em pré-ordem, ficando contíguos na nova
+ * arena. A Trie original não é alterada.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param destino Arena que recebe a cópia.
+ *
+ * @return Sentinela da cópia ou NULL em caso de falha de alocação
+ * (os nós já copiados ficam em 'destino').
+ */
+no_trie* trie_compactar(const no_trie* raiz, arena_nos* destino);
+
+/**
+ * @brief Passa a manter balanceadas as árvores de irmãos da Trie.
+ *
+ * Religa no lugar cada conjunto de irmãos (os nós de um mesmo nível
+ * ligados por esquerda e direita) como árvore perfeitamente
+ * balanceada e marca a sentinela. A partir daí, inserções e remoções
+ * (inclusive com cópia e em lote) mantêm cada conjunto balanceado com
+ * rotações de árvore AVL, de modo que, qualquer que seja a ordem de
+ * inserção, cada caractere custa no máximo 6 comparações com 26
+ * letras (e 11 com 256 valores). Não deve ser chamada enquanto houver
+ * leitores concorrentes.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ *
+ * @return true se a Trie ficou balanceada, false em falha de alocação
+ * (a Trie continua válida, sem a marca).
+ */
+bool trie_balancear(no_trie* raiz);
+
+/**
+ * @brief Recalcula os campos agregados de um nó a partir dos filhos.
+ *
+ * Necessário apenas quando os filhos de um nó são religados fora das
+ * rotinas de inserção e remoção.
+ *
+ * @param no Nó a ser atualizado.
+ */
+void trie_recalcular_agregados(no_trie* no);
+
+/**
+ * @brief Conta as palavras com o prefixo informado.
+ *
+ * Usa as contagens por subárvore, sem percorrer as palavras.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo.
+ */
+size_t trie_contar_prefixo(const no_trie* raiz, const char* prefixo);
+
+/**
+ * @brief Posição da palavra na ordem lexicográfica.
+ *
+ * Equivale à quantidade de palavras menores que a informada, que não
+ * precisa estar na Trie.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Quantidade de palavras menores que a palavra.
+ */
+size_t trie_rank(const no_trie* raiz, const char* palavra);
+
+/**
+ * @brief Retorna a k-ésima palavra (a partir de 0) em ordem lexicográfica.
+ *
+ * @param raiz Ponteiro para a raiz (sentinela) da Trie.
+ * @param k Posição da palavra.
+ *
+ * @return Cópia da palavra (liberada pelo chamador) ou NULL se k não
+ *         for menor que a quantidade de palavras ou em falha.
+ */
+char* trie_selecionar(const no_trie* raiz, size_t k);
 
 #endif
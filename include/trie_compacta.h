@@ -0,0 +1,119 @@
+#ifndef TRIE_COMPACTA_H
+#define TRIE_COMPACTA_H
+
+/**
+ * @file trie_compacta.h
+ * @brief Trie ternária compacta, com nós em um vetor contíguo.
+ *
+ * Os filhos são índices de 32 bits no vetor, em vez de ponteiros, e o
+ * nó ocupa 16 bytes (contra 40 de no_trie, que também guarda pesos e
+ * contagens). O índice 0 é a raiz sentinela, que nunca é filho de
+ * outro nó; por isso 0 também representa "sem filho".
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct no_compacto
+ * @brief Nó da Trie ternária compacta.
+ *
+ * 'caractere' e 'terminal' ocupam os mesmos 4 bytes finais.
+ */
+typedef struct no_compacto {
+    uint32_t esquerdo;
+    uint32_t meio;
+    uint32_t direito;
+    char caractere;
+    uint8_t terminal;
+    uint8_t reservado[2];
+} no_compacto;
+
+/**
+ * @struct trie_compacta
+ * @brief Vetor de nós e lista livre de nós removidos.
+ *
+ * Nós removidos são encadeados pelo campo meio a partir de 'livres'
+ * (0 = lista vazia) e reaproveitados antes de o vetor crescer.
+ */
+typedef struct trie_compacta {
+    no_compacto* nos;
+    uint32_t usados;
+    uint32_t capacidade;
+    uint32_t livres;
+    uint32_t nos_ativos;
+    size_t total_palavras;
+} trie_compacta;
+
+/**
+ * @brief Cria uma Trie compacta vazia (apenas a sentinela).
+ *
+ * @return Ponteiro para a Trie ou NULL em caso de falha.
+ */
+trie_compacta* trie_compacta_criar(void);
+
+/**
+ * @brief Libera a Trie e todos os seus nós.
+ *
+ * @param trie Trie a ser liberada (pode ser NULL).
+ */
+void trie_compacta_destruir(trie_compacta* trie);
+
+/**
+ * @brief Insere uma palavra já normalizada.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra a ser inserida.
+ *
+ * @return true se a palavra foi inserida, false se já existia ou em
+ *         falha de alocação.
+ */
+bool trie_compacta_inserir(trie_compacta* trie, const char* palavra);
+
+/**
+ * @brief Remove uma palavra, podando os nós que ficarem inúteis.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra a ser removida.
+ *
+ * @return true se a palavra foi removida, false se não existia.
+ */
+bool trie_compacta_remover(trie_compacta* trie, const char* palavra);
+
+/**
+ * @brief Verifica se a palavra está na Trie.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra está na Trie.
+ */
+bool trie_compacta_contem(const trie_compacta* trie, const char* palavra);
+
+/**
+ * @brief Busca as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_buscar_por_prefixo: palavras em ordem
+ * lexicográfica, incluindo o próprio prefixo se ele for palavra.
+ *
+ * @param trie Trie consultada.
+ * @param prefixo Prefixo já normalizado (não vazio).
+ * @param quantidade Ponteiro para indicar quantidade de palavras encontradas.
+ *
+ * @return Array de palavras encontradas (liberar com trie_liberar_lista).
+ */
+char** trie_compacta_buscar_por_prefixo(const trie_compacta* trie,
+                                        const char* prefixo,
+                                        size_t* quantidade);
+
+/**
+ * @brief Bytes reservados pelo vetor de nós.
+ *
+ * @param trie Trie consultada.
+ *
+ * @return Capacidade do vetor em bytes.
+ */
+size_t trie_compacta_bytes_reservados(const trie_compacta* trie);
+
+#endif
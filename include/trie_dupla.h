@@ -0,0 +1,296 @@
+#ifndef TRIE_DUPLA_H
+#define TRIE_DUPLA_H
+
+/**
+ * @file trie_dupla.h
+ * @brief Trie de vetor duplo (double-array) sobre o alfabeto a–z.
+ *
+ * Cada estado é uma posição dos vetores. O filho de s pela letra de
+ * código c (1 a 26) fica na posição base[s] + c e pertence a s se
+ * verificacao[base[s] + c] == s: um acesso por caractere, sem
+ * comparações entre irmãos. O estado 0 é a raiz.
+ *
+ * Posições livres formam uma lista circular duplamente encadeada
+ * guardada nos próprios campos (valores negativos). Quando a posição
+ * de um novo filho já está ocupada, todos os filhos do estado são
+ * realocados para uma base em que caibam.
+ */
+
+#include "trie.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRIE_DUPLA_LETRAS 26
+
+/**
+ * @struct celula_dupla
+ * @brief Par base/verificação de um estado (8 bytes).
+ *
+ * Em uma posição livre, os dois campos guardam, negativos, a próxima
+ * e a anterior posição livre.
+ */
+typedef struct celula_dupla {
+    int32_t base;
+    int32_t verificacao;
+} celula_dupla;
+
+/**
+ * @struct info_dupla
+ * @brief Dados de um estado, fora do caminho quente da descida.
+ *
+ * Mesmo significado dos campos de no_trie, mas 'contagem' e
+ * 'peso_maximo' se referem apenas às palavras abaixo do estado
+ * (inclusive a dele). 'filhos' indica se 'base' já foi definida.
+ */
+typedef struct info_dupla {
+    uint32_t peso;
+    uint32_t peso_maximo;
+    uint32_t contagem;
+    uint8_t filhos;
+    bool terminal;
+    uint8_t reservado[2];
+} info_dupla;
+
+/**
+ * @struct trie_dupla
+ * @brief Vetores de estados e lista de posições livres.
+ *
+ * 'livre' é o início da lista de livres (-1 se vazia) e 'busca' a
+ * posição a partir da qual conjuntos de vários filhos são procurados.
+ */
+typedef struct trie_dupla {
+    celula_dupla* celulas;
+    info_dupla* infos;
+    size_t capacidade;
+    size_t busca;
+    int32_t livre;
+    size_t estados;
+    size_t total_palavras;
+} trie_dupla;
+
+/**
+ * @struct trie_dupla_quadro
+ * @brief Quadro da pilha do cursor: estado e próximo código a visitar.
+ */
+typedef struct trie_dupla_quadro {
+    int32_t estado;
+    uint8_t proximo;
+    size_t profundidade;
+} trie_dupla_quadro;
+
+/**
+ * @struct trie_dupla_cursor
+ * @brief Cursor de percurso em ordem lexicográfica.
+ *
+ * Mesmo comportamento de trie_cursor.
+ */
+typedef struct trie_dupla_cursor {
+    const trie_dupla* trie;
+    trie_dupla_quadro* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    char* buffer;
+    size_t capacidade_buffer;
+    bool prefixo_pendente;
+    bool falhou;
+} trie_dupla_cursor;
+
+/**
+ * @brief Cria uma Trie de vetor duplo vazia (apenas a raiz).
+ *
+ * @return Ponteiro para a Trie ou NULL em caso de falha.
+ */
+trie_dupla* trie_dupla_criar(void);
+
+/**
+ * @brief Libera a Trie.
+ *
+ * @param trie Trie a ser liberada (pode ser NULL).
+ */
+void trie_dupla_destruir(trie_dupla* trie);
+
+/**
+ * @brief Insere a palavra, gravando o peso se informado.
+ *
+ * Se a palavra já existir, apenas o seu peso é atualizado (quando
+ * 'peso' não for NULL). Palavras com caracteres fora de a–z não são
+ * inseridas.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra já normalizada.
+ * @param peso Peso da palavra (ou NULL).
+ *
+ * @return true se a palavra foi inserida, false se já existia ou em
+ *         falha.
+ */
+bool trie_dupla_inserir(trie_dupla* trie,
+                        const char* palavra,
+                        const uint32_t* peso);
+
+/**
+ * @brief Remove a palavra, liberando os estados que ficarem sem uso.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra foi removida, false se não existia.
+ */
+bool trie_dupla_remover(trie_dupla* trie, const char* palavra);
+
+/**
+ * @brief Verifica se a palavra está na Trie.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra está na Trie.
+ */
+bool trie_dupla_contem(const trie_dupla* trie, const char* palavra);
+
+/**
+ * @brief Peso da palavra.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Peso da palavra (0 se ela não estiver na Trie).
+ */
+uint32_t trie_dupla_peso(const trie_dupla* trie, const char* palavra);
+
+/**
+ * @brief Busca as k palavras de maior peso com o prefixo.
+ *
+ * Mesmo contrato de trie_buscar_por_prefixo_ranqueado.
+ *
+ * @param trie Trie consultada.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ * @param k Quantidade máxima de palavras.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem decrescente de peso.
+ */
+char** trie_dupla_buscar_por_prefixo_ranqueado(const trie_dupla* trie,
+                                               const char* prefixo,
+                                               size_t k,
+                                               size_t* quantidade);
+
+/**
+ * @brief Busca as palavras a no máximo 'max_distancia' edições.
+ *
+ * Mesmo contrato de trie_buscar_aproximado.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ * @param max_distancia Maior distância de edição aceita.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem lexicográfica.
+ */
+char** trie_dupla_buscar_aproximado(const trie_dupla* trie,
+                                    const char* palavra,
+                                    size_t max_distancia,
+                                    size_t* quantidade);
+
+/**
+ * @brief Busca as palavras que casam com o padrão.
+ *
+ * Mesmo contrato de trie_buscar_padrao.
+ *
+ * @param trie Trie consultada.
+ * @param padrao Padrão já normalizado.
+ * @param quantidade Ponteiro para indicar quantidade de palavras.
+ *
+ * @return Array de palavras em ordem lexicográfica.
+ */
+char** trie_dupla_buscar_padrao(const trie_dupla* trie,
+                                const char* padrao,
+                                size_t* quantidade);
+
+/**
+ * @brief Conta as palavras com o prefixo informado.
+ *
+ * @param trie Trie consultada.
+ * @param prefixo Prefixo já normalizado (NULL ou vazio = todas).
+ *
+ * @return Quantidade de palavras com o prefixo.
+ */
+size_t trie_dupla_contar_prefixo(const trie_dupla* trie, const char* prefixo);
+
+/**
+ * @brief Posição da palavra na ordem lexicográfica.
+ *
+ * Mesmo contrato de trie_rank.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Quantidade de palavras menores que a palavra.
+ */
+size_t trie_dupla_rank(const trie_dupla* trie, const char* palavra);
+
+/**
+ * @brief Retorna a k-ésima palavra (a partir de 0) em ordem lexicográfica.
+ *
+ * @param trie Trie consultada.
+ * @param k Posição da palavra.
+ *
+ * @return Cópia da palavra (liberada pelo chamador) ou NULL.
+ */
+char* trie_dupla_selecionar(const trie_dupla* trie, size_t k);
+
+/**
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_cursor_abrir.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param trie Trie consultada.
+ * @param prefixo String do prefixo (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool trie_dupla_cursor_abrir(trie_dupla_cursor* cursor,
+                             const trie_dupla* trie,
+                             const char* prefixo);
+
+/**
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim (ou em falha).
+ */
+const char* trie_dupla_cursor_proximo(trie_dupla_cursor* cursor);
+
+/**
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void trie_dupla_cursor_fechar(trie_dupla_cursor* cursor);
+
+/**
+ * @brief Mede a Trie percorrendo todos os seus estados.
+ *
+ * Cada caractere custa um único acesso: a profundidade de uma palavra
+ * é o seu comprimento e todo estado com filhos conta como um conjunto
+ * de irmãos de altura 1.
+ *
+ * @param trie Trie consultada.
+ * @param estatisticas Estrutura preenchida (zerada se a Trie for vazia).
+ */
+void trie_dupla_coletar_estatisticas(const trie_dupla* trie,
+                                     estatisticas_trie* estatisticas);
+
+/**
+ * @brief Bytes reservados pelos vetores.
+ *
+ * @param trie Trie consultada.
+ *
+ * @return Total de bytes dos dois vetores, inclusive posições livres.
+ */
+size_t trie_dupla_bytes_reservados(const trie_dupla* trie);
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef TRIE_RAJADA_H
+#define TRIE_RAJADA_H
+
+/**
+ * @file trie_rajada.h
+ * @brief Trie de rajada (burst trie) com recipientes de hash em vetor.
+ *
+ * Os primeiros caracteres das palavras são consumidos por nós com um
+ * filho por letra (a–z). Abaixo deles, os sufixos ficam em recipientes:
+ * tabelas de hash cujos baldes são vetores contíguos de entradas
+ * (tamanho, sufixo e peso), percorridos sem seguir ponteiros. Quando
+ * um recipiente passa de TRIE_RAJADA_LIMITE palavras, ele "estoura":
+ * é trocado por um nó e seus sufixos são distribuídos, pelo primeiro
+ * caractere, em novos recipientes.
+ *
+ * Os recipientes não guardam ordem; o cursor ordena os sufixos de um
+ * recipiente ao chegar nele.
+ */
+
+#include "trie.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRIE_RAJADA_LETRAS 26
+#define TRIE_RAJADA_BALDES 32
+#define TRIE_RAJADA_LIMITE 512
+
+/**
+ * @struct balde_rajada
+ * @brief Vetor de entradas de um balde de recipiente.
+ *
+ * Cada entrada ocupa 2 bytes de tamanho, o sufixo (sem terminador) e
+ * 4 bytes de peso, sem alinhamento. 'usados' e 'capacidade' contam
+ * bytes de 'dados'.
+ */
+typedef struct balde_rajada {
+    uint32_t usados;
+    uint32_t capacidade;
+    char dados[];
+} balde_rajada;
+
+/**
+ * @struct recipiente_rajada
+ * @brief Tabela de hash de sufixos (baldes NULL estão vazios).
+ *
+ * Um sufixo vazio representa a palavra que termina exatamente no nó
+ * pai do recipiente.
+ */
+typedef struct recipiente_rajada {
+    uint32_t palavras;
+    balde_rajada* baldes[TRIE_RAJADA_BALDES];
+} recipiente_rajada;
+
+/**
+ * @struct no_rajada
+ * @brief Nó de acesso: um filho por letra.
+ *
+ * O bit c - 1 de 'recipientes' indica que filhos[c - 1] é um
+ * recipiente_rajada; do contrário, é um no_rajada (ou NULL). 'terminal'
+ * e 'peso' descrevem a palavra que termina no próprio nó.
+ */
+typedef struct no_rajada {
+    void* filhos[TRIE_RAJADA_LETRAS];
+    uint32_t recipientes;
+    uint32_t peso;
+    bool terminal;
+} no_rajada;
+
+/**
+ * @struct trie_rajada
+ * @brief Raiz e contadores de ocupação.
+ *
+ * 'bytes_baldes' soma os bytes de entradas de todos os baldes e
+ * 'capacidade_baldes' os bytes alocados para eles (com cabeçalhos).
+ */
+typedef struct trie_rajada {
+    no_rajada* raiz;
+    size_t total_palavras;
+    size_t nos;
+    size_t total_recipientes;
+    size_t bytes_baldes;
+    size_t capacidade_baldes;
+} trie_rajada;
+
+/**
+ * @struct trie_rajada_quadro
+ * @brief Quadro da pilha do cursor: nó e próximo código a visitar.
+ *
+ * O código 0 indica que a palavra do próprio nó ainda não foi
+ * considerada.
+ */
+typedef struct trie_rajada_quadro {
+    const no_rajada* no;
+    uint8_t proximo;
+    size_t profundidade;
+} trie_rajada_quadro;
+
+/**
+ * @struct trie_rajada_cursor
+ * @brief Cursor de percurso em ordem lexicográfica.
+ *
+ * 'entradas' guarda, ordenadas, as entradas do recipiente sendo
+ * percorrido, cujos sufixos são escritos no buffer a partir de
+ * 'profundidade_recipiente'. Mesmo comportamento de trie_cursor.
+ */
+typedef struct trie_rajada_cursor {
+    trie_rajada_quadro* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    const char** entradas;
+    size_t total_entradas;
+    size_t proxima_entrada;
+    size_t capacidade_entradas;
+    size_t profundidade_recipiente;
+    char* buffer;
+    size_t capacidade_buffer;
+    bool falhou;
+} trie_rajada_cursor;
+
+/**
+ * @brief Cria uma Trie de rajada vazia (apenas o nó raiz).
+ *
+ * @return Ponteiro para a Trie ou NULL em caso de falha.
+ */
+trie_rajada* trie_rajada_criar(void);
+
+/**
+ * @brief Libera a Trie, seus nós e recipientes.
+ *
+ * @param trie Trie a ser liberada (pode ser NULL).
+ */
+void trie_rajada_destruir(trie_rajada* trie);
+
+/**
+ * @brief Insere a palavra, gravando o peso se informado.
+ *
+ * Mesmo contrato de trie_dupla_inserir. Se o recipiente estourar e a
+ * troca por um nó falhar, a palavra continua inserida no recipiente.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra já normalizada.
+ * @param peso Peso da palavra (ou NULL).
+ *
+ * @return true se a palavra foi inserida, false se já existia ou em
+ *         falha.
+ */
+bool trie_rajada_inserir(trie_rajada* trie,
+                         const char* palavra,
+                         const uint32_t* peso);
+
+/**
+ * @brief Remove a palavra.
+ *
+ * Recipientes que ficam vazios são liberados; nós de acesso são
+ * mantidos.
+ *
+ * @param trie Trie utilizada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra foi removida, false se não existia.
+ */
+bool trie_rajada_remover(trie_rajada* trie, const char* palavra);
+
+/**
+ * @brief Verifica se a palavra está na Trie.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return true se a palavra está na Trie.
+ */
+bool trie_rajada_contem(const trie_rajada* trie, const char* palavra);
+
+/**
+ * @brief Peso da palavra.
+ *
+ * @param trie Trie consultada.
+ * @param palavra Palavra já normalizada.
+ *
+ * @return Peso da palavra (0 se ela não estiver na Trie).
+ */
+uint32_t trie_rajada_peso(const trie_rajada* trie, const char* palavra);
+
+/**
+ * @brief Abre um cursor sobre as palavras com o prefixo informado.
+ *
+ * Mesmo contrato de trie_cursor_abrir.
+ *
+ * @param cursor Cursor a ser inicializado (alocado pelo chamador).
+ * @param trie Trie consultada.
+ * @param prefixo String do prefixo (ou NULL).
+ *
+ * @return true se o cursor foi aberto, false em caso de falha de alocação.
+ */
+bool trie_rajada_cursor_abrir(trie_rajada_cursor* cursor,
+                              const trie_rajada* trie,
+                              const char* prefixo);
+
+/**
+ * @brief Avança o cursor para a próxima palavra.
+ *
+ * @param cursor Cursor utilizado.
+ *
+ * @return Próxima palavra ou NULL ao fim (ou em falha).
+ */
+const char* trie_rajada_cursor_proximo(trie_rajada_cursor* cursor);
+
+/**
+ * @brief Libera os recursos internos do cursor.
+ *
+ * @param cursor Cursor a ser fechado.
+ */
+void trie_rajada_cursor_fechar(trie_rajada_cursor* cursor);
+
+/**
+ * @brief Mede a Trie percorrendo todos os seus nós e recipientes.
+ *
+ * A profundidade de uma palavra é a quantidade de nós de acesso
+ * descidos abaixo da raiz, mais 1 se ela estiver em um recipiente.
+ * Não há conjuntos de irmãos.
+ *
+ * @param trie Trie consultada.
+ * @param estatisticas Estrutura preenchida (zerada se a Trie for vazia).
+ */
+void trie_rajada_coletar_estatisticas(const trie_rajada* trie,
+                                      estatisticas_trie* estatisticas);
+
+/**
+ * @brief Bytes ocupados por nós, recipientes e entradas.
+ *
+ * @param trie Trie consultada.
+ *
+ * @return Total de bytes em uso.
+ */
+size_t trie_rajada_bytes_usados(const trie_rajada* trie);
+
+/**
+ * @brief Bytes reservados por nós, recipientes e baldes.
+ *
+ * @param trie Trie consultada.
+ *
+ * @return Total de bytes, inclusive a folga dos baldes.
+ */
+size_t trie_rajada_bytes_reservados(const trie_rajada* trie);
+
+#endif
@@ -6,6 +6,32 @@
  * @brief Definição das funções auxiliares.
  */
 
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct lista_palavras
+ * @brief Array dinâmico de strings.
+ *
+ * Armazena o array de strings de forma dinâmica,
+ * sempre atualizando a capacidade e tamanho.
+ */
+typedef struct {
+    char** palavras;
+    size_t tamanho;
+    size_t capacidade;
+} lista_palavras;
+
+/**
+ * @brief Adiciona uma cópia da palavra ao final da lista.
+ *
+ * @param l Lista utilizada (inicialmente zerada).
+ * @param palavra Palavra a ser copiada.
+ *
+ * @return true se foi adicionada, false em caso de falha de alocação.
+ */
+bool lista_push(lista_palavras* l, const char* palavra);
+
 /**
  * @brief Verifica se a palavra informada é válida.
  *
@@ -31,6 +57,23 @@ void trim(char* str);
  */
 void string_para_minusculo(char* str);
 
+/*
+ * @brief Normaliza um trecho de texto em uma única passada.
+ *
+ * Equivale a copiar o trecho e aplicar trim, string_para_minusculo e
+ * palavra_valida, sem alocar memória. O trecho não precisa terminar
+ * em '\0'; destino deve ter espaço para tamanho + 1 bytes. As letras
+ * passam pelo núcleo vetorizado de normalizacao.h. Palavras com mais
+ * de NORMALIZACAO_MAX_LETRAS letras são inválidas.
+ *
+ * @param trecho Início do texto (não precisa ser terminado em '\0').
+ * @param tamanho Quantidade de bytes do trecho.
+ * @param destino Buffer que recebe a palavra normalizada.
+ *
+ * @return 1 se a palavra normalizada for válida ou 0 se for inválida.
+ */
+int normalizar_trecho(const char* trecho, size_t tamanho, char* destino);
+
 /*
  * @brief Duplica string informada e retorna cópia
  *
@@ -40,4 +83,15 @@ void string_para_minusculo(char* str);
  */
 char* string_dup(const char* s);
 
+/**
+ * @brief Garante que o buffer comporte ao menos 'necessario' bytes.
+ *
+ * @param buf Ponteiro para o buffer (realocado se necessário).
+ * @param cap Ponteiro para a capacidade atual do buffer.
+ * @param necessario Quantidade de bytes necessária.
+ *
+ * @return true se o buffer comporta o tamanho, false em falha de alocação.
+ */
+bool garantir_tamanho_buffer(char** buf, size_t* cap, size_t necessario);
+
 #endif
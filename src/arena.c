@@ -0,0 +1,177 @@
+/**
+ * @file arena.c
+ * @brief Implementação do alocador em blocos para nós da Trie.
+ */
+
+#include "arena.h"
+
+#include "trie.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NOS_POR_BLOCO_PADRAO 4096
+
+/**
+ * @struct bloco_arena
+ * @brief Bloco contíguo de nós reservado de uma só vez.
+ *
+ * Os blocos formam uma lista encadeada; novos nós são servidos
+ * apenas do primeiro bloco da lista.
+ */
+struct bloco_arena {
+    struct bloco_arena* proximo;
+    size_t usados;
+    size_t capacidade;
+    no_trie nos[];
+};
+
+/*
+ * Implementação:
+ * - Reserva um bloco com capacidade para 'capacidade' nós.
+ * - Os nós não são zerados aqui; isso ocorre na entrega de cada nó.
+ */
+static bloco_arena* bloco_criar(size_t capacidade) {
+    bloco_arena* bloco =
+        malloc(sizeof *bloco + (capacidade * sizeof(no_trie)));
+    if (!bloco) {
+        return NULL;
+    }
+
+    bloco->proximo = NULL;
+    bloco->usados = 0;
+    bloco->capacidade = capacidade;
+    return bloco;
+}
+
+/*
+ * Implementação:
+ * - Apenas inicializa os campos; o primeiro bloco é criado sob demanda.
+ */
+arena_nos* arena_criar(size_t nos_por_bloco) {
+    arena_nos* arena = calloc(1, sizeof *arena);
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->nos_por_bloco = nos_por_bloco ? nos_por_bloco : NOS_POR_BLOCO_PADRAO;
+    return arena;
+}
+
+/*
+ * Implementação:
+ * - Libera bloco a bloco, sem percorrer os nós individualmente.
+ */
+void arena_destruir(arena_nos* arena) {
+    if (!arena) {
+        return;
+    }
+
+    bloco_arena* bloco = arena->blocos;
+    while (bloco) {
+        bloco_arena* proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+
+    free(arena);
+}
+
+/*
+ * Implementação:
+ * - Reaproveita primeiro um nó da lista livre.
+ * - Do contrário, entrega o próximo nó do bloco atual,
+ *   criando um novo bloco quando o atual estiver cheio.
+ * - O nó entregue é sempre zerado.
+ */
+no_trie* arena_alocar_no(arena_nos* arena) {
+    no_trie* no = NULL;
+
+    if (arena->livres) {
+        no = arena->livres;
+        arena->livres = no->no_meio;
+    } else {
+        bloco_arena* bloco = arena->blocos;
+        if (!bloco || bloco->usados == bloco->capacidade) {
+            bloco = bloco_criar(arena->nos_por_bloco);
+            if (!bloco) {
+                return NULL;
+            }
+            bloco->proximo = arena->blocos;
+            arena->blocos = bloco;
+        }
+        no = &bloco->nos[bloco->usados++];
+    }
+
+    memset(no, 0, sizeof *no);
+    arena->nos_ativos++;
+    return no;
+}
+
+/*
+ * Implementação:
+ * - Empilha o nó na lista livre usando o campo no_meio como ligação.
+ */
+void arena_liberar_no(arena_nos* arena, no_trie* no) {
+    if (!no) {
+        return;
+    }
+
+    no->no_meio = arena->livres;
+    arena->livres = no;
+    arena->nos_ativos--;
+}
+
+/*
+ * Implementação:
+ * - Encadeia os blocos de origem logo após o primeiro bloco de
+ *   destino, que continua sendo o bloco de onde novos nós saem.
+ * - Concatena as listas livres.
+ */
+void arena_absorver(arena_nos* destino, arena_nos* origem) {
+    if (!destino || !origem || destino == origem) {
+        return;
+    }
+
+    if (origem->blocos) {
+        bloco_arena* ultimo = origem->blocos;
+        while (ultimo->proximo) {
+            ultimo = ultimo->proximo;
+        }
+
+        if (destino->blocos) {
+            ultimo->proximo = destino->blocos->proximo;
+            destino->blocos->proximo = origem->blocos;
+        } else {
+            destino->blocos = origem->blocos;
+        }
+    }
+
+    if (origem->livres) {
+        no_trie* ultimo_livre = origem->livres;
+        while (ultimo_livre->no_meio) {
+            ultimo_livre = ultimo_livre->no_meio;
+        }
+        ultimo_livre->no_meio = destino->livres;
+        destino->livres = origem->livres;
+    }
+
+    destino->nos_ativos += origem->nos_ativos;
+    origem->blocos = NULL;
+    origem->livres = NULL;
+    origem->nos_ativos = 0;
+}
+
+/*
+ * Implementação:
+ * - Soma a capacidade de todos os blocos.
+ */
+size_t arena_bytes_reservados(const arena_nos* arena) {
+    size_t total = 0;
+
+    for (const bloco_arena* b = arena->blocos; b; b = b->proximo) {
+        total += sizeof *b + (b->capacidade * sizeof(no_trie));
+    }
+
+    return total;
+}
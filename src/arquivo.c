@@ -0,0 +1,200 @@
+/**
+ * @file arquivo.c
+ * @brief Implementação do mapeamento de arquivos em memória e da
+ * gravação durável.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "arquivo.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+
+/*
+ * Implementação:
+ * - Sem mmap disponível, lê o arquivo inteiro para um único buffer.
+ * - O padrão de acesso é ignorado.
+ */
+bool arquivo_mapear(const char* caminho,
+                    bool sequencial,
+                    arquivo_mapeado* arquivo) {
+    (void) sequencial;
+    *arquivo = (arquivo_mapeado){0};
+
+    FILE* f = fopen(caminho, "rb");
+    if (!f) {
+        return false;
+    }
+
+    if (fseek(f, 0, SEEK_END) != 0) {
+        fclose(f);
+        return false;
+    }
+    long tamanho = ftell(f);
+    rewind(f);
+
+    if (tamanho <= 0) {
+        fclose(f);
+        return tamanho == 0;
+    }
+
+    char* dados = malloc((size_t) tamanho);
+    if (!dados || fread(dados, 1, (size_t) tamanho, f) != (size_t) tamanho) {
+        free(dados);
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+
+    arquivo->dados = dados;
+    arquivo->tamanho = (size_t) tamanho;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Libera o buffer lido por arquivo_mapear.
+ */
+void arquivo_desmapear(arquivo_mapeado* arquivo) {
+    free((void*) arquivo->dados);
+    *arquivo = (arquivo_mapeado){0};
+}
+
+/*
+ * Implementação:
+ * - fflush e _commit, que grava o arquivo no disco.
+ */
+bool arquivo_sincronizar(FILE* arquivo) {
+    return fflush(arquivo) == 0 && _commit(_fileno(arquivo)) == 0;
+}
+
+/*
+ * Implementação:
+ * - fflush e _chsize_s sobre o descritor.
+ */
+bool arquivo_cortar(FILE* arquivo, size_t tamanho) {
+    return fflush(arquivo) == 0 &&
+           _chsize_s(_fileno(arquivo), (long long) tamanho) == 0;
+}
+
+/*
+ * Implementação:
+ * - Diretórios não podem ser sincronizados; a troca de nome já é
+ *   gravada pelo sistema de arquivos.
+ */
+bool arquivo_sincronizar_diretorio(const char* caminho) {
+    (void) caminho;
+    return true;
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Implementação:
+ * - Mapeia o arquivo como privado e somente leitura.
+ * - Indica ao kernel o padrão de acesso (sequencial ou aleatório).
+ * - O descritor é fechado logo após o mapeamento.
+ */
+bool arquivo_mapear(const char* caminho,
+                    bool sequencial,
+                    arquivo_mapeado* arquivo) {
+    *arquivo = (arquivo_mapeado){0};
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    if (info.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* dados =
+        mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) {
+        return false;
+    }
+
+    posix_madvise(dados,
+                  (size_t) info.st_size,
+                  sequencial ? POSIX_MADV_SEQUENTIAL : POSIX_MADV_RANDOM);
+
+    arquivo->dados = dados;
+    arquivo->tamanho = (size_t) info.st_size;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Desfaz o mapeamento, se houver.
+ */
+void arquivo_desmapear(arquivo_mapeado* arquivo) {
+    if (arquivo->dados) {
+        munmap((void*) arquivo->dados, arquivo->tamanho);
+    }
+    *arquivo = (arquivo_mapeado){0};
+}
+
+/*
+ * Implementação:
+ * - fflush e fdatasync: os metadados que não afetam a leitura (como
+ *   a data de modificação) não precisam ir para o disco.
+ */
+bool arquivo_sincronizar(FILE* arquivo) {
+    return fflush(arquivo) == 0 && fdatasync(fileno(arquivo)) == 0;
+}
+
+/*
+ * Implementação:
+ * - fflush e ftruncate sobre o descritor.
+ */
+bool arquivo_cortar(FILE* arquivo, size_t tamanho) {
+    return fflush(arquivo) == 0 &&
+           ftruncate(fileno(arquivo), (off_t) tamanho) == 0;
+}
+
+/*
+ * Implementação:
+ * - Abre o diretório do caminho (o corrente, se não houver '/') e
+ *   chama fsync sobre ele.
+ */
+bool arquivo_sincronizar_diretorio(const char* caminho) {
+    const char* barra = strrchr(caminho, '/');
+    size_t tamanho = 1;
+    if (barra && barra != caminho) {
+        tamanho = (size_t) (barra - caminho);
+    }
+
+    char* diretorio = malloc(tamanho + 1);
+    if (!diretorio) {
+        return false;
+    }
+    memcpy(diretorio, barra ? caminho : ".", tamanho);
+    diretorio[tamanho] = '\0';
+
+    int fd = open(diretorio, O_RDONLY);
+    free(diretorio);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+#endif
@@ -0,0 +1,761 @@
+/**
+ * @file dawg.c
+ * @brief Implementação do autômato mínimo de palavras.
+ */
+
+#include "dawg.h"
+
+#include "distancia.h"
+#include "padrao.h"
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_INICIAL_TABELA 1024
+
+/**
+ * @struct pendente_dawg
+ * @brief Transição de um estado ainda em construção.
+ */
+typedef struct {
+    const no_trie* meio;
+    uint32_t destino;
+    char caractere;
+    uint8_t terminal;
+} pendente_dawg;
+
+/**
+ * @struct construtor_dawg
+ * @brief Estado da construção.
+ *
+ * 'pilha' guarda as transições dos estados em construção, um trecho
+ * por nível da recursão. 'tabela' é o registro de estados (endereçamento
+ * aberto, 0 = vaga livre), usado para encontrar estados iguais.
+ */
+typedef struct {
+    transicao_dawg* transicoes;
+    size_t total;
+    size_t capacidade;
+    pendente_dawg* pilha;
+    size_t topo;
+    size_t capacidade_pilha;
+    uint32_t* tabela;
+    size_t capacidade_tabela;
+    size_t estados;
+    bool falhou;
+} construtor_dawg;
+
+/*
+ * Implementação:
+ * - Combina uma transição ao hash (FNV-1a sobre os três campos).
+ */
+static uint64_t misturar(uint64_t hash,
+                         char caractere,
+                         uint8_t terminal,
+                         uint32_t destino) {
+    uint64_t campos[] = {(unsigned char) caractere, terminal, destino};
+    for (size_t i = 0; i < 3; i++) {
+        hash ^= campos[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/*
+ * Implementação:
+ * - Hash das transições de um estado já registrado.
+ */
+static uint64_t hash_estado(const transicao_dawg* t) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    do {
+        hash = misturar(
+            hash, t->caractere, t->marcas & DAWG_TERMINAL, t->destino);
+    } while (!((t++)->marcas & DAWG_ULTIMA));
+    return hash;
+}
+
+/*
+ * Implementação:
+ * - Hash das transições pendentes [inicio, fim), igual ao de
+ *   hash_estado para as mesmas transições.
+ */
+static uint64_t
+hash_pendentes(const construtor_dawg* c, size_t inicio, size_t fim) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = inicio; i < fim; i++) {
+        const pendente_dawg* p = &c->pilha[i];
+        hash = misturar(hash, p->caractere, p->terminal, p->destino);
+    }
+    return hash;
+}
+
+/*
+ * Implementação:
+ * - Compara as transições pendentes com as do estado registrado.
+ */
+static bool estado_igual(const construtor_dawg* c,
+                         uint32_t estado,
+                         size_t inicio,
+                         size_t fim) {
+    const transicao_dawg* t = &c->transicoes[estado];
+    for (size_t i = inicio; i < fim; i++, t++) {
+        const pendente_dawg* p = &c->pilha[i];
+        bool ultima = i + 1 == fim;
+        if (t->caractere != p->caractere || t->destino != p->destino ||
+            (t->marcas & DAWG_TERMINAL) != p->terminal ||
+            ((t->marcas & DAWG_ULTIMA) != 0) != ultima) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Insere o estado na tabela por sondagem linear.
+ */
+static void tabela_inserir(uint32_t* tabela,
+                           size_t capacidade,
+                           uint64_t hash,
+                           uint32_t estado) {
+    size_t i = hash & (capacidade - 1);
+    while (tabela[i]) {
+        i = (i + 1) & (capacidade - 1);
+    }
+    tabela[i] = estado;
+}
+
+/*
+ * Implementação:
+ * - Dobra a tabela quando metade das vagas estiver ocupada,
+ *   recalculando o hash de cada estado registrado.
+ */
+static bool tabela_garantir(construtor_dawg* c) {
+    if (c->capacidade_tabela && (c->estados + 1) * 2 <= c->capacidade_tabela) {
+        return true;
+    }
+
+    size_t nova_cap = c->capacidade_tabela ? c->capacidade_tabela * 2
+                                           : CAPACIDADE_INICIAL_TABELA;
+    uint32_t* nova = calloc(nova_cap, sizeof *nova);
+    if (!nova) {
+        return false;
+    }
+
+    for (size_t i = 0; i < c->capacidade_tabela; i++) {
+        uint32_t estado = c->tabela[i];
+        if (estado) {
+            tabela_inserir(nova,
+                           nova_cap,
+                           hash_estado(&c->transicoes[estado]),
+                           estado);
+        }
+    }
+
+    free(c->tabela);
+    c->tabela = nova;
+    c->capacidade_tabela = nova_cap;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Procura um estado igual às transições pendentes [inicio, fim).
+ * - Se não houver, copia as transições para o vetor final (marcando a
+ *   última) e registra o novo estado.
+ * - Retorna 0 em falha.
+ */
+static uint32_t registrar(construtor_dawg* c, size_t inicio, size_t fim) {
+    if (!tabela_garantir(c)) {
+        c->falhou = true;
+        return 0;
+    }
+
+    uint64_t hash = hash_pendentes(c, inicio, fim);
+    size_t i = hash & (c->capacidade_tabela - 1);
+    while (c->tabela[i]) {
+        if (estado_igual(c, c->tabela[i], inicio, fim)) {
+            return c->tabela[i];
+        }
+        i = (i + 1) & (c->capacidade_tabela - 1);
+    }
+
+    size_t quantidade = fim - inicio;
+    if (c->total + quantidade > UINT32_MAX) {
+        c->falhou = true;
+        return 0;
+    }
+    if (c->total + quantidade > c->capacidade) {
+        size_t nova_cap = c->capacidade ? c->capacidade * 2 : 1024;
+        while (nova_cap < c->total + quantidade) {
+            nova_cap *= 2;
+        }
+        transicao_dawg* tmp = realloc(c->transicoes, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            c->falhou = true;
+            return 0;
+        }
+        c->transicoes = tmp;
+        c->capacidade = nova_cap;
+    }
+
+    uint32_t estado = (uint32_t) c->total;
+    for (size_t j = inicio; j < fim; j++) {
+        const pendente_dawg* p = &c->pilha[j];
+        c->transicoes[c->total++] = (transicao_dawg){
+            .destino = p->destino,
+            .caractere = p->caractere,
+            .marcas = (uint8_t) (p->terminal |
+                                 (j + 1 == fim ? DAWG_ULTIMA : 0)),
+        };
+    }
+
+    c->tabela[i] = estado;
+    c->estados++;
+    return estado;
+}
+
+/*
+ * Implementação:
+ * - Empilha os irmãos em ordem (esquerda, nó, direita), de modo que as
+ *   transições do estado fiquem em ordem de caractere.
+ */
+static void empilhar_irmaos(construtor_dawg* c, const no_trie* no) {
+    while (no && !c->falhou) {
+        empilhar_irmaos(c, no->no_esquerdo);
+        if (c->falhou) {
+            return;
+        }
+
+        if (c->topo == c->capacidade_pilha) {
+            size_t nova_cap =
+                c->capacidade_pilha ? c->capacidade_pilha * 2 : 256;
+            pendente_dawg* tmp = realloc(c->pilha, nova_cap * sizeof *tmp);
+            if (!tmp) {
+                c->falhou = true;
+                return;
+            }
+            c->pilha = tmp;
+            c->capacidade_pilha = nova_cap;
+        }
+
+        c->pilha[c->topo++] = (pendente_dawg){
+            .meio = no->no_meio,
+            .caractere = no->caractere,
+            .terminal = no->terminal ? DAWG_TERMINAL : 0,
+        };
+        no = no->no_direito;
+    }
+}
+
+/*
+ * Implementação:
+ * - Um nível da Trie (o conjunto de irmãos a partir de 'primeiro')
+ *   vira um estado.
+ * - Constrói antes os destinos de cada transição (subárvores do meio)
+ *   e só então registra o estado. A pilha é acessada por índice, pois
+ *   pode ser realocada pelos níveis de baixo.
+ */
+static uint32_t construir_estado(construtor_dawg* c, const no_trie* primeiro) {
+    if (!primeiro || c->falhou) {
+        return 0;
+    }
+
+    size_t inicio = c->topo;
+    empilhar_irmaos(c, primeiro);
+    size_t fim = c->topo;
+
+    for (size_t i = inicio; i < fim && !c->falhou; i++) {
+        uint32_t destino = construir_estado(c, c->pilha[i].meio);
+        c->pilha[i].destino = destino;
+    }
+
+    uint32_t estado = c->falhou ? 0 : registrar(c, inicio, fim);
+    c->topo = inicio;
+    return estado;
+}
+
+/*
+ * Implementação:
+ * - Soma as contagens das transições do estado (0 se não houver).
+ */
+static size_t contagem_estado(const dawg* dawg, uint32_t estado) {
+    size_t total = 0;
+    for (uint32_t i = estado; estado; i++) {
+        total += dawg->contagens[i];
+        if (dawg->transicoes[i].marcas & DAWG_ULTIMA) {
+            break;
+        }
+    }
+    return total;
+}
+
+/*
+ * Implementação:
+ * - Um estado só é registrado depois de seus destinos, então toda
+ *   transição aponta para índices menores que o seu: uma passagem em
+ *   ordem crescente já encontra os destinos contados.
+ */
+static bool contar_palavras(dawg* dawg) {
+    dawg->contagens = calloc(dawg->total_transicoes, sizeof *dawg->contagens);
+    if (!dawg->contagens) {
+        return false;
+    }
+
+    for (size_t i = 1; i < dawg->total_transicoes; i++) {
+        const transicao_dawg* t = &dawg->transicoes[i];
+        size_t total = (t->marcas & DAWG_TERMINAL ? 1 : 0) +
+                       contagem_estado(dawg, t->destino);
+        if (total > UINT32_MAX) {
+            return false;
+        }
+        dawg->contagens[i] = (uint32_t) total;
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Reserva o índice 0 e constrói o estado inicial a partir do filho
+ *   do meio da sentinela.
+ * - Libera a pilha e a tabela e ajusta o vetor ao tamanho final.
+ * - Conta as palavras de cada transição.
+ */
+dawg* dawg_construir(const no_trie* raiz) {
+    if (!raiz) {
+        return NULL;
+    }
+
+    dawg* d = calloc(1, sizeof *d);
+    construtor_dawg c = {.total = 1, .capacidade = 1024};
+    c.transicoes = calloc(c.capacidade, sizeof *c.transicoes);
+    if (!d || !c.transicoes) {
+        free(d);
+        free(c.transicoes);
+        return NULL;
+    }
+
+    uint32_t inicial = construir_estado(&c, raiz->no_meio);
+    free(c.pilha);
+    free(c.tabela);
+
+    if (c.falhou) {
+        free(c.transicoes);
+        free(d);
+        return NULL;
+    }
+
+    transicao_dawg* ajustado =
+        realloc(c.transicoes, c.total * sizeof *c.transicoes);
+    d->transicoes = ajustado ? ajustado : c.transicoes;
+    d->total_transicoes = c.total;
+    d->total_estados = c.estados;
+    d->raiz = inicial;
+    if (!contar_palavras(d)) {
+        dawg_destruir(d);
+        return NULL;
+    }
+    return d;
+}
+
+/*
+ * Implementação:
+ * - Libera os vetores de transições e contagens e a estrutura.
+ */
+void dawg_destruir(dawg* dawg) {
+    if (!dawg) {
+        return;
+    }
+
+    free(dawg->transicoes);
+    free(dawg->contagens);
+    free(dawg);
+}
+
+/*
+ * Implementação:
+ * - Procura o caractere nas transições do estado, que estão em
+ *   ordem, parando no primeiro maior.
+ * - Retorna NULL se não houver transição pelo caractere.
+ */
+static const transicao_dawg*
+transicao_por(const dawg* dawg, uint32_t estado, char caractere) {
+    if (!estado) {
+        return NULL;
+    }
+
+    const transicao_dawg* t = &dawg->transicoes[estado];
+    while (t->caractere != caractere) {
+        if (t->caractere > caractere || (t->marcas & DAWG_ULTIMA)) {
+            return NULL;
+        }
+        t++;
+    }
+    return t;
+}
+
+/*
+ * Implementação:
+ * - Segue uma transição por caractere; a palavra existe se a última
+ *   transição tiver a marca DAWG_TERMINAL.
+ */
+bool dawg_contem(const dawg* dawg, const char* palavra) {
+    if (!dawg || !palavra || !*palavra) {
+        return false;
+    }
+
+    uint32_t estado = dawg->raiz;
+    while (true) {
+        const transicao_dawg* t = transicao_por(dawg, estado, *palavra);
+        if (!t) {
+            return false;
+        }
+        if (*(palavra + 1) == '\0') {
+            return (t->marcas & DAWG_TERMINAL) != 0;
+        }
+        estado = t->destino;
+        palavra++;
+    }
+}
+
+/*
+ * Implementação:
+ * - Segue as transições do prefixo e retorna a última (NULL se o
+ *   prefixo não for lido).
+ */
+static const transicao_dawg* dawg_localizar(const dawg* dawg,
+                                            const char* prefixo) {
+    uint32_t estado = dawg->raiz;
+    const transicao_dawg* t = NULL;
+    for (const char* p = prefixo; *p; p++) {
+        t = transicao_por(dawg, estado, *p);
+        if (!t) {
+            return NULL;
+        }
+        estado = t->destino;
+    }
+    return t;
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de buscar_aproximado_rec (trie.c): as transições
+ *   de um estado já estão em ordem, então basta percorrê-las.
+ * - Um destino compartilhado é visitado uma vez por caminho, pois a
+ *   linha de Levenshtein depende do prefixo lido até ele.
+ */
+static void aproximado_rec(const dawg* dawg,
+                           uint32_t estado,
+                           size_t profundidade,
+                           busca_aproximada* busca) {
+    for (uint32_t i = estado; estado && !busca->falhou; i++) {
+        const transicao_dawg* t = &dawg->transicoes[i];
+        size_t minimo =
+            busca_aproximada_avancar(busca, profundidade, t->caractere);
+        if (t->marcas & DAWG_TERMINAL) {
+            busca_aproximada_aceitar(busca, profundidade + 1);
+        }
+        if (minimo <= busca->max_distancia) {
+            aproximado_rec(dawg, t->destino, profundidade + 1, busca);
+        }
+        if (t->marcas & DAWG_ULTIMA) {
+            break;
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir do estado inicial.
+ */
+char** dawg_buscar_aproximado(const dawg* dawg,
+                              const char* palavra,
+                              size_t max_distancia,
+                              size_t* quantidade) {
+    if (!dawg || !palavra || !quantidade) {
+        return NULL;
+    }
+
+    busca_aproximada busca;
+    if (busca_aproximada_iniciar(&busca, palavra, max_distancia)) {
+        aproximado_rec(dawg, dawg->raiz, 0, &busca);
+    }
+
+    return busca_aproximada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de buscar_padrao_rec (trie.c): pula as transições
+ *   abaixo do intervalo aceito e para na primeira acima dele.
+ */
+static void padrao_rec(const dawg* dawg,
+                       uint32_t estado,
+                       size_t profundidade,
+                       busca_padrao* busca) {
+    char minimo = 0;
+    char maximo = 0;
+    busca_padrao_limites(busca, profundidade, &minimo, &maximo);
+
+    for (uint32_t i = estado; estado && !busca->falhou; i++) {
+        const transicao_dawg* t = &dawg->transicoes[i];
+        if (t->caractere > maximo) {
+            break;
+        }
+        if (t->caractere >= minimo) {
+            bool continuar =
+                busca_padrao_avancar(busca, profundidade, t->caractere);
+            if (t->marcas & DAWG_TERMINAL) {
+                busca_padrao_aceitar(busca, profundidade + 1);
+            }
+            if (continuar) {
+                padrao_rec(dawg, t->destino, profundidade + 1, busca);
+            }
+        }
+        if (t->marcas & DAWG_ULTIMA) {
+            break;
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir do estado inicial.
+ */
+char** dawg_buscar_padrao(const dawg* dawg,
+                          const char* padrao,
+                          size_t* quantidade) {
+    if (!dawg || !padrao || !*padrao || !quantidade) {
+        return NULL;
+    }
+
+    busca_padrao busca;
+    if (busca_padrao_iniciar(&busca, padrao)) {
+        padrao_rec(dawg, dawg->raiz, 0, &busca);
+    }
+
+    return busca_padrao_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Sem prefixo, as palavras do estado inicial.
+ * - Do contrário, a contagem da última transição do prefixo, que já
+ *   inclui o próprio prefixo, se for palavra.
+ */
+size_t dawg_contar_prefixo(const dawg* dawg, const char* prefixo) {
+    if (!dawg) {
+        return 0;
+    }
+
+    if (!prefixo || !*prefixo) {
+        return contagem_estado(dawg, dawg->raiz);
+    }
+
+    const transicao_dawg* t = dawg_localizar(dawg, prefixo);
+    return t ? dawg->contagens[t - dawg->transicoes] : 0;
+}
+
+/*
+ * Implementação:
+ * - Desce pelo caminho da palavra somando, em cada estado, as
+ *   transições por caracteres menores e, se a palavra continuar, o
+ *   prefixo já lido (quando for palavra).
+ */
+size_t dawg_rank(const dawg* dawg, const char* palavra) {
+    if (!dawg || !palavra) {
+        return 0;
+    }
+
+    size_t posicao = 0;
+    uint32_t estado = dawg->raiz;
+    while (estado && *palavra) {
+        uint32_t i = estado;
+        while (dawg->transicoes[i].caractere < *palavra &&
+               !(dawg->transicoes[i].marcas & DAWG_ULTIMA)) {
+            posicao += dawg->contagens[i++];
+        }
+
+        const transicao_dawg* t = &dawg->transicoes[i];
+        if (t->caractere < *palavra) {
+            posicao += dawg->contagens[i];
+        }
+        if (t->caractere != *palavra || *++palavra == '\0') {
+            break;
+        }
+        posicao += t->marcas & DAWG_TERMINAL ? 1 : 0;
+        estado = t->destino;
+    }
+
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Em cada estado, pula as transições cujas palavras ficam todas
+ *   antes de k e segue a que contém a k-ésima, descontando o prefixo
+ *   lido quando ele for palavra.
+ */
+char* dawg_selecionar(const dawg* dawg, size_t k) {
+    if (!dawg || k >= contagem_estado(dawg, dawg->raiz)) {
+        return NULL;
+    }
+
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    size_t tamanho = 0;
+    uint32_t i = dawg->raiz;
+
+    while (i) {
+        if (k >= dawg->contagens[i]) {
+            k -= dawg->contagens[i];
+            i = (dawg->transicoes[i].marcas & DAWG_ULTIMA) ? 0 : i + 1;
+            continue;
+        }
+
+        const transicao_dawg* t = &dawg->transicoes[i];
+        if (!garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 2)) {
+            break;
+        }
+        buffer[tamanho++] = t->caractere;
+        if (t->marcas & DAWG_TERMINAL) {
+            if (k == 0) {
+                buffer[tamanho] = '\0';
+                return buffer;
+            }
+            k--;
+        }
+        i = t->destino;
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Empilha a primeira transição do estado, dobrando a pilha se
+ *   necessário. Ignora o estado sem transições.
+ */
+static bool
+cursor_empilhar(dawg_cursor* cursor, uint32_t estado, size_t profundidade) {
+    if (!estado) {
+        return true;
+    }
+
+    if (cursor->topo == cursor->capacidade_pilha) {
+        size_t nova_cap =
+            cursor->capacidade_pilha ? cursor->capacidade_pilha * 2 : 32;
+        dawg_quadro* tmp =
+            realloc(cursor->pilha, nova_cap * sizeof *cursor->pilha);
+        if (!tmp) {
+            cursor->falhou = true;
+            return false;
+        }
+        cursor->pilha = tmp;
+        cursor->capacidade_pilha = nova_cap;
+    }
+
+    cursor->pilha[cursor->topo++] =
+        (dawg_quadro){.transicao = estado, .profundidade = profundidade};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Copia o prefixo para o buffer e segue suas transições.
+ * - Empilha o destino da última delas (ou o estado inicial, sem
+ *   prefixo) e marca o próprio prefixo como pendente se for palavra.
+ */
+bool dawg_cursor_abrir(dawg_cursor* cursor,
+                       const dawg* dawg,
+                       const char* prefixo) {
+    *cursor = (dawg_cursor){.dawg = dawg};
+    if (!dawg) {
+        return true;
+    }
+
+    size_t len = prefixo ? strlen(prefixo) : 0;
+    if (!garantir_tamanho_buffer(
+            &cursor->buffer, &cursor->capacidade_buffer, len + 1)) {
+        cursor->falhou = true;
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cursor->buffer, prefixo ? prefixo : "", len);
+    cursor->buffer[len] = '\0';
+
+    if (len == 0) {
+        return cursor_empilhar(cursor, dawg->raiz, 0);
+    }
+
+    uint32_t estado = dawg->raiz;
+    const transicao_dawg* t = NULL;
+    for (size_t i = 0; i < len; i++) {
+        t = transicao_por(dawg, estado, prefixo[i]);
+        if (!t) {
+            return true;
+        }
+        estado = t->destino;
+    }
+
+    cursor->prefixo_pendente = (t->marcas & DAWG_TERMINAL) != 0;
+    return cursor_empilhar(cursor, estado, len);
+}
+
+/*
+ * Implementação:
+ * - O topo da pilha indica a próxima transição de um estado. Ela é
+ *   consumida (o quadro passa à seguinte ou sai da pilha, se era a
+ *   última), seu caractere é escrito no buffer e seu destino é
+ *   empilhado, para ser percorrido antes das transições seguintes.
+ * - Se a transição for terminal, a palavra do buffer é retornada.
+ */
+const char* dawg_cursor_proximo(dawg_cursor* cursor) {
+    if (cursor->prefixo_pendente) {
+        cursor->prefixo_pendente = false;
+        return cursor->buffer;
+    }
+
+    while (cursor->topo > 0 && !cursor->falhou) {
+        dawg_quadro* q = &cursor->pilha[cursor->topo - 1];
+        const transicao_dawg* t = &cursor->dawg->transicoes[q->transicao];
+        size_t profundidade = q->profundidade;
+
+        if (t->marcas & DAWG_ULTIMA) {
+            cursor->topo--;
+        } else {
+            q->transicao++;
+        }
+
+        if (!garantir_tamanho_buffer(&cursor->buffer,
+                                     &cursor->capacidade_buffer,
+                                     profundidade + 2)) {
+            cursor->falhou = true;
+            break;
+        }
+        cursor->buffer[profundidade] = t->caractere;
+        cursor_empilhar(cursor, t->destino, profundidade + 1);
+        if (t->marcas & DAWG_TERMINAL) {
+            cursor->buffer[profundidade + 1] = '\0';
+            return cursor->buffer;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Libera pilha e buffer e zera o cursor.
+ */
+void dawg_cursor_fechar(dawg_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    free(cursor->pilha);
+    free(cursor->buffer);
+    *cursor = (dawg_cursor){0};
+}
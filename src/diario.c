@@ -0,0 +1,278 @@
+/**
+ * @file diario.c
+ * @brief Implementação do diário de alterações.
+ */
+
+#include "diario.h"
+
+#include "arquivo.h"
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TAM_CABECALHO_DIARIO 16
+#define TAM_FIXO_REGISTRO 9
+#define TAM_SOMA_REGISTRO 4
+#define TAM_BUFFER_DIARIO (64 * 1024)
+
+static const char MAGICO_DIARIO[8] = {
+    'T', 'S', 'T', 'D', 'I', 'A', 'R', '\0'};
+
+/*
+ * Implementação:
+ * - FNV-1a de 32 bits.
+ */
+static uint32_t somar(const char* dados, size_t tamanho, uint32_t soma) {
+    for (size_t i = 0; i < tamanho; i++) {
+        soma ^= (unsigned char) dados[i];
+        soma *= 16777619u;
+    }
+    return soma;
+}
+
+/*
+ * Implementação:
+ * - Grava o buffer no arquivo (sem sincronizar) e o esvazia.
+ */
+static bool gravar_buffer(diario* diario) {
+    if (diario->falhou) {
+        return false;
+    }
+    if (diario->usados > 0 &&
+        fwrite(diario->buffer, 1, diario->usados, diario->arquivo) !=
+            diario->usados) {
+        diario->falhou = true;
+        return false;
+    }
+    diario->usados = 0;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Percorre os registros a partir do cabeçalho, parando no primeiro
+ *   incompleto, com operação desconhecida ou com soma errada.
+ * - Copia cada palavra para um buffer terminado em '\0' e a entrega
+ *   a 'aplicar'.
+ * - Retorna false se 'aplicar' interromper; em 'fim' fica a posição
+ *   logo após o último registro válido.
+ */
+static bool reaplicar(const arquivo_mapeado* arquivo,
+                      diario_aplicar aplicar,
+                      void* contexto,
+                      size_t* fim,
+                      size_t* registros) {
+    char* palavra = NULL;
+    size_t capacidade = 0;
+    size_t posicao = TAM_CABECALHO_DIARIO;
+    bool ok = true;
+
+    while (ok && arquivo->tamanho - posicao >=
+                     TAM_FIXO_REGISTRO + TAM_SOMA_REGISTRO) {
+        const char* registro = arquivo->dados + posicao;
+        uint32_t tamanho = 0;
+        uint32_t peso = 0;
+        uint8_t operacao = 0;
+        memcpy(&tamanho, registro, sizeof tamanho);
+        memcpy(&peso, registro + 4, sizeof peso);
+        memcpy(&operacao, registro + 8, sizeof operacao);
+
+        size_t restante = arquivo->tamanho - posicao;
+        size_t total = TAM_FIXO_REGISTRO + (size_t) tamanho + TAM_SOMA_REGISTRO;
+        if (tamanho == 0 || total > restante ||
+            operacao < DIARIO_ADICIONAR || operacao > DIARIO_REMOVER) {
+            break;
+        }
+
+        uint32_t soma = 0;
+        memcpy(&soma, registro + total - TAM_SOMA_REGISTRO, sizeof soma);
+        if (soma != somar(registro, total - TAM_SOMA_REGISTRO, 2166136261u)) {
+            break;
+        }
+
+        ok = garantir_tamanho_buffer(&palavra, &capacidade, tamanho + 1);
+        if (ok) {
+            memcpy(palavra, registro + TAM_FIXO_REGISTRO, tamanho);
+            palavra[tamanho] = '\0';
+            ok = aplicar((operacao_diario) operacao, palavra, peso, contexto);
+        }
+        if (ok) {
+            posicao += total;
+            (*registros)++;
+        }
+    }
+
+    free(palavra);
+    *fim = posicao;
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Arquivo vazio (ou novo): grava o cabeçalho, sincroniza o arquivo
+ *   e o diretório.
+ * - Do contrário, valida o cabeçalho, reaplica os registros e, já sem
+ *   o mapeamento, corta o que vier depois do último válido.
+ * - O arquivo é aberto para acréscimo: toda gravação vai para o fim,
+ *   inclusive depois de diario_esvaziar.
+ */
+diario* diario_abrir(const char* caminho,
+                     size_t lote,
+                     diario_aplicar aplicar,
+                     void* contexto) {
+    if (!caminho || !aplicar) {
+        return NULL;
+    }
+
+    diario* d = calloc(1, sizeof *d);
+    if (!d) {
+        return NULL;
+    }
+    d->lote = lote;
+    d->arquivo = fopen(caminho, "ab");
+    if (!d->arquivo) {
+        free(d);
+        return NULL;
+    }
+
+    arquivo_mapeado arquivo;
+    bool ok = arquivo_mapear(caminho, true, &arquivo);
+    size_t tamanho = arquivo.tamanho;
+    size_t fim = 0;
+    if (ok && tamanho > 0) {
+        uint32_t versao = 0;
+        ok = tamanho >= TAM_CABECALHO_DIARIO &&
+             memcmp(arquivo.dados, MAGICO_DIARIO, sizeof MAGICO_DIARIO) == 0;
+        if (ok) {
+            memcpy(&versao,
+                   arquivo.dados + sizeof MAGICO_DIARIO,
+                   sizeof versao);
+            ok = versao == DIARIO_VERSAO &&
+                 reaplicar(&arquivo, aplicar, contexto, &fim, &d->registros);
+        }
+    }
+    arquivo_desmapear(&arquivo);
+
+    if (ok && tamanho == 0) {
+        char cabecalho[TAM_CABECALHO_DIARIO] = {0};
+        uint32_t versao = DIARIO_VERSAO;
+        memcpy(cabecalho, MAGICO_DIARIO, sizeof MAGICO_DIARIO);
+        memcpy(cabecalho + sizeof MAGICO_DIARIO, &versao, sizeof versao);
+        ok = fwrite(cabecalho, sizeof cabecalho, 1, d->arquivo) == 1 &&
+             arquivo_sincronizar(d->arquivo) &&
+             arquivo_sincronizar_diretorio(caminho);
+    } else if (ok && fim < tamanho) {
+        ok = arquivo_cortar(d->arquivo, fim) &&
+             arquivo_sincronizar(d->arquivo);
+    }
+
+    if (!ok) {
+        fclose(d->arquivo);
+        free(d);
+        return NULL;
+    }
+    return d;
+}
+
+/*
+ * Implementação:
+ * - Monta o registro direto no buffer, que cresce para caber
+ *   palavras maiores que ele.
+ * - Grava o buffer quando passa de TAM_BUFFER_DIARIO e sincroniza
+ *   quando o lote fica completo.
+ */
+bool diario_registrar(diario* diario,
+                      operacao_diario operacao,
+                      const char* palavra,
+                      uint32_t peso) {
+    if (!diario || !palavra || diario->falhou) {
+        return false;
+    }
+
+    size_t tamanho = strlen(palavra);
+    size_t total = TAM_FIXO_REGISTRO + tamanho + TAM_SOMA_REGISTRO;
+    if (tamanho == 0 || tamanho > UINT32_MAX ||
+        !garantir_tamanho_buffer(
+            &diario->buffer, &diario->capacidade, diario->usados + total)) {
+        return false;
+    }
+
+    char* registro = diario->buffer + diario->usados;
+    uint32_t tamanho32 = (uint32_t) tamanho;
+    uint8_t operacao8 = (uint8_t) operacao;
+    memcpy(registro, &tamanho32, sizeof tamanho32);
+    memcpy(registro + 4, &peso, sizeof peso);
+    memcpy(registro + 8, &operacao8, sizeof operacao8);
+    memcpy(registro + TAM_FIXO_REGISTRO, palavra, tamanho);
+    uint32_t soma =
+        somar(registro, total - TAM_SOMA_REGISTRO, 2166136261u);
+    memcpy(registro + total - TAM_SOMA_REGISTRO, &soma, sizeof soma);
+
+    diario->usados += total;
+    diario->pendentes++;
+    diario->registros++;
+
+    if (diario->lote > 0 && diario->pendentes >= diario->lote) {
+        return diario_sincronizar(diario);
+    }
+    if (diario->usados >= TAM_BUFFER_DIARIO) {
+        return gravar_buffer(diario);
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Grava o buffer e sincroniza apenas se houver pendências.
+ */
+bool diario_sincronizar(diario* diario) {
+    if (!diario || !gravar_buffer(diario)) {
+        return false;
+    }
+    if (diario->pendentes == 0) {
+        return true;
+    }
+    if (!arquivo_sincronizar(diario->arquivo)) {
+        diario->falhou = true;
+        return false;
+    }
+    diario->pendentes = 0;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Os registros do buffer também são descartados: quem esvazia já
+ *   guardou o estado que eles descrevem.
+ * - Uma falha anterior de gravação é esquecida, pois os registros que
+ *   ela perdeu também estão consolidados.
+ */
+bool diario_esvaziar(diario* diario) {
+    if (!diario) {
+        return false;
+    }
+
+    diario->usados = 0;
+    diario->pendentes = 0;
+    diario->registros = 0;
+    diario->falhou = !arquivo_cortar(diario->arquivo, TAM_CABECALHO_DIARIO) ||
+                     !arquivo_sincronizar(diario->arquivo);
+    return !diario->falhou;
+}
+
+/*
+ * Implementação:
+ * - Sincroniza, fecha o arquivo e libera o buffer.
+ */
+bool diario_fechar(diario* diario) {
+    if (!diario) {
+        return true;
+    }
+
+    bool ok = diario_sincronizar(diario);
+    ok = (fclose(diario->arquivo) == 0) && ok;
+    free(diario->buffer);
+    free(diario);
+    return ok;
+}
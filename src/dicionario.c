@@ -2,300 +2,2312 @@
  * @file dicionario.c
  * @brief Implementação das funções de dicionário.
  */
+#define _POSIX_C_SOURCE 200809L
+
 #include "dicionario.h"
 
+#include "arena.h"
+#include "arquivo.h"
+#include "diario.h"
+#include "epoca.h"
+#include "normalizacao.h"
+#include "padrao.h"
+#include "snapshot.h"
 #include "trie.h"
 #include "util.h"
 
+#include <ctype.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stddef.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#define TAM_PALAVRA_LOCAL (NORMALIZACAO_MAX_LETRAS + 1)
+#define TOTAL_LETRAS 26
+#define PALAVRAS_POR_LOTE 32
+#define TAM_BLOCO_LINHAS (64 * 1024)
+
+/**
+ * @struct concorrencia_dicionario
+ * @brief Estado do modo concorrente de um dicionário.
+ *
+ * Leitores obtêm a raiz publicada dentro de uma seção de leitura do
+ * domínio de épocas; escritores se revezam pelo mutex.
+ */
+struct concorrencia_dicionario {
+    _Atomic(no_trie*) raiz;
+    pthread_mutex_t escrita;
+    epoca_dominio* epoca;
+};
+
+/**
+ * @struct persistencia_dicionario
+ * @brief Estado de um dicionário persistente.
+ *
+ * 'limite' é a quantidade de registros do diário que dispara a
+ * consolidação no snapshot (0 desliga a consolidação automática).
+ * 'falhou' marca uma alteração aplicada na memória que não chegou ao
+ * diário nem ao snapshot; fica marcado até a próxima consolidação.
+ */
+struct persistencia_dicionario {
+    diario* diario;
+    char* caminho_snapshot;
+    size_t limite;
+    bool falhou;
+};
+
+/*
+ * @brief Função chamada para cada palavra válida de um arquivo.
+ *
+ * Recebe a palavra já normalizada, em buffer reutilizado pelo
+ * percurso, o peso lido da linha (NULL se a linha não tiver peso) e
+ * o contexto informado. Retorna false para interromper.
+ */
+typedef bool (*funcao_palavra)(const char* palavra,
+                               const uint32_t* peso,
+                               void* contexto);
+
+/*
+ * Implementação:
+ * - Aceita dígitos decimais cercados por espaços, tabulações ou '\r'.
+ * - Rejeita trechos sem dígitos e valores acima de UINT32_MAX.
+ */
+static bool ler_peso(const char* trecho, size_t tamanho, uint32_t* peso) {
+    size_t i = 0;
+    while (i < tamanho && (trecho[i] == ' ' || trecho[i] == '\t')) {
+        i++;
+    }
+
+    uint64_t valor = 0;
+    size_t inicio = i;
+    while (i < tamanho && trecho[i] >= '0' && trecho[i] <= '9') {
+        valor = (valor * 10) + (uint64_t) (trecho[i] - '0');
+        if (valor > UINT32_MAX) {
+            return false;
+        }
+        i++;
+    }
+    if (i == inicio) {
+        return false;
+    }
+
+    while (i < tamanho &&
+           (trecho[i] == ' ' || trecho[i] == '\t' || trecho[i] == '\r')) {
+        i++;
+    }
+    if (i != tamanho) {
+        return false;
+    }
+
+    *peso = (uint32_t) valor;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Normaliza o texto em blocos de até TAM_BLOCO_LINHAS bytes que
+ *   terminam em quebra de linha (uma linha maior forma um bloco só),
+ *   com uma única passada de normalizar_linhas por bloco.
+ * - Entrega as palavras de cada bloco na ordem do texto.
+ */
+static bool percorrer_blocos(const char* texto,
+                             size_t tamanho,
+                             funcao_palavra funcao,
+                             void* contexto) {
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    bool ok = true;
+
+    const char* p = texto;
+    const char* fim = texto + tamanho;
+    while (ok && p < fim) {
+        size_t bloco = (size_t) (fim - p);
+        if (bloco > TAM_BLOCO_LINHAS) {
+            const char* corte = p + TAM_BLOCO_LINHAS;
+            while (corte > p && *(corte - 1) != '\n') {
+                corte--;
+            }
+            if (corte == p) {
+                const char* quebra = memchr(p + TAM_BLOCO_LINHAS,
+                                            '\n',
+                                            bloco - TAM_BLOCO_LINHAS);
+                corte = quebra ? quebra + 1 : fim;
+            }
+            bloco = (size_t) (corte - p);
+        }
+
+        if (!garantir_tamanho_buffer(&buffer, &capacidade, bloco + 1)) {
+            ok = false;
+            break;
+        }
+
+        size_t usados = 0;
+        size_t palavras = normalizar_linhas(p, bloco, buffer, &usados);
+        const char* palavra = buffer;
+        for (size_t i = 0; ok && i < palavras; i++) {
+            size_t tamanho_palavra = strlen(palavra);
+            ok = funcao(palavra, NULL, contexto);
+            palavra += tamanho_palavra + 1;
+        }
+
+        p += bloco;
+    }
+
+    free(buffer);
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Mapeia o arquivo em memória e o percorre linha a linha, sem
+ *   copiar o arquivo nem alocar memória por linha.
+ * - Sem 'com_peso', o texto é normalizado em blocos (percorrer_blocos).
+ * - Com 'com_peso', cada linha é normalizada direto do mapeamento
+ *   para um buffer local; linhas maiores que ele usam um buffer no
+ *   heap reutilizado. Uma tabulação separa a palavra de seu peso;
+ *   linhas sem tabulação não têm peso e linhas com peso inválido
+ *   são ignoradas.
+ * - Ignora linhas vazias ou inválidas.
+ * - Retorna false se o arquivo não puder ser aberto ou se o percurso
+ *   for interrompido.
+ */
+static bool percorrer_arquivo(const char* caminho,
+                              bool com_peso,
+                              funcao_palavra funcao,
+                              void* contexto) {
+    arquivo_mapeado arquivo;
+    if (!arquivo_mapear(caminho, true, &arquivo)) {
+        return false;
+    }
+
+    if (!com_peso) {
+        bool ok = percorrer_blocos(
+            arquivo.dados, arquivo.tamanho, funcao, contexto);
+        arquivo_desmapear(&arquivo);
+        return ok;
+    }
+
+    char local[TAM_PALAVRA_LOCAL];
+    char* buffer = local;
+    size_t capacidade = sizeof local;
+    bool ok = true;
+
+    const char* p = arquivo.dados;
+    const char* fim = p + arquivo.tamanho;
+    while (ok && p < fim) {
+        const char* quebra = memchr(p, '\n', (size_t) (fim - p));
+        size_t tamanho = quebra ? (size_t) (quebra - p) : (size_t) (fim - p);
+
+        if (tamanho >= capacidade) {
+            char* maior = malloc(tamanho + 1);
+            if (!maior) {
+                ok = false;
+                break;
+            }
+            if (buffer != local) {
+                free(buffer);
+            }
+            buffer = maior;
+            capacidade = tamanho + 1;
+        }
+
+        size_t tamanho_palavra = tamanho;
+        uint32_t peso = 0;
+        const uint32_t* lido = NULL;
+        const char* tab = memchr(p, '\t', tamanho);
+        if (tab) {
+            tamanho_palavra = (size_t) (tab - p);
+            lido = &peso;
+        }
+
+        bool valida = !tab || ler_peso(tab + 1,
+                                       tamanho - tamanho_palavra - 1,
+                                       &peso);
+        if (valida && normalizar_trecho(p, tamanho_palavra, buffer) &&
+            buffer[0] != '\0') {
+            ok = funcao(buffer, lido, contexto);
+        }
+
+        p += tamanho + 1;
+    }
+
+    if (buffer != local) {
+        free(buffer);
+    }
+    arquivo_desmapear(&arquivo);
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Aloca uma cópia do tamanho da string informada.
+ * - Normaliza (trim, minúsculo e validação) direto para a cópia.
+ * - Se for válida, retorna string final; do contrário, retorna NULL.
+ */
+static char* normalizar_palavra(const char* palavra) {
+    size_t tamanho = strlen(palavra);
+    char* palavra_normalizada = malloc(tamanho + 1);
+    if (!palavra_normalizada) {
+        return NULL;
+    }
+
+    if (!normalizar_trecho(palavra, tamanho, palavra_normalizada)) {
+        free(palavra_normalizada);
+        return NULL;
+    }
+
+    return palavra_normalizada;
+}
+
+/*
+ * Implementação:
+ * - Fora do modo concorrente, retorna a raiz do dicionário.
+ * - No modo concorrente, abre uma seção de leitura e só então lê a
+ *   raiz publicada; a seção mantém vivos todos os nós dessa versão.
+ * - Sem vaga livre, lê sob o mutex de escrita: enquanto ele estiver
+ *   preso, nenhum nó é aposentado nem liberado.
+ */
+static no_trie* leitura_iniciar(const dicionario* dicionario, size_t* vaga) {
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (!c) {
+        return dicionario->raiz;
+    }
+
+    *vaga = epoca_entrar(c->epoca);
+    if (*vaga == EPOCA_SEM_VAGA) {
+        pthread_mutex_lock(&c->escrita);
+    }
+    return atomic_load(&c->raiz);
+}
+
+/*
+ * Implementação:
+ * - Encerra a seção aberta por leitura_iniciar, se houver, ou solta
+ *   o mutex de escrita que a substituiu.
+ */
+static void leitura_finalizar(const dicionario* dicionario, size_t vaga) {
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (c && vaga == EPOCA_SEM_VAGA) {
+        pthread_mutex_unlock(&c->escrita);
+    } else if (c) {
+        epoca_sair(c->epoca, vaga);
+    }
+}
+
+/*
+ * Implementação:
+ * - Snapshots, autômatos e os demais motores não têm raiz; neles
+ *   buscas por prefixo e listagens são feitas por cursor.
+ */
+static bool usa_trie_ternaria(const dicionario* dicionario) {
+    return dicionario->raiz || dicionario->concorrencia;
+}
+
+/*
+ * Implementação:
+ * - Só conta remoções adiadas (fora do modo concorrente, com limite).
+ * - Compacta ao atingir o limite; se a compactação falhar, o lixo
+ *   continua contado e ela é tentada de novo na próxima remoção.
+ */
+static void acumular_lixo(dicionario* dicionario, size_t removidas) {
+    if (dicionario->limite_lixo == 0 || dicionario->concorrencia) {
+        return;
+    }
+
+    dicionario->lixo += removidas;
+    if (dicionario->lixo >= dicionario->limite_lixo) {
+        dicionario_compactar(dicionario);
+    }
+}
+
+/*
+ * Implementação:
+ * - Raiz atual da trie; no modo concorrente, só é estável para quem
+ *   detém o mutex de escrita.
+ */
+static no_trie* raiz_atual(const dicionario* dicionario) {
+    if (dicionario->concorrencia) {
+        return atomic_load(&dicionario->concorrencia->raiz);
+    }
+    return dicionario->raiz;
+}
+
+/*
+ * Implementação:
+ * - Chamada com o mutex de escrita, se houver.
+ * - Compacta antes as remoções adiadas, para o snapshot não carregar
+ *   nós sem palavras; uma falha só deixa o snapshot maior.
+ * - Só esvazia o diário depois de o snapshot estar no disco; com
+ *   isso, uma falha anterior de registro deixa de valer.
+ */
+static bool consolidar(dicionario* dicionario) {
+    struct persistencia_dicionario* p = dicionario->persistencia;
+    if (dicionario->lixo > 0) {
+        dicionario_compactar(dicionario);
+    }
+
+    const no_trie* raiz = raiz_atual(dicionario);
+    bool ok = raiz &&
+              snapshot_salvar(
+                  raiz, dicionario->total_palavras, p->caminho_snapshot) &&
+              diario_esvaziar(p->diario);
+    if (ok) {
+        p->falhou = false;
+    }
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Sem persistência, nunca falha.
+ */
+static bool persistencia_falhou(const dicionario* dicionario) {
+    return dicionario->persistencia && dicionario->persistencia->falhou;
+}
+
+/*
+ * Implementação:
+ * - Chamada com o mutex de escrita, se houver, depois de a alteração
+ *   ser aplicada.
+ * - Sem persistência, não faz nada.
+ * - Se o diário não aceitar o registro, consolida na hora: o snapshot
+ *   já inclui a alteração e a consolidação esvazia o diário, que volta
+ *   a aceitar registros. Se ela também falhar, marca 'falhou' e é
+ *   tentada de novo no próximo registro.
+ * - Consolida ao atingir o limite; se a consolidação falhar, ela é
+ *   tentada de novo no próximo registro.
+ * - Retorna false se a alteração não foi guardada no diário nem no
+ *   snapshot.
+ */
+static bool registrar_alteracao(dicionario* dicionario,
+                                operacao_diario operacao,
+                                const char* palavra,
+                                uint32_t peso) {
+    struct persistencia_dicionario* p = dicionario->persistencia;
+    if (!p) {
+        return true;
+    }
+
+    if (!diario_registrar(p->diario, operacao, palavra, peso)) {
+        p->falhou = !consolidar(dicionario);
+        return !p->falhou;
+    }
+    if (p->limite > 0 && p->diario->registros >= p->limite) {
+        consolidar(dicionario);
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Fora do modo concorrente, altera a trie (ou o motor) no lugar.
+ *   Com a remoção adiada, a remoção só desmarca a palavra.
+ * - Na inserção, 'peso' (se não for NULL) substitui o peso da palavra,
+ *   mesmo que ela já exista.
+ * - No modo concorrente, sob o mutex de escrita, monta a nova versão
+ *   por cópia de caminho, publica a nova sentinela e só então confirma
+ *   os nós substituídos. Em falha, nada é publicado.
+ * - Atualiza o total de palavras e registra a alteração no diário.
+ *   Uma inserção com peso é registrada mesmo sem palavra nova, pois
+ *   pode ter mudado o peso.
+ * - Retorna false se o registro falhar, mesmo com a alteração já
+ *   aplicada na memória.
+ */
+static bool alterar_palavra(dicionario* dicionario,
+                            const char* palavra,
+                            bool inserir,
+                            const uint32_t* peso) {
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    bool alterou = false;
+
+    if (dicionario->motor && inserir) {
+        alterou = motor_inserir(dicionario->motor, palavra, peso);
+    } else if (dicionario->motor) {
+        alterou = motor_remover(dicionario->motor, palavra);
+    } else if (!c && inserir && peso) {
+        alterou = trie_inserir_com_peso(
+            dicionario->raiz, dicionario->arena, palavra, *peso);
+    } else if (!c && inserir) {
+        alterou = trie_inserir(dicionario->raiz, dicionario->arena, palavra);
+    } else if (!c && dicionario->limite_lixo > 0) {
+        alterou = trie_desmarcar(dicionario->raiz, palavra);
+    } else if (!c) {
+        alterou = trie_remover(dicionario->raiz, dicionario->arena, palavra);
+    } else {
+        pthread_mutex_lock(&c->escrita);
+        no_trie* atual = atomic_load(&c->raiz);
+        no_trie* nova = NULL;
+        if (inserir) {
+            nova = trie_inserir_copiando(atual,
+                                         dicionario->arena,
+                                         palavra,
+                                         peso,
+                                         epoca_aposentar,
+                                         c->epoca,
+                                         &alterou);
+        } else {
+            nova = trie_remover_copiando(atual,
+                                         dicionario->arena,
+                                         palavra,
+                                         epoca_aposentar,
+                                         c->epoca,
+                                         &alterou);
+        }
+        if (!nova) {
+            epoca_descartar(c->epoca);
+        } else if (nova != atual) {
+            atomic_store(&c->raiz, nova);
+            epoca_confirmar(c->epoca, dicionario->arena);
+        }
+    }
+
+    if (alterou) {
+        if (inserir) {
+            dicionario->total_palavras++;
+        } else {
+            dicionario->total_palavras--;
+            acumular_lixo(dicionario, 1);
+        }
+    }
+    if (alterou || (inserir && peso)) {
+        operacao_diario operacao = DIARIO_REMOVER;
+        if (inserir) {
+            operacao = peso ? DIARIO_ADICIONAR_COM_PESO : DIARIO_ADICIONAR;
+        }
+        alterou = registrar_alteracao(
+                      dicionario, operacao, palavra, peso ? *peso : 0) &&
+                  alterou;
+    }
+
+    if (c) {
+        pthread_mutex_unlock(&c->escrita);
+    }
+    return alterou;
+}
+
+/*
+ * Implementação:
+ * - Insere palavra já normalizada (com o peso da linha, se houver)
+ *   e atualiza o total.
+ * - Só interrompe o percurso do arquivo se a alteração não puder ser
+ *   registrada no diário (ver registrar_alteracao).
+ */
+static bool adicionar_normalizada(const char* palavra,
+                                  const uint32_t* peso,
+                                  void* contexto) {
+    alterar_palavra(contexto, palavra, true, peso);
+    return !persistencia_falhou(contexto);
+}
+
+/**
+ * @struct colecao_palavras
+ * @brief Palavras normalizadas guardadas em um único buffer de texto.
+ *
+ * As palavras ficam em sequência no texto, separadas por '\0'.
+ */
+typedef struct {
+    char* texto;
+    size_t tamanho;
+    size_t capacidade;
+    size_t quantidade;
+} colecao_palavras;
+
+/*
+ * Implementação:
+ * - Anexa a palavra (com '\0') ao texto, dobrando a capacidade
+ *   quando necessário.
+ */
+static bool coletar_normalizada(const char* palavra,
+                                const uint32_t* peso,
+                                void* contexto) {
+    (void) peso;
+    colecao_palavras* colecao = contexto;
+    size_t tamanho = strlen(palavra) + 1;
+
+    if (colecao->tamanho + tamanho > colecao->capacidade) {
+        size_t nova_cap = colecao->capacidade ? colecao->capacidade * 2 : 4096;
+        while (nova_cap < colecao->tamanho + tamanho) {
+            nova_cap *= 2;
+        }
+        char* tmp = realloc(colecao->texto, nova_cap);
+        if (!tmp) {
+            return false;
+        }
+        colecao->texto = tmp;
+        colecao->capacidade = nova_cap;
+    }
+
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(colecao->texto + colecao->tamanho, palavra, tamanho);
+    colecao->tamanho += tamanho;
+    colecao->quantidade++;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Comparador de strings para qsort.
+ */
+static int comparar_palavras(const void* a, const void* b) {
+    return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+/*
+ * Implementação:
+ * - Monta um array de ponteiros para as palavras da coleção, ordena
+ *   e remove as duplicatas.
+ * - O array (liberado pelo chamador) aponta para o texto da coleção.
+ */
+static char** ordenar_colecao(const colecao_palavras* colecao,
+                              size_t* unicas) {
+    char** palavras =
+        (char**) malloc((colecao->quantidade + 1) * sizeof(char*));
+    if (!palavras) {
+        return NULL;
+    }
+
+    char* p = colecao->texto;
+    for (size_t i = 0; i < colecao->quantidade; i++) {
+        palavras[i] = p;
+        p += strlen(p) + 1;
+    }
+
+    qsort((void*) palavras,
+          colecao->quantidade,
+          sizeof *palavras,
+          comparar_palavras);
+
+    size_t total = 0;
+    for (size_t i = 0; i < colecao->quantidade; i++) {
+        if (total == 0 || strcmp(palavras[total - 1], palavras[i]) != 0) {
+            palavras[total++] = palavras[i];
+        }
+    }
+
+    *unicas = total;
+    return palavras;
+}
+
+/*
+ * Implementação:
+ * - 'palavras' está ordenada e sem duplicatas.
+ * - Na Trie ternária, remove todas em um único percurso
+ *   (trie_remover_lote). No modo concorrente, o percurso monta uma
+ *   única nova versão, publicada como em alterar_palavra. Com a
+ *   remoção adiada, o percurso só desmarca as palavras.
+ * - Nos demais motores, remove palavra a palavra.
+ * - Atualiza o total de palavras. Se algo foi removido, registra
+ *   todas as palavras no diário: o percurso não informa quais
+ *   estavam presentes, e remover uma ausente não altera nada.
+ * - Retorna SIZE_MAX se o registro falhar, mesmo com as remoções já
+ *   aplicadas na memória.
+ */
+static size_t remover_ordenadas(dicionario* dicionario,
+                                char* const* palavras,
+                                size_t quantidade) {
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    size_t removidas = 0;
+
+    if (dicionario->motor) {
+        for (size_t i = 0; i < quantidade; i++) {
+            removidas += motor_remover(dicionario->motor, palavras[i]);
+        }
+    } else if (!c && dicionario->limite_lixo > 0) {
+        removidas = trie_desmarcar_lote(dicionario->raiz, palavras, quantidade);
+    } else if (!c) {
+        removidas = trie_remover_lote(
+            dicionario->raiz, dicionario->arena, palavras, quantidade);
+    } else {
+        pthread_mutex_lock(&c->escrita);
+        no_trie* atual = atomic_load(&c->raiz);
+        no_trie* nova = trie_remover_lote_copiando(atual,
+                                                   dicionario->arena,
+                                                   palavras,
+                                                   quantidade,
+                                                   epoca_aposentar,
+                                                   c->epoca,
+                                                   &removidas);
+        if (!nova) {
+            epoca_descartar(c->epoca);
+        } else if (nova != atual) {
+            atomic_store(&c->raiz, nova);
+            epoca_confirmar(c->epoca, dicionario->arena);
+        }
+    }
+
+    dicionario->total_palavras -= removidas;
+    if (removidas > 0) {
+        acumular_lixo(dicionario, removidas);
+    }
+    bool registrou = true;
+    for (size_t i = 0; registrou && removidas > 0 && i < quantidade; i++) {
+        registrou =
+            registrar_alteracao(dicionario, DIARIO_REMOVER, palavras[i], 0);
+    }
+
+    if (c) {
+        pthread_mutex_unlock(&c->escrita);
+    }
+    return registrou ? removidas : SIZE_MAX;
+}
+
+/*
+ * Implementação:
+ * - Insere a mediana do intervalo [inicio, fim) e, em seguida,
+ *   as medianas das metades esquerda e direita.
+ * - Para se o registro no diário falhar (ver registrar_alteracao).
+ */
+static void inserir_mediana_primeiro(dicionario* dicionario,
+                                     char** palavras,
+                                     size_t inicio,
+                                     size_t fim) {
+    if (inicio >= fim || persistencia_falhou(dicionario)) {
+        return;
+    }
+
+    size_t meio = inicio + ((fim - inicio) / 2);
+    alterar_palavra(dicionario, palavras[meio], true, NULL);
+
+    inserir_mediana_primeiro(dicionario, palavras, inicio, meio);
+    inserir_mediana_primeiro(dicionario, palavras, meio + 1, fim);
+}
+
+/**
+ * @struct fatia_linhas
+ * @brief Posições, no arquivo, das linhas que começam com uma letra.
+ */
+typedef struct {
+    size_t* inicios;
+    size_t quantidade;
+    size_t capacidade;
+} fatia_linhas;
+
+/**
+ * @struct trabalhador_carga
+ * @brief Estado de uma thread da carga paralela.
+ *
+ * Cada thread retira letras de 'proxima_letra' e monta a subárvore
+ * de cada uma em 'raizes', alocando nós apenas da própria arena.
+ * Com 'balanceada', as subárvores mantêm os irmãos balanceados, como
+ * a Trie do dicionário.
+ */
+typedef struct {
+    const arquivo_mapeado* arquivo;
+    const fatia_linhas* fatias;
+    no_trie** raizes;
+    size_t* inseridas;
+    atomic_size_t* proxima_letra;
+    arena_nos* arena;
+    bool balanceada;
+    bool falhou;
+} trabalhador_carga;
+
+/*
+ * Implementação:
+ * - Registra o início de cada linha na fatia da sua primeira letra
+ *   (ignorando espaços e maiúsculas).
+ * - Linhas que não começam com letra seriam rejeitadas pela
+ *   normalização e são descartadas aqui.
+ */
+static bool separar_linhas(const arquivo_mapeado* arquivo,
+                           fatia_linhas* fatias) {
+    const char* p = arquivo->dados;
+    const char* fim = p + arquivo->tamanho;
+
+    while (p < fim) {
+        const char* quebra = memchr(p, '\n', (size_t) (fim - p));
+        const char* fim_linha = quebra ? quebra : fim;
+
+        const char* c = p;
+        while (c < fim_linha && isspace((unsigned char) *c)) {
+            c++;
+        }
+
+        if (c < fim_linha && isalpha((unsigned char) *c)) {
+            int letra = tolower((unsigned char) *c) - 'a';
+            if (letra >= 0 && letra < TOTAL_LETRAS) {
+                fatia_linhas* f = &fatias[letra];
+                if (f->quantidade == f->capacidade) {
+                    size_t nova_cap = f->capacidade ? f->capacidade * 2 : 256;
+                    size_t* tmp = realloc(f->inicios, nova_cap * sizeof *tmp);
+                    if (!tmp) {
+                        return false;
+                    }
+                    f->inicios = tmp;
+                    f->capacidade = nova_cap;
+                }
+                f->inicios[f->quantidade++] = (size_t) (p - arquivo->dados);
+            }
+        }
+
+        p = fim_linha + 1;
+    }
+
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Enquanto houver letras pendentes, monta a subárvore da letra
+ *   inserindo suas linhas sob uma sentinela local.
+ * - Usa um único buffer de normalização por thread.
+ */
+static void* carregar_letras(void* argumento) {
+    trabalhador_carga* t = argumento;
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    size_t letra = 0;
+
+    while (!t->falhou &&
+           (letra = atomic_fetch_add(t->proxima_letra, 1)) < TOTAL_LETRAS) {
+        no_trie sentinela = {.no_meio = t->raizes[letra],
+                             .altura = t->balanceada ? 1 : 0};
+        const fatia_linhas* f = &t->fatias[letra];
+
+        for (size_t i = 0; i < f->quantidade; i++) {
+            const char* p = t->arquivo->dados + f->inicios[i];
+            size_t resto = t->arquivo->tamanho - f->inicios[i];
+            const char* quebra = memchr(p, '\n', resto);
+            size_t tamanho = quebra ? (size_t) (quebra - p) : resto;
+
+            if (!garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 1)) {
+                t->falhou = true;
+                break;
+            }
+
+            if (normalizar_trecho(p, tamanho, buffer) && buffer[0] != '\0' &&
+                trie_inserir(&sentinela, t->arena, buffer)) {
+                t->inseridas[letra]++;
+            }
+        }
+
+        t->raizes[letra] = sentinela.no_meio;
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Desliga os nós do primeiro nível (irmãos sob a sentinela),
+ *   guardando cada um na posição da sua letra.
+ */
+static void separar_raizes(no_trie* no, no_trie** raizes) {
+    if (!no) {
+        return;
+    }
+
+    separar_raizes(no->no_esquerdo, raizes);
+    separar_raizes(no->no_direito, raizes);
+    no->no_esquerdo = NULL;
+    no->no_direito = NULL;
+    raizes[no->caractere - 'a'] = no;
+}
+
+/*
+ * Implementação:
+ * - Liga os nós em ordem de [inicio, fim) como árvore binária
+ *   balanceada, com a mediana como raiz, recalculando os agregados
+ *   de cada nó depois de ligar seus filhos.
+ * - Como a metade esquerda nunca é menor que a direita, a altura do
+ *   nó é a da subárvore esquerda mais 1.
+ */
+static no_trie* ligar_raizes(no_trie** nos, size_t inicio, size_t fim) {
+    if (inicio >= fim) {
+        return NULL;
+    }
+
+    size_t meio = inicio + ((fim - inicio) / 2);
+    no_trie* no = nos[meio];
+    no->no_esquerdo = ligar_raizes(nos, inicio, meio);
+    no->no_direito = ligar_raizes(nos, meio + 1, fim);
+    no->altura =
+        (uint8_t) (1 + (no->no_esquerdo ? no->no_esquerdo->altura : 0));
+    trie_recalcular_agregados(no);
+    return no;
+}
+
+/*
+ * Implementação:
+ * - Insere, com seus pesos, as medianas de [inicio, fim) primeiro,
+ *   como inserir_mediana_primeiro.
+ */
+static bool copiar_medianas(no_trie* raiz,
+                            arena_nos* arena,
+                            const motor* motor,
+                            char** palavras,
+                            size_t inicio,
+                            size_t fim) {
+    if (inicio >= fim) {
+        return true;
+    }
+
+    size_t meio = inicio + ((fim - inicio) / 2);
+    uint32_t peso = motor_peso(motor, palavras[meio]);
+    if (!trie_inserir_com_peso(raiz, arena, palavras[meio], peso)) {
+        return false;
+    }
+
+    return copiar_medianas(raiz, arena, motor, palavras, inicio, meio) &&
+           copiar_medianas(raiz, arena, motor, palavras, meio + 1, fim);
+}
+
+/*
+ * Implementação:
+ * - Copia as palavras do motor (em ordem) para uma trie ternária
+ *   temporária na arena informada, com irmãos balanceados. Usada onde
+ *   só a trie ternária é aceita (snapshot e autômato).
+ * - Retorna a sentinela ou NULL em falha.
+ */
+static no_trie* trie_de_motor(const motor* motor, arena_nos* arena) {
+    no_trie* raiz = arena_alocar_no(arena);
+    if (!raiz) {
+        return NULL;
+    }
+
+    size_t quantidade = 0;
+    char** palavras = motor_listar(motor, &quantidade);
+    bool ok = (palavras || quantidade == 0) &&
+              copiar_medianas(raiz, arena, motor, palavras, 0, quantidade);
+
+    trie_liberar_lista(palavras, quantidade);
+    return ok ? raiz : NULL;
+}
+
+/*
+ * Implementação:
+ * - Usa o motor de trie ternária.
+ */
+dicionario* dicionario_criar() {
+    return dicionario_criar_com_motor(DICIONARIO_MOTOR_TRIE);
+}
+
+/*
+ * Implementação:
+ * - Aloca estrutura dicionario.
+ * - Com outro motor, cria apenas o motor.
+ * - Do contrário, aloca arena de nós e o nó sentinela da trie a
+ *   partir dela.
+ * - Define quantidade de palavras como 0.
+ */
+dicionario* dicionario_criar_com_motor(motor_dicionario motor) {
+    dicionario* dicionario = calloc(1, sizeof *dicionario);
+    if (!dicionario) {
+        return NULL;
+    }
+
+    if (motor != DICIONARIO_MOTOR_TRIE) {
+        dicionario->motor = motor_criar(motor == DICIONARIO_MOTOR_RAJADA
+                                            ? &MOTOR_RAJADA
+                                            : &MOTOR_VETOR_DUPLO);
+        if (!dicionario->motor) {
+            free(dicionario);
+            return NULL;
+        }
+        return dicionario;
+    }
+
+    dicionario->arena = arena_criar(0);
+    if (!dicionario->arena) {
+        free(dicionario);
+        return NULL;
+    }
+
+    dicionario->raiz = arena_alocar_no(dicionario->arena);
+    if (!dicionario->raiz) {
+        arena_destruir(dicionario->arena);
+        free(dicionario);
+        // cppcheck-suppress memleak ; falso-positivo
+        return NULL;
+    }
+
+    // cppcheck-suppress memleak ; falso-positivo
+    return dicionario;
+}
+
+/*
+ * Implementação:
+ * - Aloca estrutura dicionario sem raiz nem arena.
+ * - Abre o snapshot e obtém dele a quantidade de palavras.
+ */
+dicionario* dicionario_abrir_snapshot(const char* caminho) {
+    dicionario* dicionario = calloc(1, sizeof *dicionario);
+    if (!dicionario) {
+        return NULL;
+    }
+
+    dicionario->snapshot = snapshot_abrir(caminho);
+    if (!dicionario->snapshot) {
+        free(dicionario);
+        return NULL;
+    }
+
+    dicionario->total_palavras = dicionario->snapshot->total_palavras;
+    return dicionario;
+}
+
+/*
+ * Implementação:
+ * - Cria a arena e copia os nós do snapshot com
+ *   snapshot_copiar_para_trie; o snapshot é fechado em seguida.
+ * - Em falha, descarta a arena com os nós já copiados.
+ */
+dicionario* dicionario_carregar_snapshot(const char* caminho) {
+    snapshot* s = snapshot_abrir(caminho);
+    if (!s) {
+        return NULL;
+    }
+
+    dicionario* dicionario = calloc(1, sizeof *dicionario);
+    arena_nos* arena = arena_criar(0);
+    no_trie* raiz = arena ? snapshot_copiar_para_trie(s, arena) : NULL;
+    size_t total = s->total_palavras;
+    snapshot_fechar(s);
+
+    if (!dicionario || !raiz) {
+        arena_destruir(arena);
+        free(dicionario);
+        return NULL;
+    }
+
+    dicionario->arena = arena;
+    dicionario->raiz = raiz;
+    dicionario->total_palavras = total;
+    return dicionario;
+}
+
+/*
+ * Implementação:
+ * - Reaplica um registro do diário pelo mesmo caminho das alterações,
+ *   ainda sem persistência (nada é registrado de novo).
+ * - Só interrompe a reaplicação em uma palavra maior que o limite de
+ *   letras, que nenhuma alteração teria registrado (diário inválido).
+ */
+static bool reaplicar_registro(operacao_diario operacao,
+                               const char* palavra,
+                               uint32_t peso,
+                               void* contexto) {
+    if (strlen(palavra) > NORMALIZACAO_MAX_LETRAS) {
+        return false;
+    }
+
+    alterar_palavra(contexto,
+                    palavra,
+                    operacao != DIARIO_REMOVER,
+                    operacao == DIARIO_ADICIONAR_COM_PESO ? &peso : NULL);
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Carrega o snapshot se o arquivo existir (um arquivo inválido é
+ *   erro, para não ser sobrescrito por uma consolidação); do
+ *   contrário, cria um dicionário vazio.
+ * - Abre o diário, reaplicando seus registros, e só então liga a
+ *   persistência.
+ * - Consolida logo se o diário reaplicado já passou do limite.
+ */
+dicionario* dicionario_abrir_persistente(const char* caminho_snapshot,
+                                         const char* caminho_diario,
+                                         size_t lote,
+                                         size_t limite) {
+    if (!caminho_snapshot || !caminho_diario) {
+        return NULL;
+    }
+
+    dicionario* dicionario = NULL;
+    if (access(caminho_snapshot, F_OK) == 0) {
+        dicionario = dicionario_carregar_snapshot(caminho_snapshot);
+    } else {
+        dicionario = dicionario_criar();
+    }
+    if (!dicionario) {
+        return NULL;
+    }
+
+    struct persistencia_dicionario* p = calloc(1, sizeof *p);
+    if (p) {
+        p->limite = limite;
+        p->caminho_snapshot = string_dup(caminho_snapshot);
+        p->diario = p->caminho_snapshot ? diario_abrir(caminho_diario,
+                                                        lote,
+                                                        reaplicar_registro,
+                                                        dicionario)
+                                        : NULL;
+    }
+    if (!p || !p->diario) {
+        free(p ? p->caminho_snapshot : NULL);
+        free(p);
+        dicionario_destruir(dicionario);
+        return NULL;
+    }
+
+    dicionario->persistencia = p;
+    if (limite > 0 && p->diario->registros >= limite) {
+        consolidar(dicionario);
+    }
+    return dicionario;
+}
+
+/*
+ * Implementação:
+ * - Sincroniza o diário sob o mutex de escrita, se houver.
+ * - Falha também se alguma alteração não chegou ao diário nem ao
+ *   snapshot desde a última consolidação.
+ */
+bool dicionario_sincronizar(dicionario* dicionario) {
+    if (!dicionario || !dicionario->persistencia) {
+        return false;
+    }
+
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (c) {
+        pthread_mutex_lock(&c->escrita);
+    }
+    bool ok = diario_sincronizar(dicionario->persistencia->diario) &&
+              !dicionario->persistencia->falhou;
+    if (c) {
+        pthread_mutex_unlock(&c->escrita);
+    }
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Consolida sob o mutex de escrita, se houver.
+ */
+bool dicionario_consolidar(dicionario* dicionario) {
+    if (!dicionario || !dicionario->persistencia) {
+        return false;
+    }
+
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (c) {
+        pthread_mutex_lock(&c->escrita);
+    }
+    bool ok = consolidar(dicionario);
+    if (c) {
+        pthread_mutex_unlock(&c->escrita);
+    }
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Serializa a trie do dicionário no formato de snapshot.
+ * - Com outro motor, serializa uma trie temporária.
+ * - O total de palavras é a contagem da versão serializada: no modo
+ *   concorrente, total_palavras só é alterado sob o mutex de escrita
+ *   e pode não corresponder à raiz obtida na seção de leitura.
+ */
+bool dicionario_salvar_snapshot(const dicionario* dicionario,
+                                const char* caminho) {
+    if (!dicionario || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+
+    if (dicionario->motor) {
+        arena_nos* arena = arena_criar(0);
+        no_trie* raiz = arena ? trie_de_motor(dicionario->motor, arena) : NULL;
+        bool salvou =
+            raiz && snapshot_salvar(
+                        raiz, trie_contar_prefixo(raiz, NULL), caminho);
+        arena_destruir(arena);
+        return salvou;
+    }
+
+    size_t vaga = 0;
+    const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+    bool salvou =
+        snapshot_salvar(raiz, trie_contar_prefixo(raiz, NULL), caminho);
+    leitura_finalizar(dicionario, vaga);
+    return salvou;
+}
+
+/*
+ * Implementação:
+ * - Dicionários abertos de snapshot ou congelados são somente leitura.
+ */
+bool dicionario_somente_leitura(const dicionario* dicionario) {
+    return dicionario && (dicionario->snapshot || dicionario->dawg);
+}
+
+/*
+ * Implementação:
+ * - Constrói o autômato a partir da trie e só então libera a arena
+ *   (e com ela todos os nós), de modo que uma falha na construção
+ *   deixa o dicionário intacto.
+ * - Com outro motor, constrói a partir de uma trie temporária e
+ *   libera o motor.
+ * - Compacta antes as remoções adiadas pendentes, cujos nós virariam
+ *   transições sem palavras.
+ */
+bool dicionario_congelar(dicionario* dicionario) {
+    if (!dicionario || dicionario->snapshot || dicionario->concorrencia) {
+        return false;
+    }
+    if (dicionario->dawg) {
+        return true;
+    }
+
+    if (dicionario->motor) {
+        arena_nos* arena = arena_criar(0);
+        no_trie* raiz = arena ? trie_de_motor(dicionario->motor, arena) : NULL;
+        dawg* automato = raiz ? dawg_construir(raiz) : NULL;
+        arena_destruir(arena);
+        if (!automato) {
+            return false;
+        }
+
+        motor_destruir(dicionario->motor);
+        dicionario->motor = NULL;
+        dicionario->dawg = automato;
+        return true;
+    }
+
+    if (dicionario->lixo > 0) {
+        dicionario_compactar(dicionario);
+    }
+
+    dawg* automato = dawg_construir(dicionario->raiz);
+    if (!automato) {
+        return false;
+    }
+
+    arena_destruir(dicionario->arena);
+    dicionario->arena = NULL;
+    dicionario->raiz = NULL;
+    dicionario->dawg = automato;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Snapshots e dicionários congelados já são imutáveis e dispensam
+ *   o modo concorrente; os demais motores não o suportam.
+ * - Compacta antes as remoções adiadas pendentes, que não são mais
+ *   recuperadas depois de a raiz ser publicada.
+ * - Cria o domínio de épocas e o mutex de escrita e move a raiz
+ *   para o campo atômico publicado aos leitores.
+ */
+bool dicionario_ativar_concorrencia(dicionario* dicionario) {
+    if (!dicionario || dicionario->motor) {
+        return false;
+    }
+    if (dicionario_somente_leitura(dicionario) || dicionario->concorrencia) {
+        return true;
+    }
+
+    if (dicionario->lixo > 0) {
+        dicionario_compactar(dicionario);
+    }
+
+    struct concorrencia_dicionario* c = calloc(1, sizeof *c);
+    if (!c) {
+        return false;
+    }
+
+    c->epoca = epoca_criar();
+    if (!c->epoca || pthread_mutex_init(&c->escrita, NULL) != 0) {
+        epoca_destruir(c->epoca, NULL);
+        free(c);
+        return false;
+    }
+
+    atomic_init(&c->raiz, dicionario->raiz);
+    dicionario->raiz = NULL;
+    dicionario->concorrencia = c;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Delega a trie_balancear; fora do modo concorrente, nenhum leitor
+ *   pode estar na Trie.
+ */
+bool dicionario_balancear_irmaos(dicionario* dicionario) {
+    if (!dicionario || !dicionario->raiz) {
+        return false;
+    }
+    return trie_balancear(dicionario->raiz);
+}
+
+/*
+ * Implementação:
+ * - Desligar o modo compacta antes o lixo pendente; uma falha não
+ *   impede a mudança, pois os nós pendentes continuam válidos.
+ */
+bool dicionario_adiar_remocoes(dicionario* dicionario, size_t limite) {
+    if (!dicionario || !dicionario->raiz) {
+        return false;
+    }
+
+    if (limite == 0 && dicionario->lixo > 0) {
+        dicionario_compactar(dicionario);
+    }
+    dicionario->limite_lixo = limite;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Copia a trie para uma arena nova com trie_compactar e libera a
+ *   antiga (com todos os nós mortos) sem percorrê-la.
+ * - Em falha, descarta a arena nova.
+ */
+bool dicionario_compactar(dicionario* dicionario) {
+    if (!dicionario || !dicionario->raiz) {
+        return false;
+    }
+
+    arena_nos* arena = arena_criar(0);
+    if (!arena) {
+        return false;
+    }
+
+    no_trie* raiz = trie_compactar(dicionario->raiz, arena);
+    if (!raiz) {
+        arena_destruir(arena);
+        return false;
+    }
+
+    arena_destruir(dicionario->arena);
+    dicionario->arena = arena;
+    dicionario->raiz = raiz;
+    dicionario->lixo = 0;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Desfaz o modo concorrente, se ativo.
+ * - Libera a arena, e com ela todos os nós da trie, sem percorrê-la.
+ * - Fecha o snapshot e libera o autômato e o motor, se houver.
+ * - Sincroniza e fecha o diário, se houver.
+ * - Liberar estrutura dicionário.
+ */
+void dicionario_destruir(dicionario* dicionario) {
+    if (!dicionario) {
+        return;
+    }
+
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (c) {
+        epoca_destruir(c->epoca, dicionario->arena);
+        pthread_mutex_destroy(&c->escrita);
+        free(c);
+    }
+
+    arena_destruir(dicionario->arena);
+    snapshot_fechar(dicionario->snapshot);
+    dawg_destruir(dicionario->dawg);
+    motor_destruir(dicionario->motor);
+
+    struct persistencia_dicionario* p = dicionario->persistencia;
+    if (p) {
+        diario_fechar(p->diario);
+        free(p->caminho_snapshot);
+        free(p);
+    }
+    free(dicionario);
+}
+
+/*
+ * Implementação:
+ * - Normaliza e valida palavra antes de inserir.
+ * - Insere na árvore trie.
+ * - Se inserção for válida, incrementa quantidade de palavras.
+ */
+bool dicionario_adicionar_palavra(dicionario* dicionario, const char* palavra) {
+    if (!dicionario || !palavra || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+    bool inseriu = false;
+
+    char* palavra_normalizada = normalizar_palavra(palavra);
+    if (!palavra_normalizada) {
+        return inseriu;
+    }
+
+    inseriu = alterar_palavra(dicionario, palavra_normalizada, true, NULL);
+
+    free(palavra_normalizada);
+    return inseriu;
+}
+
+/*
+ * Implementação:
+ * - Normaliza e valida palavra antes de inserir.
+ * - Insere ou atualiza o peso na árvore trie.
+ * - Se a palavra for nova, incrementa quantidade de palavras.
+ */
+bool dicionario_adicionar_palavra_com_peso(dicionario* dicionario,
+                                           const char* palavra,
+                                           uint32_t peso) {
+    if (!dicionario || !palavra || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+
+    char* palavra_normalizada = normalizar_palavra(palavra);
+    if (!palavra_normalizada) {
+        return false;
+    }
+
+    bool inseriu =
+        alterar_palavra(dicionario, palavra_normalizada, true, &peso);
+
+    free(palavra_normalizada);
+    return inseriu;
+}
+
+/*
+ * Implementação:
+ * - Normaliza e valida palavra antes de remover.
+ * - Remove na árvore trie.
+ * - Se remoção for válida, decrementa quantidade de palavras.
+ */
+bool dicionario_remover_palavra(dicionario* dicionario, const char* palavra) {
+    if (!dicionario || !palavra || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+
+    bool removeu = false;
+
+    char* palavra_normalizada = normalizar_palavra(palavra);
+    if (!palavra_normalizada) {
+        return removeu;
+    }
+
+    removeu = alterar_palavra(dicionario, palavra_normalizada, false, NULL);
+
+    free(palavra_normalizada);
+    return removeu;
+}
+
+/*
+ * Implementação:
+ * - Normaliza em um buffer local; apenas palavras que não cabem nele
+ *   usam a cópia no heap de normalizar_palavra.
+ * - Consulta o snapshot, o autômato, o motor ou a trie (dentro de uma
+ *   seção de leitura).
+ */
+bool dicionario_contem(const dicionario* dicionario, const char* palavra) {
+    if (!dicionario || !palavra) {
+        return false;
+    }
+
+    char local[TAM_PALAVRA_LOCAL];
+    char* normalizada = local;
+    size_t tamanho = strlen(palavra);
+    if (tamanho < sizeof local) {
+        if (!normalizar_trecho(palavra, tamanho, local)) {
+            return false;
+        }
+    } else {
+        normalizada = normalizar_palavra(palavra);
+        if (!normalizada) {
+            return false;
+        }
+    }
+
+    bool contem = false;
+    if (dicionario->snapshot) {
+        contem = snapshot_contem(dicionario->snapshot, normalizada);
+    } else if (dicionario->dawg) {
+        contem = dawg_contem(dicionario->dawg, normalizada);
+    } else if (dicionario->motor) {
+        contem = motor_contem(dicionario->motor, normalizada);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        contem = trie_contem(raiz, normalizada);
+        leitura_finalizar(dicionario, vaga);
+    }
+
+    if (normalizada != local) {
+        free(normalizada);
+    }
+    return contem;
+}
+
+/*
+ * Implementação:
+ * - Processa as palavras em grupos de PALAVRAS_POR_LOTE, normalizando
+ *   cada grupo em buffers locais.
+ * - Palavras inválidas ficam sem busca (false); palavras que não cabem
+ *   no buffer local são verificadas uma a uma por dicionario_contem.
+ * - Na trie, cada grupo é verificado em lote, em uma seção de leitura.
+ */
+void dicionario_contem_lote(const dicionario* dicionario,
+                            const char* const* palavras,
+                            size_t n,
+                            bool* resultados) {
+    if (!dicionario || !palavras || !resultados) {
+        return;
+    }
+
+    char buffers[PALAVRAS_POR_LOTE][TAM_PALAVRA_LOCAL];
+    const char* normalizadas[PALAVRAS_POR_LOTE];
+
+    for (size_t inicio = 0; inicio < n; inicio += PALAVRAS_POR_LOTE) {
+        size_t tamanho_grupo =
+            n - inicio < PALAVRAS_POR_LOTE ? n - inicio : PALAVRAS_POR_LOTE;
+
+        for (size_t i = 0; i < tamanho_grupo; i++) {
+            const char* palavra = palavras[inicio + i];
+            size_t tamanho = palavra ? strlen(palavra) : 0;
+            normalizadas[i] = NULL;
+            if (palavra && tamanho < TAM_PALAVRA_LOCAL &&
+                normalizar_trecho(palavra, tamanho, buffers[i])) {
+                normalizadas[i] = buffers[i];
+            }
+        }
+
+        if (dicionario->snapshot) {
+            for (size_t i = 0; i < tamanho_grupo; i++) {
+                resultados[inicio + i] = snapshot_contem(
+                    dicionario->snapshot, normalizadas[i]);
+            }
+        } else if (dicionario->dawg) {
+            for (size_t i = 0; i < tamanho_grupo; i++) {
+                resultados[inicio + i] =
+                    dawg_contem(dicionario->dawg, normalizadas[i]);
+            }
+        } else if (dicionario->motor) {
+            for (size_t i = 0; i < tamanho_grupo; i++) {
+                resultados[inicio + i] =
+                    motor_contem(dicionario->motor, normalizadas[i]);
+            }
+        } else {
+            size_t vaga = 0;
+            const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+            trie_contem_lote(
+                raiz, normalizadas, tamanho_grupo, resultados + inicio);
+            leitura_finalizar(dicionario, vaga);
+        }
+
+        for (size_t i = 0; i < tamanho_grupo; i++) {
+            const char* palavra = palavras[inicio + i];
+            if (palavra && strlen(palavra) >= TAM_PALAVRA_LOCAL) {
+                resultados[inicio + i] = dicionario_contem(dicionario, palavra);
+            }
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Equivale à busca limitada sem limite de resultados.
+ */
+char** dicionario_buscar_por_prefixo(dicionario* dicionario,
+                                     const char* prefixo,
+                                     size_t* quantidade) {
+    return dicionario_buscar_por_prefixo_limitado(
+        dicionario, prefixo, SIZE_MAX, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Consome o cursor copiando até k palavras para um array.
+ * - Retorna NULL se nenhuma palavra for encontrada.
+ */
+static char**
+coletar_cursor(dicionario_cursor* cursor, size_t k, size_t* quantidade) {
+    lista_palavras lista = {0};
+    const char* palavra = NULL;
+
+    while (lista.tamanho < k && (palavra = dicionario_cursor_proximo(cursor))) {
+        if (!lista_push(&lista, palavra)) {
+            trie_liberar_lista(lista.palavras, lista.tamanho);
+            return NULL;
+        }
+    }
 
-#define TAM_LINHA 256
+    if (quantidade) {
+        *quantidade = lista.tamanho;
+    }
+    return lista.palavras;
+}
 
 /*
  * Implementação:
- * - Abre arquivo em modo leitura.
- * - Lê cada linha e armazena em array dinâmico.
- * - Remove caractere newline das linhas.
- * - Ignora linhas vazias.
- * - Retorna array de strings com quantidade total.
+ * - Abre o cursor da trie, do snapshot, do autômato ou do motor,
+ *   conforme o dicionário.
+ * - No modo concorrente, a seção de leitura fica com o cursor. Sem
+ *   vaga livre, o cursor não é aberto: ele não pode prender o mutex
+ *   de escrita enquanto estiver aberto.
  */
-static char** ler_arquivo(const char* caminho, size_t* quantidade) {
-    FILE* arquivo = fopen(caminho, "r");
-    if (!arquivo) {
-        if (quantidade) {
-            *quantidade = 0;
-        }
-        return NULL;
+static bool abrir_cursor_interno(const dicionario* dicionario,
+                                 const char* prefixo,
+                                 dicionario_cursor* cursor) {
+    if (dicionario->snapshot) {
+        cursor->em_snapshot = true;
+        return snapshot_cursor_abrir(
+            &cursor->snapshot, dicionario->snapshot, prefixo);
+    }
+    if (dicionario->dawg) {
+        cursor->em_dawg = true;
+        return dawg_cursor_abrir(&cursor->dawg, dicionario->dawg, prefixo);
+    }
+    if (dicionario->motor) {
+        cursor->em_motor = true;
+        return motor_cursor_abrir(&cursor->motor, dicionario->motor, prefixo);
     }
 
-    char buffer[TAM_LINHA];
-    char** palavras = NULL;
-    size_t contador = 0;
-    size_t capacidade = 10;
-
-    palavras = (char**) malloc(capacidade * sizeof(char*));
-    if (!palavras) {
-        fclose(arquivo);
-        if (quantidade) {
-            *quantidade = 0;
+    cursor->em_snapshot = false;
+    const no_trie* raiz = dicionario->raiz;
+    const struct concorrencia_dicionario* c = dicionario->concorrencia;
+    if (c) {
+        cursor->vaga = epoca_entrar(c->epoca);
+        if (cursor->vaga == EPOCA_SEM_VAGA) {
+            return false;
         }
+        cursor->epoca = c->epoca;
+        raiz = atomic_load(&c->raiz);
+    }
+    return trie_cursor_abrir(&cursor->trie, raiz, prefixo);
+}
+
+/*
+ * Implementação:
+ * - Normaliza e valida palavra antes de buscar por prefixo.
+ * - Busca por prefixo na trie, parando após k palavras.
+ * - Nos demais motores, consome um cursor.
+ */
+char** dicionario_buscar_por_prefixo_limitado(dicionario* dicionario,
+                                              const char* prefixo,
+                                              size_t k,
+                                              size_t* quantidade) {
+    if (!dicionario || !prefixo) {
         return NULL;
     }
 
-    while (fgets(buffer, sizeof(buffer), arquivo)) {
-        buffer[strcspn(buffer, "\n")] = '\0';
+    char* palavra_normalizada = normalizar_palavra(prefixo);
+    if (!palavra_normalizada) {
+        return NULL;
+    }
 
-        if (buffer[0] == '\0') {
-            continue;
+    char** lista = NULL;
+    if (!usa_trie_ternaria(dicionario)) {
+        dicionario_cursor cursor = {0};
+        if (*palavra_normalizada != '\0' && k > 0 &&
+            abrir_cursor_interno(dicionario, palavra_normalizada, &cursor)) {
+            lista = coletar_cursor(&cursor, k, quantidade);
         }
+        dicionario_cursor_fechar(&cursor);
+    } else {
+        size_t vaga = 0;
+        no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        lista = trie_buscar_por_prefixo_limitado(
+            raiz, palavra_normalizada, k, quantidade);
+        leitura_finalizar(dicionario, vaga);
+    }
 
-        if (contador >= capacidade) {
-            capacidade *= 2;
-            char** temp =
-                (char**) realloc((char*) palavras, capacidade * sizeof(char*));
-            if (!temp) {
-                trie_liberar_lista(palavras, contador);
-                fclose(arquivo);
-                if (quantidade) {
-                    *quantidade = 0;
-                }
-                return NULL;
-            }
-            palavras = temp;
-        }
+    free(palavra_normalizada);
+    return lista;
+}
 
-        palavras[contador] = string_dup(buffer);
-        if (!palavras[contador]) {
-            trie_liberar_lista(palavras, contador);
-            fclose(arquivo);
-            if (quantidade) {
-                *quantidade = 0;
-            }
-            return NULL;
-        }
+/*
+ * Implementação:
+ * - O autômato não guarda pesos: falha com quantidade SIZE_MAX.
+ * - Normaliza e valida o prefixo (NULL = todas as palavras).
+ * - Busca na trie (em uma seção de leitura), no snapshot ou no motor.
+ */
+char** dicionario_buscar_por_prefixo_ranqueado(const dicionario* dicionario,
+                                               const char* prefixo,
+                                               size_t k,
+                                               size_t* quantidade) {
+    if (!dicionario || !quantidade) {
+        return NULL;
+    }
 
-        contador++;
+    if (dicionario->dawg) {
+        *quantidade = SIZE_MAX;
+        return NULL;
     }
 
-    fclose(arquivo);
+    char* prefixo_normalizado = normalizar_palavra(prefixo ? prefixo : "");
+    if (!prefixo_normalizado) {
+        return NULL;
+    }
 
-    if (quantidade) {
-        *quantidade = contador;
+    char** lista = NULL;
+    if (dicionario->snapshot) {
+        lista = snapshot_buscar_por_prefixo_ranqueado(
+            dicionario->snapshot, prefixo_normalizado, k, quantidade);
+    } else if (dicionario->motor) {
+        lista = motor_buscar_por_prefixo_ranqueado(
+            dicionario->motor, prefixo_normalizado, k, quantidade);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        lista = trie_buscar_por_prefixo_ranqueado(
+            raiz, prefixo_normalizado, k, quantidade);
+        leitura_finalizar(dicionario, vaga);
     }
 
-    return palavras;
+    free(prefixo_normalizado);
+    return lista;
 }
 
 /*
  * Implementação:
- * - Realiza cópia da string informada.
- * - Realiza trim da cópia.
- * - Converte a cópia para minúsculo.
- * - Verifica se a string final é uma palavra válida.
- * - Se for válida, retorna string final; do contrário, retorna NULL.
+ * - Normaliza e valida a palavra.
+ * - Busca na trie (em uma seção de leitura), no snapshot ou no motor.
  */
-static char* normalizar_palavra(const char* palavra) {
-    char* palavra_normalizada = string_dup(palavra);
+char** dicionario_buscar_aproximado(const dicionario* dicionario,
+                                    const char* palavra,
+                                    size_t max_distancia,
+                                    size_t* quantidade) {
+    if (!dicionario || !palavra || !quantidade) {
+        return NULL;
+    }
 
-    trim(palavra_normalizada);
-    string_para_minusculo(palavra_normalizada);
-    if (!palavra_valida(palavra_normalizada)) {
-        free(palavra_normalizada);
+    char* palavra_normalizada = normalizar_palavra(palavra);
+    if (!palavra_normalizada) {
         return NULL;
     }
 
-    return palavra_normalizada;
+    char** lista = NULL;
+    if (dicionario->snapshot) {
+        lista = snapshot_buscar_aproximado(dicionario->snapshot,
+                                           palavra_normalizada,
+                                           max_distancia,
+                                           quantidade);
+    } else if (dicionario->dawg) {
+        lista = dawg_buscar_aproximado(dicionario->dawg,
+                                       palavra_normalizada,
+                                       max_distancia,
+                                       quantidade);
+    } else if (dicionario->motor) {
+        lista = motor_buscar_aproximado(dicionario->motor,
+                                        palavra_normalizada,
+                                        max_distancia,
+                                        quantidade);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        lista = trie_buscar_aproximado(
+            raiz, palavra_normalizada, max_distancia, quantidade);
+        leitura_finalizar(dicionario, vaga);
+    }
+
+    free(palavra_normalizada);
+    return lista;
 }
 
 /*
  * Implementação:
- * - Aloca estrutura dicionario.
- * - Aloca estrutura trie.
- * - Define quantidade de palavras como 0.
+ * - Copia e normaliza o padrão (curingas são preservados).
+ * - Busca na trie (em uma seção de leitura), no snapshot, no
+ *   autômato ou no motor.
  */
-dicionario* dicionario_criar() {
-    dicionario* dicionario = NULL;
-
-    dicionario = calloc(1, sizeof *dicionario);
-    if (!dicionario) {
+char** dicionario_buscar_padrao(const dicionario* dicionario,
+                                const char* padrao,
+                                size_t* quantidade) {
+    if (!dicionario || !padrao || !quantidade) {
         return NULL;
     }
 
-    dicionario->raiz = trie_criar();
-    if (!dicionario->raiz) {
-        free(dicionario);
-        // cppcheck-suppress memleak ; falso-positivo
+    char* padrao_normalizado = string_dup(padrao);
+    if (!padrao_normalizado) {
+        return NULL;
+    }
+    if (!padrao_normalizar(padrao_normalizado)) {
+        free(padrao_normalizado);
         return NULL;
     }
 
-    // cppcheck-suppress memleak ; falso-positivo
-    return dicionario;
+    char** lista = NULL;
+    if (dicionario->snapshot) {
+        lista = snapshot_buscar_padrao(
+            dicionario->snapshot, padrao_normalizado, quantidade);
+    } else if (dicionario->dawg) {
+        lista = dawg_buscar_padrao(
+            dicionario->dawg, padrao_normalizado, quantidade);
+    } else if (dicionario->motor) {
+        lista = motor_buscar_padrao(
+            dicionario->motor, padrao_normalizado, quantidade);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        lista = trie_buscar_padrao(raiz, padrao_normalizado, quantidade);
+        leitura_finalizar(dicionario, vaga);
+    }
+
+    free(padrao_normalizado);
+    return lista;
 }
 
 /*
  * Implementação:
- * - Libera estrutura trie.
- * - Liberar estrutura dicionário.
+ * - Normaliza e valida o prefixo (NULL = todas as palavras).
+ * - Conta pelo snapshot, pelo autômato, pelo motor ou pela trie (em
+ *   uma seção de leitura).
  */
-void dicionario_destruir(dicionario* dicionario) {
+size_t dicionario_contar_prefixo(const dicionario* dicionario,
+                                 const char* prefixo) {
     if (!dicionario) {
-        return;
+        return 0;
     }
 
-    trie_destruir(dicionario->raiz);
-    free(dicionario);
-}
+    char* prefixo_normalizado = normalizar_palavra(prefixo ? prefixo : "");
+    if (!prefixo_normalizado) {
+        return 0;
+    }
 
-char** dicionario_ler_arquivo(const char* caminho, size_t* quantidade) {
-    return ler_arquivo(caminho, quantidade);
+    size_t total = 0;
+    if (dicionario->snapshot) {
+        total = snapshot_contar_prefixo(dicionario->snapshot,
+                                        prefixo_normalizado);
+    } else if (dicionario->dawg) {
+        total = dawg_contar_prefixo(dicionario->dawg, prefixo_normalizado);
+    } else if (dicionario->motor) {
+        total = motor_contar_prefixo(dicionario->motor, prefixo_normalizado);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        total = trie_contar_prefixo(raiz, prefixo_normalizado);
+        leitura_finalizar(dicionario, vaga);
+    }
+
+    free(prefixo_normalizado);
+    return total;
 }
 
 /*
  * Implementação:
- * - Normaliza e valida palavra antes de inserir.
- * - Insere na árvore trie.
- * - Se inserção for válida, incrementa quantidade de palavras.
+ * - Normaliza e valida a palavra; palavras inválidas resultam em
+ *   SIZE_MAX.
+ * - Calcula pelo snapshot, pelo autômato, pelo motor ou pela trie
+ *   (em uma seção de leitura).
  */
-bool dicionario_adicionar_palavra(dicionario* dicionario, const char* palavra) {
+size_t dicionario_rank(const dicionario* dicionario, const char* palavra) {
     if (!dicionario || !palavra) {
-        return false;
+        return SIZE_MAX;
     }
-    bool inseriu = false;
 
     char* palavra_normalizada = normalizar_palavra(palavra);
     if (!palavra_normalizada) {
-        return inseriu;
+        return SIZE_MAX;
     }
 
-    if (trie_inserir(dicionario->raiz, palavra_normalizada)) {
-        dicionario->total_palavras++;
-        inseriu = true;
+    size_t posicao = 0;
+    if (dicionario->snapshot) {
+        posicao = snapshot_rank(dicionario->snapshot, palavra_normalizada);
+    } else if (dicionario->dawg) {
+        posicao = dawg_rank(dicionario->dawg, palavra_normalizada);
+    } else if (dicionario->motor) {
+        posicao = motor_rank(dicionario->motor, palavra_normalizada);
+    } else {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        posicao = trie_rank(raiz, palavra_normalizada);
+        leitura_finalizar(dicionario, vaga);
     }
 
     free(palavra_normalizada);
-    return inseriu;
+    return posicao;
 }
 
 /*
  * Implementação:
- * - Normaliza e valida palavra antes de remover.
- * - Remove na árvore trie.
- * - Se remoção for válida, decrementa quantidade de palavras.
+ * - Seleciona pelo snapshot, pelo autômato, pelo motor ou pela trie
+ *   (em uma seção de leitura).
  */
-bool dicionario_remover_palavra(dicionario* dicionario, const char* palavra) {
-    if (!dicionario || !palavra) {
-        return false;
+char* dicionario_selecionar(const dicionario* dicionario, size_t k) {
+    if (!dicionario) {
+        return NULL;
     }
 
-    bool removeu = false;
-
-    char* palavra_normalizada = normalizar_palavra(palavra);
-    if (!palavra_normalizada) {
-        return removeu;
+    if (dicionario->snapshot) {
+        return snapshot_selecionar(dicionario->snapshot, k);
+    }
+    if (dicionario->dawg) {
+        return dawg_selecionar(dicionario->dawg, k);
+    }
+    if (dicionario->motor) {
+        return motor_selecionar(dicionario->motor, k);
     }
 
-    trim(palavra_normalizada);
-    string_para_minusculo(palavra_normalizada);
-    if (!palavra_valida(palavra_normalizada)) {
-        free(palavra_normalizada);
-        return removeu;
+    size_t vaga = 0;
+    const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+    char* palavra = trie_selecionar(raiz, k);
+    leitura_finalizar(dicionario, vaga);
+    return palavra;
+}
+
+/*
+ * Implementação:
+ * - Realiza listagem das palavras na trie.
+ * - Nos demais motores, consome um cursor sem prefixo.
+ */
+char** dicionario_listar_palavras(dicionario* dicionario, size_t* quantidade) {
+    if (!dicionario) {
+        return NULL;
     }
 
-    if (trie_remover(dicionario->raiz, palavra_normalizada)) {
-        dicionario->total_palavras--;
-        removeu = true;
+    if (usa_trie_ternaria(dicionario)) {
+        size_t vaga = 0;
+        no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        char** lista = trie_listar_palavras(raiz, quantidade);
+        leitura_finalizar(dicionario, vaga);
+        return lista;
     }
 
-    free(palavra_normalizada);
-    return removeu;
+    dicionario_cursor cursor;
+    char** lista = NULL;
+    if (dicionario_cursor_abrir(dicionario, NULL, &cursor)) {
+        lista = coletar_cursor(&cursor, SIZE_MAX, quantidade);
+    }
+    dicionario_cursor_fechar(&cursor);
+    return lista;
 }
 
 /*
  * Implementação:
- * - Normaliza e valida palavra antes de buscar por prefixo.
- * - Busca por prefixo na trie.
+ * - Normaliza e valida o prefixo, se houver.
+ * - Abre o cursor interno; o prefixo é copiado pelo próprio cursor.
  */
-char** dicionario_buscar_por_prefixo(dicionario* dicionario,
-                                     const char* prefixo,
-                                     size_t* quantidade) {
+bool dicionario_cursor_abrir(dicionario* dicionario,
+                             const char* prefixo,
+                             dicionario_cursor* cursor) {
+    if (!cursor) {
+        return false;
+    }
+    *cursor = (dicionario_cursor){0};
+
     if (!dicionario) {
-        return NULL;
+        return false;
+    }
+
+    if (!prefixo) {
+        return abrir_cursor_interno(dicionario, NULL, cursor);
     }
 
     char* palavra_normalizada = normalizar_palavra(prefixo);
     if (!palavra_normalizada) {
-        return NULL;
+        return false;
     }
 
-    char** lista = trie_buscar_por_prefixo(
-        dicionario->raiz, palavra_normalizada, quantidade);
+    bool abriu = false;
+    if (*palavra_normalizada != '\0') {
+        abriu = abrir_cursor_interno(dicionario, palavra_normalizada, cursor);
+    }
 
     free(palavra_normalizada);
-    return lista;
+    return abriu;
 }
 
 /*
  * Implementação:
- * - Realiza listagem das palavras na trie.
+ * - Delega ao cursor interno.
  */
-char** dicionario_listar_palavras(dicionario* dicionario, size_t* quantidade) {
-    if (!dicionario) {
-        return NULL;
+const char* dicionario_cursor_proximo(dicionario_cursor* cursor) {
+    if (cursor->em_snapshot) {
+        return snapshot_cursor_proximo(&cursor->snapshot);
+    }
+    if (cursor->em_dawg) {
+        return dawg_cursor_proximo(&cursor->dawg);
+    }
+    if (cursor->em_motor) {
+        return motor_cursor_proximo(&cursor->motor);
+    }
+    return trie_cursor_proximo(&cursor->trie);
+}
+
+/*
+ * Implementação:
+ * - Delega ao cursor interno.
+ * - Encerra a seção de leitura do modo concorrente, se houver.
+ */
+void dicionario_cursor_fechar(dicionario_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    if (cursor->em_snapshot) {
+        snapshot_cursor_fechar(&cursor->snapshot);
+    } else if (cursor->em_dawg) {
+        dawg_cursor_fechar(&cursor->dawg);
+    } else if (cursor->em_motor) {
+        motor_cursor_fechar(&cursor->motor);
+    } else {
+        trie_cursor_fechar(&cursor->trie);
+    }
+
+    if (cursor->epoca) {
+        epoca_sair(cursor->epoca, cursor->vaga);
+        cursor->epoca = NULL;
     }
-    return trie_listar_palavras(dicionario->raiz, quantidade);
 }
 
 /*
  * Implementação:
- * - Lê todas as palavras que estão contidas no arquivo (1 por linha).
- * - Adiciona as palavras que são válidas.
+ * - Percorre o arquivo mapeado em memória (1 palavra por linha).
+ * - Adiciona as palavras que são válidas à medida que são lidas.
  */
 // cppcheck-suppress constParameterPointer
 bool dicionario_adicionar_de_arquivo(dicionario* dicionario,
                                      const char* caminho) {
-    if (!dicionario || !caminho) {
+    if (!dicionario || !caminho || dicionario_somente_leitura(dicionario)) {
         return false;
     }
 
-    size_t quantidade = 0;
-    char** palavras = ler_arquivo(caminho, &quantidade);
+    return percorrer_arquivo(caminho, false, adicionar_normalizada, dicionario);
+}
+
+/*
+ * Implementação:
+ * - Percorre o arquivo mapeado em memória (palavra<TAB>peso por linha).
+ * - Adiciona as palavras válidas com seus pesos à medida que são lidas.
+ */
+// cppcheck-suppress constParameterPointer
+bool dicionario_adicionar_de_arquivo_com_peso(dicionario* dicionario,
+                                              const char* caminho) {
+    if (!dicionario || !caminho || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+
+    return percorrer_arquivo(caminho, true, adicionar_normalizada, dicionario);
+}
+
+/*
+ * Implementação:
+ * - Coleta as palavras válidas do arquivo, já normalizadas, em um
+ *   único buffer de texto.
+ * - Ordena ponteiros para essas palavras, remove duplicatas e
+ *   insere em ordem mediana primeiro.
+ */
+// cppcheck-suppress constParameterPointer
+bool dicionario_adicionar_de_arquivo_balanceado(dicionario* dicionario,
+                                                const char* caminho) {
+    if (!dicionario || !caminho || dicionario_somente_leitura(dicionario)) {
+        return false;
+    }
+
+    colecao_palavras colecao = {0};
+    if (!percorrer_arquivo(caminho, false, coletar_normalizada, &colecao)) {
+        free(colecao.texto);
+        return false;
+    }
+
+    size_t unicas = 0;
+    char** palavras = ordenar_colecao(&colecao, &unicas);
     if (!palavras) {
+        free(colecao.texto);
+        return false;
+    }
+
+    inserir_mediana_primeiro(dicionario, palavras, 0, unicas);
+
+    free((void*) palavras);
+    free(colecao.texto);
+    return !persistencia_falhou(dicionario);
+}
+
+/*
+ * Implementação:
+ * - Mapeia o arquivo e separa as linhas por primeira letra.
+ * - Desliga as subárvores de primeiro nível já existentes, para que
+ *   cada letra seja estendida por uma única thread.
+ * - Dispara as threads (a thread atual também trabalha).
+ * - Religa as subárvores sob a sentinela, transfere as arenas das
+ *   threads para a do dicionário e atualiza o total de palavras.
+ * - No modo concorrente, as subárvores publicadas não podem ser
+ *   desligadas; a carga passa a ser sequencial, assim como nos demais
+ *   motores e nos dicionários persistentes (cujas palavras precisam
+ *   passar pelo diário).
+ */
+// cppcheck-suppress constParameterPointer
+bool dicionario_adicionar_de_arquivo_paralelo(dicionario* dicionario,
+                                              const char* caminho,
+                                              size_t threads) {
+    if (!dicionario || !caminho || dicionario_somente_leitura(dicionario)) {
         return false;
     }
 
-    for (size_t i = 0; i < quantidade; i++) {
-        dicionario_adicionar_palavra(dicionario, palavras[i]);
+    if (dicionario->concorrencia || dicionario->motor ||
+        dicionario->persistencia) {
+        return dicionario_adicionar_de_arquivo(dicionario, caminho);
+    }
+
+    if (threads == 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = nucleos > 0 ? (size_t) nucleos : 1;
+    }
+    if (threads > TOTAL_LETRAS) {
+        threads = TOTAL_LETRAS;
+    }
+
+    arquivo_mapeado arquivo;
+    if (!arquivo_mapear(caminho, true, &arquivo)) {
+        return false;
+    }
+
+    fatia_linhas fatias[TOTAL_LETRAS] = {0};
+    trabalhador_carga* trabalhadores = calloc(threads, sizeof *trabalhadores);
+    pthread_t* ids = calloc(threads, sizeof *ids);
+    bool* iniciadas = calloc(threads, sizeof *iniciadas);
+    bool ok = trabalhadores && ids && iniciadas &&
+              separar_linhas(&arquivo, fatias);
+
+    for (size_t i = 0; ok && i < threads; i++) {
+        trabalhadores[i].arena = arena_criar(0);
+        ok = trabalhadores[i].arena != NULL;
+    }
+
+    if (ok) {
+        no_trie* raizes[TOTAL_LETRAS] = {0};
+        size_t inseridas[TOTAL_LETRAS] = {0};
+        atomic_size_t proxima_letra = 0;
+
+        separar_raizes(dicionario->raiz->no_meio, raizes);
+
+        for (size_t i = 0; i < threads; i++) {
+            trabalhadores[i].arquivo = &arquivo;
+            trabalhadores[i].fatias = fatias;
+            trabalhadores[i].raizes = raizes;
+            trabalhadores[i].inseridas = inseridas;
+            trabalhadores[i].proxima_letra = &proxima_letra;
+            trabalhadores[i].balanceada = dicionario->raiz->altura != 0;
+        }
+        for (size_t i = 1; i < threads; i++) {
+            iniciadas[i] = pthread_create(&ids[i],
+                                          NULL,
+                                          carregar_letras,
+                                          &trabalhadores[i]) == 0;
+        }
+        carregar_letras(&trabalhadores[0]);
+
+        size_t presentes = 0;
+        for (size_t i = 0; i < threads; i++) {
+            if (iniciadas[i]) {
+                pthread_join(ids[i], NULL);
+            }
+            ok = ok && !trabalhadores[i].falhou;
+        }
+        for (size_t letra = 0; letra < TOTAL_LETRAS; letra++) {
+            dicionario->total_palavras += inseridas[letra];
+            if (raizes[letra]) {
+                raizes[presentes++] = raizes[letra];
+            }
+        }
+        dicionario->raiz->no_meio = ligar_raizes(raizes, 0, presentes);
+        trie_recalcular_agregados(dicionario->raiz);
+    }
+
+    for (size_t i = 0; trabalhadores && i < threads; i++) {
+        if (trabalhadores[i].arena) {
+            arena_absorver(dicionario->arena, trabalhadores[i].arena);
+            arena_destruir(trabalhadores[i].arena);
+        }
+    }
+    for (size_t letra = 0; letra < TOTAL_LETRAS; letra++) {
+        free(fatias[letra].inicios);
+    }
+    free(iniciadas);
+    free((void*) ids);
+    free(trabalhadores);
+    arquivo_desmapear(&arquivo);
+    return ok;
+}
+
+/*
+ * Implementação:
+ * - Delega a medição à trie, dentro de uma seção de leitura.
+ * - Em um snapshot e nos demais motores, usa a profundidade medida
+ *   pela varredura completa.
+ * - Um dicionário congelado não tem trie: mede 0.
+ */
+void dicionario_medir_caminhos(const dicionario* dicionario,
+                               double* media,
+                               size_t* maximo) {
+    if (!dicionario) {
+        trie_medir_caminhos(NULL, media, maximo);
+        return;
+    }
+
+    if (dicionario->snapshot || dicionario->motor) {
+        estatisticas_trie e;
+        if (dicionario->snapshot) {
+            snapshot_coletar_estatisticas(dicionario->snapshot, &e);
+        } else {
+            motor_coletar_estatisticas(dicionario->motor, &e);
+        }
+        if (media) {
+            *media = e.profundidade_media;
+        }
+        if (maximo) {
+            *maximo = e.profundidade_maxima;
+        }
+        return;
+    }
+
+    size_t vaga = 0;
+    const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+    trie_medir_caminhos(raiz, media, maximo);
+    leitura_finalizar(dicionario, vaga);
+}
+
+/*
+ * Implementação:
+ * - Em um snapshot, nós e bytes vêm do arquivo mapeado; em um
+ *   dicionário congelado, dos estados e transições do autômato; nos
+ *   demais motores, das medidas do motor.
+ * - Do contrário, vêm da arena; no modo concorrente, os contadores
+ *   são lidos sob o mutex de escrita, e nós aposentados ainda não
+ *   liberados também são contados.
+ * - A varredura percorre a versão atual dentro de uma seção de leitura
+ *   ou os nós do snapshot. O autômato não é uma trie e não é varrido.
+ */
+bool dicionario_estatisticas(const dicionario* dicionario,
+                             estatisticas_dicionario* estatisticas,
+                             bool varredura) {
+    if (!dicionario || !estatisticas) {
+        return false;
+    }
+
+    *estatisticas = (estatisticas_dicionario){0};
+    struct concorrencia_dicionario* c = dicionario->concorrencia;
+
+    if (dicionario->snapshot) {
+        estatisticas->nos = dicionario->snapshot->total_nos;
+        estatisticas->bytes_usados =
+            dicionario->snapshot->total_nos * sizeof(no_snapshot);
+        estatisticas->bytes_reservados =
+            dicionario->snapshot->arquivo.tamanho;
+        estatisticas->palavras = dicionario->total_palavras;
+    } else if (dicionario->dawg) {
+        estatisticas->nos = dicionario->dawg->total_estados;
+        estatisticas->bytes_usados =
+            dicionario->dawg->total_transicoes *
+            (sizeof(transicao_dawg) + sizeof *dicionario->dawg->contagens);
+        estatisticas->bytes_reservados = estatisticas->bytes_usados;
+        estatisticas->palavras = dicionario->total_palavras;
+    } else if (dicionario->motor) {
+        medidas_motor medidas;
+        motor_medir(dicionario->motor, &medidas);
+        estatisticas->nos = medidas.nos;
+        estatisticas->bytes_usados = medidas.bytes_usados;
+        estatisticas->bytes_reservados = medidas.bytes_reservados;
+        estatisticas->palavras = dicionario->total_palavras;
+    } else {
+        if (c) {
+            pthread_mutex_lock(&c->escrita);
+        }
+        estatisticas->nos = dicionario->arena->nos_ativos;
+        estatisticas->bytes_usados =
+            dicionario->arena->nos_ativos * sizeof(no_trie);
+        estatisticas->bytes_reservados =
+            arena_bytes_reservados(dicionario->arena);
+        estatisticas->palavras = dicionario->total_palavras;
+        if (c) {
+            pthread_mutex_unlock(&c->escrita);
+        }
+    }
+
+    if (estatisticas->nos > 0) {
+        estatisticas->proporcao_terminais =
+            (double) estatisticas->palavras / (double) estatisticas->nos;
+    }
+
+    if (varredura && dicionario->snapshot) {
+        snapshot_coletar_estatisticas(dicionario->snapshot,
+                                      &estatisticas->varredura);
+        estatisticas->completo = true;
+    } else if (varredura && dicionario->motor) {
+        motor_coletar_estatisticas(dicionario->motor,
+                                   &estatisticas->varredura);
+        estatisticas->completo = true;
+    } else if (varredura && !dicionario_somente_leitura(dicionario)) {
+        size_t vaga = 0;
+        const no_trie* raiz = leitura_iniciar(dicionario, &vaga);
+        trie_coletar_estatisticas(raiz, &estatisticas->varredura);
+        leitura_finalizar(dicionario, vaga);
+        estatisticas->completo = true;
     }
 
-    trie_liberar_lista(palavras, quantidade);
     return true;
 }
 
 /*
  * Implementação:
- * - Lê todas as palavras que estão contidas no arquivo (1 por linha).
- * - Remove as palavras que são válidas.
+ * - Coleta as palavras válidas do arquivo (1 palavra por linha), já
+ *   normalizadas, em um único buffer de texto.
+ * - Ordena e remove as duplicatas; a remoção percorre a Trie uma
+ *   única vez (remover_ordenadas).
  */
 // cppcheck-suppress constParameterPointer
 bool dicionario_remover_de_arquivo(dicionario* dicionario,
                                    const char* caminho) {
-    if (!dicionario || !caminho) {
+    if (!dicionario || !caminho || dicionario_somente_leitura(dicionario)) {
         return false;
     }
 
-    size_t quantidade = 0;
-    char** palavras = ler_arquivo(caminho, &quantidade);
+    colecao_palavras colecao = {0};
+    if (!percorrer_arquivo(caminho, false, coletar_normalizada, &colecao)) {
+        free(colecao.texto);
+        return false;
+    }
+
+    size_t unicas = 0;
+    char** palavras = ordenar_colecao(&colecao, &unicas);
     if (!palavras) {
+        free(colecao.texto);
         return false;
     }
 
-    for (size_t i = 0; i < quantidade; i++) {
-        dicionario_remover_palavra(dicionario, palavras[i]);
+    size_t removidas = remover_ordenadas(dicionario, palavras, unicas);
+
+    free((void*) palavras);
+    free(colecao.texto);
+    return removidas != SIZE_MAX;
+}
+
+/*
+ * Implementação:
+ * - Normaliza cada palavra em um buffer reutilizado e coleta as
+ *   válidas, como em dicionario_remover_de_arquivo.
+ * - Ordena, remove as duplicatas e remove todas de uma vez.
+ */
+size_t dicionario_remover_lote(dicionario* dicionario,
+                               const char* const* palavras,
+                               size_t quantidade) {
+    if (!dicionario || !palavras || dicionario_somente_leitura(dicionario)) {
+        return 0;
     }
 
-    trie_liberar_lista(palavras, quantidade);
-    return true;
+    colecao_palavras colecao = {0};
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    bool ok = true;
+    for (size_t i = 0; ok && i < quantidade; i++) {
+        if (!palavras[i]) {
+            continue;
+        }
+
+        size_t tamanho = strlen(palavras[i]);
+        ok = garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 1);
+        if (ok && normalizar_trecho(palavras[i], tamanho, buffer) &&
+            buffer[0] != '\0') {
+            ok = coletar_normalizada(buffer, NULL, &colecao);
+        }
+    }
+    free(buffer);
+
+    size_t unicas = 0;
+    char** ordenadas = ok ? ordenar_colecao(&colecao, &unicas) : NULL;
+    size_t removidas = 0;
+    if (ordenadas) {
+        removidas = remover_ordenadas(dicionario, ordenadas, unicas);
+    }
+
+    free((void*) ordenadas);
+    free(colecao.texto);
+    return removidas;
 }
@@ -0,0 +1,147 @@
+/**
+ * @file distancia.c
+ * @brief Implementação da busca por distância de edição limitada.
+ */
+
+#include "distancia.h"
+
+#include "trie.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Implementação:
+ * - Garante espaço para 'linhas' linhas e para o prefixo
+ *   correspondente, dobrando as capacidades.
+ */
+static bool garantir_linhas(busca_aproximada* busca, size_t linhas) {
+    if (linhas > busca->capacidade_linhas) {
+        size_t nova_cap = busca->capacidade_linhas * 2;
+        while (nova_cap < linhas) {
+            nova_cap *= 2;
+        }
+        size_t* tmp = realloc(busca->linhas,
+                              nova_cap * (busca->tamanho + 1) * sizeof *tmp);
+        if (!tmp) {
+            return false;
+        }
+        busca->linhas = tmp;
+        busca->capacidade_linhas = nova_cap;
+    }
+
+    return garantir_tamanho_buffer(
+        &busca->prefixo, &busca->capacidade_prefixo, linhas);
+}
+
+/*
+ * Implementação:
+ * - Reserva linhas para palavras até max_distancia além do tamanho
+ *   procurado (além disso o percurso é sempre podado).
+ * - A linha 0 é a distância do prefixo vazio: j inserções.
+ */
+bool busca_aproximada_iniciar(busca_aproximada* busca,
+                              const char* palavra,
+                              size_t max_distancia) {
+    *busca = (busca_aproximada){
+        .palavra = palavra,
+        .tamanho = strlen(palavra),
+        .max_distancia = max_distancia,
+        .capacidade_linhas = 1,
+    };
+
+    size_t linhas = busca->tamanho + 2;
+    if (max_distancia < 64) {
+        linhas += max_distancia;
+    }
+
+    busca->linhas = malloc((busca->tamanho + 1) * sizeof *busca->linhas);
+    if (!busca->linhas || !garantir_linhas(busca, linhas)) {
+        busca->falhou = true;
+        return false;
+    }
+
+    for (size_t j = 0; j <= busca->tamanho; j++) {
+        busca->linhas[j] = j;
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Recorrência usual de Levenshtein sobre a linha anterior:
+ *   remoção (acima), inserção (à esquerda) e substituição (diagonal).
+ */
+size_t busca_aproximada_avancar(busca_aproximada* busca,
+                                size_t profundidade,
+                                char caractere) {
+    if (busca->falhou || !garantir_linhas(busca, profundidade + 2)) {
+        busca->falhou = true;
+        return SIZE_MAX;
+    }
+
+    size_t colunas = busca->tamanho + 1;
+    const size_t* anterior = busca->linhas + (profundidade * colunas);
+    size_t* atual = busca->linhas + ((profundidade + 1) * colunas);
+    busca->prefixo[profundidade] = caractere;
+
+    atual[0] = anterior[0] + 1;
+    size_t minimo = atual[0];
+    for (size_t j = 1; j < colunas; j++) {
+        size_t custo = busca->palavra[j - 1] != caractere;
+        size_t valor = anterior[j] + 1;
+        if (atual[j - 1] + 1 < valor) {
+            valor = atual[j - 1] + 1;
+        }
+        if (anterior[j - 1] + custo < valor) {
+            valor = anterior[j - 1] + custo;
+        }
+        atual[j] = valor;
+        if (valor < minimo) {
+            minimo = valor;
+        }
+    }
+
+    return minimo;
+}
+
+/*
+ * Implementação:
+ * - A distância do prefixo é a última posição da sua linha.
+ */
+void busca_aproximada_aceitar(busca_aproximada* busca, size_t profundidade) {
+    if (busca->falhou) {
+        return;
+    }
+
+    size_t colunas = busca->tamanho + 1;
+    size_t distancia =
+        busca->linhas[(profundidade * colunas) + busca->tamanho];
+    if (distancia > busca->max_distancia) {
+        return;
+    }
+
+    busca->prefixo[profundidade] = '\0';
+    if (!lista_push(&busca->resultado, busca->prefixo)) {
+        busca->falhou = true;
+    }
+}
+
+/*
+ * Implementação:
+ * - Libera linhas e prefixo; em falha, libera também o resultado.
+ */
+char** busca_aproximada_concluir(busca_aproximada* busca, size_t* quantidade) {
+    free(busca->linhas);
+    free(busca->prefixo);
+
+    if (busca->falhou) {
+        trie_liberar_lista(busca->resultado.palavras, busca->resultado.tamanho);
+        *quantidade = 0;
+        return NULL;
+    }
+
+    *quantidade = busca->resultado.tamanho;
+    return busca->resultado.palavras;
+}
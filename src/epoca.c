@@ -0,0 +1,207 @@
+/**
+ * @file epoca.c
+ * @brief Implementação da recuperação de nós baseada em épocas.
+ */
+
+#include "epoca.h"
+
+#include "trie.h"
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EPOCA_INATIVA UINT64_MAX
+#define TAM_LINHA_CACHE 64
+
+/**
+ * @struct vaga_leitor
+ * @brief Época observada por um leitor ativo (ou EPOCA_INATIVA).
+ *
+ * Cada vaga ocupa sua própria linha de cache, para que leitores em
+ * núcleos diferentes não disputem a mesma linha.
+ */
+typedef struct vaga_leitor {
+    alignas(TAM_LINHA_CACHE) _Atomic uint64_t epoca;
+} vaga_leitor;
+
+/**
+ * @struct lista_nos
+ * @brief Vetor dinâmico de nós aposentados.
+ */
+typedef struct lista_nos {
+    no_trie** nos;
+    size_t quantidade;
+    size_t capacidade;
+} lista_nos;
+
+/**
+ * @struct epoca_dominio
+ * @brief Época global, vagas de leitores e nós aposentados.
+ *
+ * Os nós aposentados na época 'e' ficam em limbo[e % 3] e são
+ * liberados quando a época global chega a e + 2.
+ */
+struct epoca_dominio {
+    vaga_leitor vagas[EPOCA_MAX_LEITORES];
+    _Atomic uint64_t global;
+    lista_nos pendentes;
+    lista_nos limbo[3];
+};
+
+static atomic_size_t proximo_leitor;
+static _Thread_local size_t id_leitor = SIZE_MAX;
+
+/*
+ * Implementação:
+ * - Dobra a capacidade quando cheia.
+ */
+static bool lista_nos_push(lista_nos* lista, no_trie* no) {
+    if (lista->quantidade == lista->capacidade) {
+        size_t nova_cap = lista->capacidade ? lista->capacidade * 2 : 64;
+        no_trie** tmp = realloc(lista->nos, nova_cap * sizeof *lista->nos);
+        if (!tmp) {
+            return false;
+        }
+        lista->nos = tmp;
+        lista->capacidade = nova_cap;
+    }
+
+    lista->nos[lista->quantidade++] = no;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Devolve todos os nós da lista e a esvazia, mantendo a capacidade.
+ */
+static void lista_nos_liberar(lista_nos* lista, arena_nos* arena) {
+    for (size_t i = 0; i < lista->quantidade; i++) {
+        if (arena) {
+            arena_liberar_no(arena, lista->nos[i]);
+        } else {
+            free(lista->nos[i]);
+        }
+    }
+    lista->quantidade = 0;
+}
+
+/*
+ * Implementação:
+ * - Usa aligned_alloc para respeitar o alinhamento das vagas; o
+ *   tamanho da estrutura já é múltiplo desse alinhamento.
+ */
+epoca_dominio* epoca_criar(void) {
+    epoca_dominio* dominio =
+        aligned_alloc(TAM_LINHA_CACHE, sizeof(epoca_dominio));
+    if (!dominio) {
+        return NULL;
+    }
+
+    memset(dominio, 0, sizeof *dominio);
+    for (size_t i = 0; i < EPOCA_MAX_LEITORES; i++) {
+        atomic_init(&dominio->vagas[i].epoca, EPOCA_INATIVA);
+    }
+    atomic_init(&dominio->global, 0);
+    return dominio;
+}
+
+/*
+ * Implementação:
+ * - Sem leitores, todos os nós em limbo podem ser devolvidos; os
+ *   pendentes ainda estão publicados e são mantidos.
+ */
+void epoca_destruir(epoca_dominio* dominio, arena_nos* arena) {
+    if (!dominio) {
+        return;
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        lista_nos_liberar(&dominio->limbo[i], arena);
+        free(dominio->limbo[i].nos);
+    }
+    free(dominio->pendentes.nos);
+    free(dominio);
+}
+
+/*
+ * Implementação:
+ * - Cada thread recebe um identificador na primeira leitura e começa
+ *   a procurar vaga a partir dele; sem colisões, a primeira troca
+ *   atômica sempre tem sucesso.
+ * - Tenta cada vaga uma única vez; se todas estiverem ocupadas,
+ *   retorna EPOCA_SEM_VAGA.
+ * - A vaga recebe a época lida antes da troca. Uma época atrasada só
+ *   torna a recuperação mais conservadora, pois a raiz é lida depois.
+ */
+size_t epoca_entrar(epoca_dominio* dominio) {
+    if (id_leitor == SIZE_MAX) {
+        id_leitor = atomic_fetch_add(&proximo_leitor, 1);
+    }
+
+    size_t vaga = id_leitor % EPOCA_MAX_LEITORES;
+    for (size_t i = 0; i < EPOCA_MAX_LEITORES; i++) {
+        uint64_t esperado = EPOCA_INATIVA;
+        uint64_t atual = atomic_load(&dominio->global);
+        if (atomic_compare_exchange_strong(
+                &dominio->vagas[vaga].epoca, &esperado, atual)) {
+            return vaga;
+        }
+        vaga = (vaga + 1) % EPOCA_MAX_LEITORES;
+    }
+    return EPOCA_SEM_VAGA;
+}
+
+/*
+ * Implementação:
+ * - Libera a vaga; publicação com release encerra as leituras.
+ */
+void epoca_sair(epoca_dominio* dominio, size_t vaga) {
+    atomic_store_explicit(
+        &dominio->vagas[vaga].epoca, EPOCA_INATIVA, memory_order_release);
+}
+
+/*
+ * Implementação:
+ * - Apenas acumula o nó na lista de pendentes.
+ */
+void epoca_aposentar(no_trie* no, void* dominio) {
+    epoca_dominio* d = dominio;
+    lista_nos_push(&d->pendentes, no);
+}
+
+/*
+ * Implementação:
+ * - Move os pendentes para o limbo da época atual.
+ * - Avança a época se todo leitor ativo já a observou; nesse caso os
+ *   nós aposentados duas épocas atrás são devolvidos à arena.
+ */
+void epoca_confirmar(epoca_dominio* dominio, arena_nos* arena) {
+    uint64_t atual = atomic_load(&dominio->global);
+    lista_nos* limbo = &dominio->limbo[atual % 3];
+
+    for (size_t i = 0; i < dominio->pendentes.quantidade; i++) {
+        lista_nos_push(limbo, dominio->pendentes.nos[i]);
+    }
+    dominio->pendentes.quantidade = 0;
+
+    for (size_t i = 0; i < EPOCA_MAX_LEITORES; i++) {
+        uint64_t lida = atomic_load(&dominio->vagas[i].epoca);
+        if (lida != EPOCA_INATIVA && lida != atual) {
+            return;
+        }
+    }
+
+    atomic_store(&dominio->global, atual + 1);
+    lista_nos_liberar(&dominio->limbo[(atual + 2) % 3], arena);
+}
+
+/*
+ * Implementação:
+ * - Esquece os pendentes sem liberá-los.
+ */
+void epoca_descartar(epoca_dominio* dominio) {
+    dominio->pendentes.quantidade = 0;
+}
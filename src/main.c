@@ -1,7 +1,11 @@
 #include "dicionario.h"
 #include "menu.h"
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        return menu_lote(argc - 1, argv + 1);
+    }
+
     // cppcheck-suppress constVariablePointer
     dicionario* dicionario = menu_inicial();
     if (!dicionario) {
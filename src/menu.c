@@ -12,6 +12,7 @@
 #include <string.h>
 
 #define PATH_MAX 256
+#define MAX_RESULTADOS_PREFIXO 10
 
 /*
  * Implementação:
@@ -25,14 +26,6 @@ void limpar_tela(void) {
 #endif
 }
 
-/*
- * Implementação:
- * - Retorna o maior número informado.
- */
-static size_t min(size_t a, size_t b) {
-    return (a < b) ? a : b;
-}
-
 /*
  * Implementação:
  * - Espera a entrada de um caractere qualquer.
@@ -58,6 +51,8 @@ static void menu_exibir_opcoes() {
     printf("1 - Consultar palavra\n");
     printf("2 - Imprimir dicionário\n");
     printf("3 - Carregar arquivo de remoção\n");
+    printf("4 - Salvar snapshot\n");
+    printf("5 - Estatísticas\n");
     printf("0 - Sair\n");
     printf("\n");
 }
@@ -107,7 +102,7 @@ static int menu_ler_opcao(size_t* saida) {
 /*
  * Implementação:
  * - Solicita ao usuário o prefixo que deseja ser buscado.
- * - Exibe na tela o máximo de 10 resultados.
+ * - Busca e exibe na tela o máximo de 10 resultados.
  */
 static void menu_consultar_prefixo(dicionario* dicionario) {
     char prefixo[PATH_MAX];
@@ -119,8 +114,8 @@ static void menu_consultar_prefixo(dicionario* dicionario) {
     fgets(prefixo, sizeof prefixo, stdin);
 
     size_t quantidade = 0;
-    char** palavras =
-        dicionario_buscar_por_prefixo(dicionario, prefixo, &quantidade);
+    char** palavras = dicionario_buscar_por_prefixo_limitado(
+        dicionario, prefixo, MAX_RESULTADOS_PREFIXO, &quantidade);
     if (!palavras) {
         printf("\nNenhuma palavra encontrada.\n");
         aguardar_tela();
@@ -128,10 +123,10 @@ static void menu_consultar_prefixo(dicionario* dicionario) {
     }
 
     printf("\n");
-    for (size_t i = 0; i < min(quantidade - 1, 9); i++) {
+    for (size_t i = 0; i < quantidade - 1; i++) {
         printf("%s, ", palavras[i]);
     }
-    printf("%s\n\n", palavras[min(quantidade - 1, 9)]);
+    printf("%s\n\n", palavras[quantidade - 1]);
 
     trie_liberar_lista(palavras, quantidade);
 
@@ -142,27 +137,30 @@ static void menu_consultar_prefixo(dicionario* dicionario) {
  * Implementação:
  * - Exibe ao usuário todas as palavras contidas no dicionário,
  *   sem limite de resultados.
+ * - Percorre o dicionário com cursor, sem materializar a lista.
  */
 static void menu_imprimir_dicionario(dicionario* dicionario) {
-    size_t quantidade = 0;
-    char** palavras = dicionario_listar_palavras(dicionario, &quantidade);
-    if (!palavras) {
-        limpar_tela();
-        inicio_menu();
+    dicionario_cursor cursor;
+    dicionario_cursor_abrir(dicionario, NULL, &cursor);
+
+    limpar_tela();
+    inicio_menu();
+
+    const char* palavra = dicionario_cursor_proximo(&cursor);
+    if (!palavra) {
         printf("Nenhuma palavra encontrada.\n");
+        dicionario_cursor_fechar(&cursor);
         aguardar_tela();
         return;
     }
 
-    limpar_tela();
-    inicio_menu();
-
-    for (size_t i = 0; i < quantidade - 1; i++) {
-        printf("%s, ", palavras[i]);
+    printf("%s", palavra);
+    while ((palavra = dicionario_cursor_proximo(&cursor))) {
+        printf(", %s", palavra);
     }
-    printf("%s\n\n", palavras[quantidade - 1]);
+    printf("\n\n");
 
-    trie_liberar_lista(palavras, quantidade);
+    dicionario_cursor_fechar(&cursor);
 
     aguardar_tela();
 }
@@ -175,6 +173,14 @@ static void menu_imprimir_dicionario(dicionario* dicionario) {
 void menu_carregar_arquivo_remocao(dicionario* dicionario) {
     char caminho[PATH_MAX];
 
+    if (dicionario_somente_leitura(dicionario)) {
+        limpar_tela();
+        inicio_menu();
+        printf("Dicionário aberto de snapshot é somente leitura.\n");
+        aguardar_tela();
+        return;
+    }
+
     while (1) {
         limpar_tela();
         inicio_menu();
@@ -199,11 +205,124 @@ void menu_carregar_arquivo_remocao(dicionario* dicionario) {
     }
 }
 
+/*
+ * Implementação:
+ * - Solicita ao usuário o caminho do arquivo de snapshot.
+ * - Grava o dicionário atual nesse arquivo.
+ */
+static void menu_salvar_snapshot(const dicionario* dicionario) {
+    char caminho[PATH_MAX];
+
+    limpar_tela();
+    inicio_menu();
+
+    printf("Informe o caminho do snapshot:\n");
+    if (!fgets(caminho, sizeof caminho, stdin)) {
+        return;
+    }
+
+    trim(caminho);
+
+    if (dicionario_salvar_snapshot(dicionario, caminho)) {
+        printf("\nSnapshot salvo.\n");
+    } else {
+        printf("\nErro ao salvar snapshot.\n");
+    }
+    aguardar_tela();
+}
+
+/*
+ * Implementação:
+ * - Exibe os contadores e, se houver, o resultado da varredura,
+ *   incluindo apenas as faixas não vazias do histograma; sem
+ *   varredura (dicionário congelado), informa que ela não existe.
+ */
+static void imprimir_estatisticas(const estatisticas_dicionario* e) {
+    printf("Palavras: %zu\n", e->palavras);
+    printf("Nós: %zu\n", e->nos);
+    printf("Bytes usados: %zu\n", e->bytes_usados);
+    printf("Bytes reservados: %zu\n", e->bytes_reservados);
+    printf("Proporção de nós terminais: %.3f\n", e->proporcao_terminais);
+
+    if (!e->completo) {
+        printf("Varredura completa indisponível para dicionário congelado.\n");
+        return;
+    }
+
+    const estatisticas_trie* v = &e->varredura;
+    printf("Profundidade de busca média: %.2f\n", v->profundidade_media);
+    printf("Profundidade de busca máxima: %zu\n", v->profundidade_maxima);
+    printf("Comprimento médio das palavras: %.2f\n", v->comprimento_medio);
+    printf("Comprimento máximo das palavras: %zu\n", v->comprimento_maximo);
+    printf("Conjuntos de irmãos: %zu (degenerados: %zu)\n",
+           v->conjuntos_irmaos,
+           v->conjuntos_degenerados);
+    printf("Altura dos irmãos média: %.2f\n", v->altura_media_irmaos);
+    printf("Altura dos irmãos máxima: %zu\n", v->altura_maxima_irmaos);
+    printf("Histograma de alturas dos irmãos:\n");
+    for (size_t h = 0; h < TRIE_FAIXAS_IRMAOS; h++) {
+        if (v->histograma_irmaos[h] == 0) {
+            continue;
+        }
+        printf("  %s%2zu: %zu\n",
+               h == TRIE_FAIXAS_IRMAOS - 1 ? ">=" : "  ",
+               h,
+               v->histograma_irmaos[h]);
+    }
+}
+
+/*
+ * Implementação:
+ * - Obtém as estatísticas com varredura completa e as exibe.
+ */
+static void menu_estatisticas(const dicionario* dicionario) {
+    estatisticas_dicionario estatisticas;
+
+    limpar_tela();
+    inicio_menu();
+
+    if (dicionario_estatisticas(dicionario, &estatisticas, true)) {
+        imprimir_estatisticas(&estatisticas);
+    } else {
+        printf("Erro ao obter estatísticas.\n");
+    }
+    printf("\n");
+    aguardar_tela();
+}
+
+/*
+ * Implementação:
+ * - Se o arquivo for um snapshot, abre o dicionário direto dele.
+ * - Do contrário, cria dicionário e adiciona as palavras válidas
+ *   contidas no arquivo, montando a árvore balanceada.
+ * - Retorna NULL se o arquivo não puder ser carregado.
+ */
+static dicionario* abrir_dicionario(const char* caminho) {
+    dicionario* d = dicionario_abrir_snapshot(caminho);
+    if (d) {
+        return d;
+    }
+
+    d = dicionario_criar();
+    if (!d) {
+        return NULL;
+    }
+
+    if (dicionario_adicionar_de_arquivo_balanceado(d, caminho)) {
+        return d;
+    }
+
+    dicionario_destruir(d);
+    return NULL;
+}
+
 /*
  * Implementação:
  * - Pede ao usuário o caminho para o arquivo inicial.
- * - Cria dicionário.
- * - Adiciona ao dicionário as palavras válidas contidas no arquivo.
+ * - Se o arquivo for um snapshot, abre o dicionário direto dele.
+ * - Do contrário, cria dicionário.
+ * - Adiciona ao dicionário as palavras válidas contidas no arquivo,
+ *   montando a árvore balanceada.
  */
 dicionario* menu_inicial(void) {
 
@@ -224,17 +343,11 @@ dicionario* menu_inicial(void) {
             return NULL;
         }
 
-        dicionario* d = dicionario_criar();
-        if (!d) {
-            printf("Erro interno.\n");
-            return NULL;
-        }
-
-        if (dicionario_adicionar_de_arquivo(d, caminho)) {
+        dicionario* d = abrir_dicionario(caminho);
+        if (d) {
             return d;
         }
 
-        dicionario_destruir(d);
         printf("\nErro ao carregar arquivo.\n");
         aguardar_tela();
     }
@@ -265,6 +378,12 @@ void menu_principal(dicionario* d) {
         case 3:
             menu_carregar_arquivo_remocao(d);
             break;
+        case 4:
+            menu_salvar_snapshot(d);
+            break;
+        case 5:
+            menu_estatisticas(d);
+            break;
         case 0:
             printf("Encerrando...\n");
             break;
@@ -273,3 +392,29 @@ void menu_principal(dicionario* d) {
         }
     } while (opcao != 0);
 }
+
+/*
+ * Implementação:
+ * - Reconhece o comando "estatisticas <arquivo>": carrega o arquivo
+ *   como no menu inicial e imprime as estatísticas completas.
+ * - Retorna 0 em sucesso e 1 em uso incorreto ou falha de carga.
+ */
+int menu_lote(int argc, char** argv) {
+    if (argc != 2 || strcmp(argv[0], "estatisticas") != 0) {
+        fprintf(stderr, "Uso: dicionario estatisticas <arquivo>\n");
+        return 1;
+    }
+
+    dicionario* d = abrir_dicionario(argv[1]);
+    if (!d) {
+        fprintf(stderr, "Erro ao carregar arquivo.\n");
+        return 1;
+    }
+
+    estatisticas_dicionario estatisticas;
+    dicionario_estatisticas(d, &estatisticas, true);
+    imprimir_estatisticas(&estatisticas);
+
+    dicionario_destruir(d);
+    return 0;
+}
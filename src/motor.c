@@ -0,0 +1,918 @@
+/**
+ * @file motor.c
+ * @brief Operações genéricas sobre motores e adaptadores das Tries.
+ */
+
+#include "motor.h"
+
+#include "arena.h"
+#include "distancia.h"
+#include "padrao.h"
+#include "trie.h"
+#include "trie_dupla.h"
+#include "trie_rajada.h"
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct candidato_motor
+ * @brief Palavra guardada pela busca ranqueada genérica.
+ */
+typedef struct candidato_motor {
+    char* palavra;
+    uint32_t peso;
+} candidato_motor;
+
+/**
+ * @struct trie_ternaria_motor
+ * @brief Sentinela e arena da Trie ternária usada como motor.
+ */
+typedef struct trie_ternaria_motor {
+    no_trie* raiz;
+    arena_nos* arena;
+} trie_ternaria_motor;
+
+/*
+ * Implementação:
+ * - Cria os dados pela operação do motor.
+ */
+motor* motor_criar(const operacoes_motor* operacoes) {
+    if (!operacoes) {
+        return NULL;
+    }
+
+    motor* novo = malloc(sizeof *novo);
+    if (!novo) {
+        return NULL;
+    }
+
+    novo->operacoes = operacoes;
+    novo->dados = operacoes->criar();
+    if (!novo->dados) {
+        free(novo);
+        return NULL;
+    }
+
+    return novo;
+}
+
+/*
+ * Implementação:
+ * - Libera os dados pela operação do motor e a estrutura.
+ */
+void motor_destruir(motor* motor) {
+    if (!motor) {
+        return;
+    }
+
+    motor->operacoes->destruir(motor->dados);
+    free(motor);
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor.
+ */
+bool motor_inserir(motor* motor, const char* palavra, const uint32_t* peso) {
+    return motor->operacoes->inserir(motor->dados, palavra, peso);
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor.
+ */
+bool motor_remover(motor* motor, const char* palavra) {
+    return motor->operacoes->remover(motor->dados, palavra);
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor; palavras NULL (não normalizáveis) não existem.
+ */
+bool motor_contem(const motor* motor, const char* palavra) {
+    return palavra && motor->operacoes->contem(motor->dados, palavra);
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor.
+ */
+uint32_t motor_peso(const motor* motor, const char* palavra) {
+    return motor->operacoes->peso(motor->dados, palavra);
+}
+
+/*
+ * Implementação:
+ * - O motor aloca o estado do cursor; NULL indica falha.
+ */
+bool motor_cursor_abrir(motor_cursor* cursor,
+                        const motor* motor,
+                        const char* prefixo) {
+    cursor->operacoes = motor->operacoes;
+    cursor->estado = motor->operacoes->cursor_abrir(motor->dados, prefixo);
+    return cursor->estado != NULL;
+}
+
+/*
+ * Implementação:
+ * - Delega ao cursor do motor.
+ */
+const char* motor_cursor_proximo(motor_cursor* cursor) {
+    if (!cursor->estado) {
+        return NULL;
+    }
+    return cursor->operacoes->cursor_proximo(cursor->estado);
+}
+
+/*
+ * Implementação:
+ * - Um cursor que não chegou a ser aberto também conta como falha.
+ */
+bool motor_cursor_falhou(const motor_cursor* cursor) {
+    return !cursor->estado || cursor->operacoes->cursor_falhou(cursor->estado);
+}
+
+/*
+ * Implementação:
+ * - Delega ao cursor do motor e zera o cursor.
+ */
+void motor_cursor_fechar(motor_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    if (cursor->estado) {
+        cursor->operacoes->cursor_fechar(cursor->estado);
+    }
+    *cursor = (motor_cursor){0};
+}
+
+/*
+ * Implementação:
+ * - Consome um cursor sem prefixo.
+ */
+char** motor_listar(const motor* motor, size_t* quantidade) {
+    motor_cursor cursor;
+    lista_palavras lista = {0};
+    bool ok = motor_cursor_abrir(&cursor, motor, NULL);
+
+    const char* palavra = NULL;
+    while (ok && (palavra = motor_cursor_proximo(&cursor))) {
+        ok = lista_push(&lista, palavra);
+    }
+    ok = ok && !motor_cursor_falhou(&cursor);
+    motor_cursor_fechar(&cursor);
+
+    if (!ok) {
+        trie_liberar_lista(lista.palavras, lista.tamanho);
+        *quantidade = 0;
+        return NULL;
+    }
+
+    *quantidade = lista.tamanho;
+    return lista.palavras;
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor.
+ */
+void motor_medir(const motor* motor, medidas_motor* medidas) {
+    *medidas = (medidas_motor){0};
+    motor->operacoes->medir(motor->dados, medidas);
+}
+
+/*
+ * Implementação:
+ * - Delega ao motor.
+ */
+void motor_coletar_estatisticas(const motor* motor,
+                                estatisticas_trie* estatisticas) {
+    motor->operacoes->coletar_estatisticas(motor->dados, estatisticas);
+}
+
+/*
+ * Implementação:
+ * - Maior peso primeiro; em empate, ordem lexicográfica.
+ */
+static int comparar_candidatos(const void* a, const void* b) {
+    const candidato_motor* x = a;
+    const candidato_motor* y = b;
+    if (x->peso != y->peso) {
+        return x->peso > y->peso ? -1 : 1;
+    }
+    return strcmp(x->palavra, y->palavra);
+}
+
+/*
+ * Implementação:
+ * - Restaura o heap de mínimo (pior candidato na raiz) a partir da
+ *   posição i.
+ */
+static void descer_no_heap(candidato_motor* heap, size_t tamanho, size_t i) {
+    for (;;) {
+        size_t pior = i;
+        size_t esquerdo = (2 * i) + 1;
+        size_t direito = esquerdo + 1;
+        if (esquerdo < tamanho &&
+            comparar_candidatos(&heap[esquerdo], &heap[pior]) > 0) {
+            pior = esquerdo;
+        }
+        if (direito < tamanho &&
+            comparar_candidatos(&heap[direito], &heap[pior]) > 0) {
+            pior = direito;
+        }
+        if (pior == i) {
+            return;
+        }
+        candidato_motor tmp = heap[i];
+        heap[i] = heap[pior];
+        heap[pior] = tmp;
+        i = pior;
+    }
+}
+
+/*
+ * Implementação:
+ * - Sobe o candidato da posição i enquanto ele for pior que o pai.
+ */
+static void subir_no_heap(candidato_motor* heap, size_t i) {
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (comparar_candidatos(&heap[i], &heap[pai]) <= 0) {
+            return;
+        }
+        candidato_motor tmp = heap[i];
+        heap[i] = heap[pai];
+        heap[pai] = tmp;
+        i = pai;
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre o cursor do prefixo mantendo as k melhores palavras em
+ *   um heap cuja raiz é a pior delas; uma palavra só entra se for
+ *   melhor que a raiz.
+ * - Ordena o heap ao final e entrega as palavras.
+ */
+static char** ranquear_por_cursor(const motor* motor,
+                                  const char* prefixo,
+                                  size_t k,
+                                  size_t* quantidade) {
+    candidato_motor* heap = NULL;
+    size_t tamanho = 0;
+    size_t capacidade = 0;
+    motor_cursor cursor;
+    bool ok = motor_cursor_abrir(&cursor, motor, prefixo);
+
+    const char* palavra = NULL;
+    while (ok && (palavra = motor_cursor_proximo(&cursor))) {
+        candidato_motor novo = {.peso = motor_peso(motor, palavra)};
+        if (tamanho == k) {
+            novo.palavra = (char*) palavra;
+            if (comparar_candidatos(&novo, &heap[0]) >= 0) {
+                continue;
+            }
+        }
+
+        novo.palavra = string_dup(palavra);
+        if (!novo.palavra) {
+            ok = false;
+            break;
+        }
+        if (tamanho == k) {
+            free(heap[0].palavra);
+            heap[0] = novo;
+            descer_no_heap(heap, tamanho, 0);
+            continue;
+        }
+
+        if (tamanho == capacidade) {
+            size_t nova_cap = capacidade ? capacidade * 2 : 16;
+            candidato_motor* tmp = realloc(heap, nova_cap * sizeof *heap);
+            if (!tmp) {
+                free(novo.palavra);
+                ok = false;
+                break;
+            }
+            heap = tmp;
+            capacidade = nova_cap;
+        }
+        heap[tamanho] = novo;
+        subir_no_heap(heap, tamanho++);
+    }
+    ok = ok && !motor_cursor_falhou(&cursor);
+    motor_cursor_fechar(&cursor);
+
+    char** palavras = NULL;
+    if (ok && tamanho > 0) {
+        palavras = malloc(tamanho * sizeof *palavras);
+    }
+    if (palavras) {
+        qsort(heap, tamanho, sizeof *heap, comparar_candidatos);
+        for (size_t i = 0; i < tamanho; i++) {
+            palavras[i] = heap[i].palavra;
+        }
+    } else {
+        for (size_t i = 0; i < tamanho; i++) {
+            free(heap[i].palavra);
+        }
+    }
+    free(heap);
+
+    *quantidade = palavras ? tamanho : 0;
+    return palavras;
+}
+
+/*
+ * Implementação:
+ * - Usa a operação do motor ou percorre o cursor do prefixo.
+ */
+char** motor_buscar_por_prefixo_ranqueado(const motor* motor,
+                                          const char* prefixo,
+                                          size_t k,
+                                          size_t* quantidade) {
+    if (motor->operacoes->buscar_ranqueado) {
+        return motor->operacoes->buscar_ranqueado(
+            motor->dados, prefixo, k, quantidade);
+    }
+
+    if (k == 0) {
+        *quantidade = 0;
+        return NULL;
+    }
+    return ranquear_por_cursor(
+        motor, prefixo && *prefixo ? prefixo : NULL, k, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Tamanho do prefixo comum de duas palavras.
+ */
+static size_t prefixo_comum(const char* a, const char* b) {
+    size_t i = 0;
+    while (a[i] && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/*
+ * Implementação:
+ * - As palavras chegam em ordem, então as linhas do prefixo comum com
+ *   a anterior (até 'validas') continuam valendo; só as seguintes são
+ *   calculadas.
+ * - Uma linha cujo mínimo passa de max_distancia descarta a palavra e
+ *   todas as seguintes que compartilhem aquele prefixo.
+ */
+char** motor_buscar_aproximado(const motor* motor,
+                               const char* palavra,
+                               size_t max_distancia,
+                               size_t* quantidade) {
+    if (motor->operacoes->buscar_aproximado) {
+        return motor->operacoes->buscar_aproximado(
+            motor->dados, palavra, max_distancia, quantidade);
+    }
+
+    busca_aproximada busca;
+    motor_cursor cursor = {0};
+    if (busca_aproximada_iniciar(&busca, palavra, max_distancia) &&
+        motor_cursor_abrir(&cursor, motor, NULL)) {
+        char* anterior = NULL;
+        size_t capacidade_anterior = 0;
+        size_t validas = 0;
+        bool podada = false;
+
+        const char* atual = NULL;
+        while (!busca.falhou && (atual = motor_cursor_proximo(&cursor))) {
+            size_t p = anterior ? prefixo_comum(anterior, atual) : 0;
+            if (p >= validas) {
+                if (podada) {
+                    continue;
+                }
+                p = validas;
+            }
+
+            size_t tamanho = strlen(atual);
+            podada = false;
+            for (validas = p; validas < tamanho; validas++) {
+                size_t minimo = busca_aproximada_avancar(
+                    &busca, validas, atual[validas]);
+                if (minimo > max_distancia) {
+                    validas++;
+                    podada = true;
+                    break;
+                }
+            }
+            if (!podada) {
+                busca_aproximada_aceitar(&busca, tamanho);
+            }
+
+            if (!garantir_tamanho_buffer(
+                    &anterior, &capacidade_anterior, tamanho + 1)) {
+                busca.falhou = true;
+                break;
+            }
+            // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+            memcpy(anterior, atual, tamanho + 1);
+        }
+        busca.falhou = busca.falhou || motor_cursor_falhou(&cursor);
+        free(anterior);
+    } else {
+        busca.falhou = true;
+    }
+    motor_cursor_fechar(&cursor);
+
+    return busca_aproximada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de motor_buscar_aproximado: uma palavra é
+ *   descartada (com as que compartilham o prefixo) quando o padrão
+ *   não pode mais consumir letras antes do fim dela.
+ */
+char** motor_buscar_padrao(const motor* motor,
+                           const char* padrao,
+                           size_t* quantidade) {
+    if (motor->operacoes->buscar_padrao) {
+        return motor->operacoes->buscar_padrao(
+            motor->dados, padrao, quantidade);
+    }
+    if (!*padrao) {
+        return NULL;
+    }
+
+    busca_padrao busca;
+    motor_cursor cursor = {0};
+    if (busca_padrao_iniciar(&busca, padrao) &&
+        motor_cursor_abrir(&cursor, motor, NULL)) {
+        char* anterior = NULL;
+        size_t capacidade_anterior = 0;
+        size_t validas = 0;
+        bool podada = false;
+
+        const char* atual = NULL;
+        while (!busca.falhou && (atual = motor_cursor_proximo(&cursor))) {
+            size_t p = anterior ? prefixo_comum(anterior, atual) : 0;
+            if (p >= validas) {
+                if (podada) {
+                    continue;
+                }
+                p = validas;
+            }
+
+            size_t tamanho = strlen(atual);
+            podada = false;
+            for (validas = p; validas < tamanho; validas++) {
+                bool continuar =
+                    busca_padrao_avancar(&busca, validas, atual[validas]);
+                if (!continuar && validas + 1 < tamanho) {
+                    validas++;
+                    podada = true;
+                    break;
+                }
+            }
+            if (!podada) {
+                busca_padrao_aceitar(&busca, tamanho);
+            }
+
+            if (!garantir_tamanho_buffer(
+                    &anterior, &capacidade_anterior, tamanho + 1)) {
+                busca.falhou = true;
+                break;
+            }
+            // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+            memcpy(anterior, atual, tamanho + 1);
+        }
+        busca.falhou = busca.falhou || motor_cursor_falhou(&cursor);
+        free(anterior);
+    } else {
+        busca.falhou = true;
+    }
+    motor_cursor_fechar(&cursor);
+
+    return busca_padrao_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Usa a operação do motor ou conta as palavras do cursor.
+ */
+size_t motor_contar_prefixo(const motor* motor, const char* prefixo) {
+    if (motor->operacoes->contar_prefixo) {
+        return motor->operacoes->contar_prefixo(motor->dados, prefixo);
+    }
+
+    motor_cursor cursor;
+    size_t total = 0;
+    if (motor_cursor_abrir(&cursor, motor, prefixo)) {
+        while (motor_cursor_proximo(&cursor)) {
+            total++;
+        }
+    }
+    motor_cursor_fechar(&cursor);
+    return total;
+}
+
+/*
+ * Implementação:
+ * - Usa a operação do motor ou conta as palavras do cursor menores
+ *   que a palavra.
+ */
+size_t motor_rank(const motor* motor, const char* palavra) {
+    if (motor->operacoes->rank) {
+        return motor->operacoes->rank(motor->dados, palavra);
+    }
+
+    motor_cursor cursor;
+    size_t posicao = 0;
+    if (motor_cursor_abrir(&cursor, motor, NULL)) {
+        const char* atual = NULL;
+        while ((atual = motor_cursor_proximo(&cursor)) &&
+               strcmp(atual, palavra) < 0) {
+            posicao++;
+        }
+    }
+    motor_cursor_fechar(&cursor);
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Usa a operação do motor ou avança o cursor k palavras.
+ */
+char* motor_selecionar(const motor* motor, size_t k) {
+    if (motor->operacoes->selecionar) {
+        return motor->operacoes->selecionar(motor->dados, k);
+    }
+
+    motor_cursor cursor;
+    char* palavra = NULL;
+    if (motor_cursor_abrir(&cursor, motor, NULL)) {
+        const char* atual = motor_cursor_proximo(&cursor);
+        for (size_t i = 0; atual && i < k; i++) {
+            atual = motor_cursor_proximo(&cursor);
+        }
+        palavra = atual ? string_dup(atual) : NULL;
+    }
+    motor_cursor_fechar(&cursor);
+    return palavra;
+}
+
+/*
+ * Implementação:
+ * - Adaptadores da Trie ternária: cada operação repassa a sentinela
+ *   (e a arena, nas alterações) às funções de trie.h.
+ */
+static void* ternaria_criar(void) {
+    trie_ternaria_motor* trie = calloc(1, sizeof *trie);
+    if (!trie) {
+        return NULL;
+    }
+
+    trie->arena = arena_criar(0);
+    trie->raiz = trie->arena ? arena_alocar_no(trie->arena) : NULL;
+    if (!trie->raiz) {
+        arena_destruir(trie->arena);
+        free(trie);
+        return NULL;
+    }
+
+    return trie;
+}
+
+static void ternaria_destruir(void* dados) {
+    trie_ternaria_motor* trie = dados;
+    arena_destruir(trie->arena);
+    free(trie);
+}
+
+static bool
+ternaria_inserir(void* dados, const char* palavra, const uint32_t* peso) {
+    trie_ternaria_motor* trie = dados;
+    if (peso) {
+        return trie_inserir_com_peso(trie->raiz, trie->arena, palavra, *peso);
+    }
+    return trie_inserir(trie->raiz, trie->arena, palavra);
+}
+
+static bool ternaria_remover(void* dados, const char* palavra) {
+    trie_ternaria_motor* trie = dados;
+    return trie_remover(trie->raiz, trie->arena, palavra);
+}
+
+static bool ternaria_contem(const void* dados, const char* palavra) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_contem(trie->raiz, palavra);
+}
+
+static uint32_t ternaria_peso(const void* dados, const char* palavra) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_peso(trie->raiz, palavra);
+}
+
+static void* ternaria_cursor_abrir(const void* dados, const char* prefixo) {
+    const trie_ternaria_motor* trie = dados;
+    trie_cursor* cursor = malloc(sizeof *cursor);
+    if (cursor && !trie_cursor_abrir(cursor, trie->raiz, prefixo)) {
+        trie_cursor_fechar(cursor);
+        free(cursor);
+        return NULL;
+    }
+    return cursor;
+}
+
+static const char* ternaria_cursor_proximo(void* cursor) {
+    return trie_cursor_proximo(cursor);
+}
+
+static bool ternaria_cursor_falhou(const void* cursor) {
+    return ((const trie_cursor*) cursor)->falhou;
+}
+
+static void ternaria_cursor_fechar(void* cursor) {
+    trie_cursor_fechar(cursor);
+    free(cursor);
+}
+
+static void ternaria_medir(const void* dados, medidas_motor* medidas) {
+    const trie_ternaria_motor* trie = dados;
+    medidas->nos = trie->arena->nos_ativos;
+    medidas->bytes_usados = trie->arena->nos_ativos * sizeof(no_trie);
+    medidas->bytes_reservados = arena_bytes_reservados(trie->arena);
+}
+
+static void ternaria_coletar_estatisticas(const void* dados,
+                                          estatisticas_trie* estatisticas) {
+    const trie_ternaria_motor* trie = dados;
+    trie_coletar_estatisticas(trie->raiz, estatisticas);
+}
+
+static char** ternaria_buscar_ranqueado(const void* dados,
+                                        const char* prefixo,
+                                        size_t k,
+                                        size_t* quantidade) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_buscar_por_prefixo_ranqueado(
+        trie->raiz, prefixo, k, quantidade);
+}
+
+static char** ternaria_buscar_aproximado(const void* dados,
+                                         const char* palavra,
+                                         size_t max_distancia,
+                                         size_t* quantidade) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_buscar_aproximado(
+        trie->raiz, palavra, max_distancia, quantidade);
+}
+
+static char** ternaria_buscar_padrao(const void* dados,
+                                     const char* padrao,
+                                     size_t* quantidade) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_buscar_padrao(trie->raiz, padrao, quantidade);
+}
+
+static size_t ternaria_contar_prefixo(const void* dados, const char* prefixo) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_contar_prefixo(trie->raiz, prefixo);
+}
+
+static size_t ternaria_rank(const void* dados, const char* palavra) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_rank(trie->raiz, palavra);
+}
+
+static char* ternaria_selecionar(const void* dados, size_t k) {
+    const trie_ternaria_motor* trie = dados;
+    return trie_selecionar(trie->raiz, k);
+}
+
+const operacoes_motor MOTOR_TRIE_TERNARIA = {
+    .nome = "ternária",
+    .criar = ternaria_criar,
+    .destruir = ternaria_destruir,
+    .inserir = ternaria_inserir,
+    .remover = ternaria_remover,
+    .contem = ternaria_contem,
+    .peso = ternaria_peso,
+    .cursor_abrir = ternaria_cursor_abrir,
+    .cursor_proximo = ternaria_cursor_proximo,
+    .cursor_falhou = ternaria_cursor_falhou,
+    .cursor_fechar = ternaria_cursor_fechar,
+    .medir = ternaria_medir,
+    .coletar_estatisticas = ternaria_coletar_estatisticas,
+    .buscar_ranqueado = ternaria_buscar_ranqueado,
+    .buscar_aproximado = ternaria_buscar_aproximado,
+    .buscar_padrao = ternaria_buscar_padrao,
+    .contar_prefixo = ternaria_contar_prefixo,
+    .rank = ternaria_rank,
+    .selecionar = ternaria_selecionar,
+};
+
+/*
+ * Implementação:
+ * - Adaptadores da Trie de vetor duplo: repassam às funções de
+ *   trie_dupla.h, que já têm o contrato das operações.
+ */
+static void* dupla_criar(void) {
+    return trie_dupla_criar();
+}
+
+static void dupla_destruir(void* dados) {
+    trie_dupla_destruir(dados);
+}
+
+static bool
+dupla_inserir(void* dados, const char* palavra, const uint32_t* peso) {
+    return trie_dupla_inserir(dados, palavra, peso);
+}
+
+static bool dupla_remover(void* dados, const char* palavra) {
+    return trie_dupla_remover(dados, palavra);
+}
+
+static bool dupla_contem(const void* dados, const char* palavra) {
+    return trie_dupla_contem(dados, palavra);
+}
+
+static uint32_t dupla_peso(const void* dados, const char* palavra) {
+    return trie_dupla_peso(dados, palavra);
+}
+
+static void* dupla_cursor_abrir(const void* dados, const char* prefixo) {
+    trie_dupla_cursor* cursor = malloc(sizeof *cursor);
+    if (cursor && !trie_dupla_cursor_abrir(cursor, dados, prefixo)) {
+        trie_dupla_cursor_fechar(cursor);
+        free(cursor);
+        return NULL;
+    }
+    return cursor;
+}
+
+static const char* dupla_cursor_proximo(void* cursor) {
+    return trie_dupla_cursor_proximo(cursor);
+}
+
+static bool dupla_cursor_falhou(const void* cursor) {
+    return ((const trie_dupla_cursor*) cursor)->falhou;
+}
+
+static void dupla_cursor_fechar(void* cursor) {
+    trie_dupla_cursor_fechar(cursor);
+    free(cursor);
+}
+
+static void dupla_medir(const void* dados, medidas_motor* medidas) {
+    const trie_dupla* trie = dados;
+    medidas->nos = trie->estados;
+    medidas->bytes_usados =
+        trie->estados * (sizeof(celula_dupla) + sizeof(info_dupla));
+    medidas->bytes_reservados = trie_dupla_bytes_reservados(trie);
+}
+
+static void dupla_coletar_estatisticas(const void* dados,
+                                       estatisticas_trie* estatisticas) {
+    trie_dupla_coletar_estatisticas(dados, estatisticas);
+}
+
+static char** dupla_buscar_ranqueado(const void* dados,
+                                     const char* prefixo,
+                                     size_t k,
+                                     size_t* quantidade) {
+    return trie_dupla_buscar_por_prefixo_ranqueado(
+        dados, prefixo, k, quantidade);
+}
+
+static char** dupla_buscar_aproximado(const void* dados,
+                                      const char* palavra,
+                                      size_t max_distancia,
+                                      size_t* quantidade) {
+    return trie_dupla_buscar_aproximado(
+        dados, palavra, max_distancia, quantidade);
+}
+
+static char** dupla_buscar_padrao(const void* dados,
+                                  const char* padrao,
+                                  size_t* quantidade) {
+    return trie_dupla_buscar_padrao(dados, padrao, quantidade);
+}
+
+static size_t dupla_contar_prefixo(const void* dados, const char* prefixo) {
+    return trie_dupla_contar_prefixo(dados, prefixo);
+}
+
+static size_t dupla_rank(const void* dados, const char* palavra) {
+    return trie_dupla_rank(dados, palavra);
+}
+
+static char* dupla_selecionar(const void* dados, size_t k) {
+    return trie_dupla_selecionar(dados, k);
+}
+
+const operacoes_motor MOTOR_VETOR_DUPLO = {
+    .nome = "vetor duplo",
+    .criar = dupla_criar,
+    .destruir = dupla_destruir,
+    .inserir = dupla_inserir,
+    .remover = dupla_remover,
+    .contem = dupla_contem,
+    .peso = dupla_peso,
+    .cursor_abrir = dupla_cursor_abrir,
+    .cursor_proximo = dupla_cursor_proximo,
+    .cursor_falhou = dupla_cursor_falhou,
+    .cursor_fechar = dupla_cursor_fechar,
+    .medir = dupla_medir,
+    .coletar_estatisticas = dupla_coletar_estatisticas,
+    .buscar_ranqueado = dupla_buscar_ranqueado,
+    .buscar_aproximado = dupla_buscar_aproximado,
+    .buscar_padrao = dupla_buscar_padrao,
+    .contar_prefixo = dupla_contar_prefixo,
+    .rank = dupla_rank,
+    .selecionar = dupla_selecionar,
+};
+
+/*
+ * Implementação:
+ * - Adaptadores da Trie de rajada; as operações opcionais ficam com
+ *   as versões genéricas.
+ */
+static void* rajada_criar(void) {
+    return trie_rajada_criar();
+}
+
+static void rajada_destruir(void* dados) {
+    trie_rajada_destruir(dados);
+}
+
+static bool
+rajada_inserir(void* dados, const char* palavra, const uint32_t* peso) {
+    return trie_rajada_inserir(dados, palavra, peso);
+}
+
+static bool rajada_remover(void* dados, const char* palavra) {
+    return trie_rajada_remover(dados, palavra);
+}
+
+static bool rajada_contem(const void* dados, const char* palavra) {
+    return trie_rajada_contem(dados, palavra);
+}
+
+static uint32_t rajada_peso(const void* dados, const char* palavra) {
+    return trie_rajada_peso(dados, palavra);
+}
+
+static void* rajada_cursor_abrir(const void* dados, const char* prefixo) {
+    trie_rajada_cursor* cursor = malloc(sizeof *cursor);
+    if (cursor && !trie_rajada_cursor_abrir(cursor, dados, prefixo)) {
+        trie_rajada_cursor_fechar(cursor);
+        free(cursor);
+        return NULL;
+    }
+    return cursor;
+}
+
+static const char* rajada_cursor_proximo(void* cursor) {
+    return trie_rajada_cursor_proximo(cursor);
+}
+
+static bool rajada_cursor_falhou(const void* cursor) {
+    return ((const trie_rajada_cursor*) cursor)->falhou;
+}
+
+static void rajada_cursor_fechar(void* cursor) {
+    trie_rajada_cursor_fechar(cursor);
+    free(cursor);
+}
+
+static void rajada_medir(const void* dados, medidas_motor* medidas) {
+    const trie_rajada* trie = dados;
+    medidas->nos = trie->nos + trie->total_recipientes;
+    medidas->bytes_usados = trie_rajada_bytes_usados(trie);
+    medidas->bytes_reservados = trie_rajada_bytes_reservados(trie);
+}
+
+static void rajada_coletar_estatisticas(const void* dados,
+                                        estatisticas_trie* estatisticas) {
+    trie_rajada_coletar_estatisticas(dados, estatisticas);
+}
+
+const operacoes_motor MOTOR_RAJADA = {
+    .nome = "rajada",
+    .criar = rajada_criar,
+    .destruir = rajada_destruir,
+    .inserir = rajada_inserir,
+    .remover = rajada_remover,
+    .contem = rajada_contem,
+    .peso = rajada_peso,
+    .cursor_abrir = rajada_cursor_abrir,
+    .cursor_proximo = rajada_cursor_proximo,
+    .cursor_falhou = rajada_cursor_falhou,
+    .cursor_fechar = rajada_cursor_fechar,
+    .medir = rajada_medir,
+    .coletar_estatisticas = rajada_coletar_estatisticas,
+};
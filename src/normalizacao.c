@@ -0,0 +1,278 @@
+/**
+ * @file normalizacao.c
+ * @brief Implementação dos núcleos de normalização de palavras.
+ */
+
+#include "normalizacao.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NORMALIZACAO_X86 1
+#include <immintrin.h>
+#endif
+
+typedef size_t (*funcao_letras)(const char* origem,
+                                size_t tamanho,
+                                char* destino);
+
+/*
+ * Implementação:
+ * - c | 0x20 leva A–Z para a–z e só cai em a–z se c for letra.
+ */
+static size_t
+letras_escalar(const char* origem, size_t tamanho, char* destino) {
+    size_t i = 0;
+    for (; i < tamanho; i++) {
+        unsigned char c = (unsigned char) origem[i] | 0x20;
+        if (c < 'a' || c > 'z') {
+            break;
+        }
+        destino[i] = (char) c;
+    }
+    return i;
+}
+
+#ifdef NORMALIZACAO_X86
+
+/*
+ * Implementação:
+ * - Mesma conversão da versão escalar, 16 bytes por vez: depois do
+ *   OR com 0x20, somar 0x80 - 'a' leva a–z para os 26 menores valores
+ *   com sinal, testados com uma única comparação.
+ * - Grava o bloco inteiro e para no primeiro byte fora da classe.
+ * - O resto (menos de 16 bytes) é copiado para um bloco zerado; o
+ *   zero não é letra, então a contagem não passa do resto.
+ */
+static size_t letras_sse2(const char* origem, size_t tamanho, char* destino) {
+    const __m128i minusculo = _mm_set1_epi8(0x20);
+    const __m128i deslocamento = _mm_set1_epi8((char) (0x80 - 'a'));
+    const __m128i limite = _mm_set1_epi8((char) (-128 + 26));
+
+    size_t i = 0;
+    for (; i + 16 <= tamanho; i += 16) {
+        __m128i v =
+            _mm_loadu_si128((const __m128i*) (const void*) (origem + i));
+        __m128i m = _mm_or_si128(v, minusculo);
+        __m128i letras = _mm_cmplt_epi8(_mm_add_epi8(m, deslocamento), limite);
+        _mm_storeu_si128((__m128i*) (void*) (destino + i), m);
+
+        unsigned mascara = (unsigned) _mm_movemask_epi8(letras);
+        if (mascara != 0xFFFFu) {
+            return i + (size_t) __builtin_ctz(~mascara);
+        }
+    }
+
+    size_t resto = tamanho - i;
+    if (resto == 0) {
+        return i;
+    }
+
+    char bloco[16] = {0};
+    memcpy(bloco, origem + i, resto);
+    __m128i m = _mm_or_si128(_mm_loadu_si128((const __m128i*) (void*) bloco),
+                             minusculo);
+    __m128i letras = _mm_cmplt_epi8(_mm_add_epi8(m, deslocamento), limite);
+    _mm_storeu_si128((__m128i*) (void*) bloco, m);
+    memcpy(destino + i, bloco, resto);
+
+    unsigned mascara = (unsigned) _mm_movemask_epi8(letras);
+    return i + (size_t) __builtin_ctz(~mascara);
+}
+
+/*
+ * Implementação:
+ * - Mesmo teste de letras_sse2 em blocos de 32 bytes; o resto fica
+ *   com letras_sse2.
+ * - O primeiro bloco tem 16 bytes: a maioria das palavras termina
+ *   nele, e um bloco de 32 cruzaria linhas de cache com mais
+ *   frequência.
+ */
+__attribute__((target("avx2"))) static size_t
+letras_avx2(const char* origem, size_t tamanho, char* destino) {
+    const __m256i minusculo = _mm256_set1_epi8(0x20);
+    const __m256i deslocamento = _mm256_set1_epi8((char) (0x80 - 'a'));
+    const __m256i limite = _mm256_set1_epi8((char) (-128 + 26));
+
+    size_t i = 0;
+    if (tamanho >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (const void*) origem);
+        __m128i m = _mm_or_si128(v, _mm256_castsi256_si128(minusculo));
+        __m128i letras = _mm_cmpgt_epi8(
+            _mm256_castsi256_si128(limite),
+            _mm_add_epi8(m, _mm256_castsi256_si128(deslocamento)));
+        _mm_storeu_si128((__m128i*) (void*) destino, m);
+
+        unsigned mascara = (unsigned) _mm_movemask_epi8(letras);
+        if (mascara != 0xFFFFu) {
+            return (size_t) __builtin_ctz(~mascara);
+        }
+        i = 16;
+    }
+
+    for (; i + 32 <= tamanho; i += 32) {
+        __m256i v =
+            _mm256_loadu_si256((const __m256i*) (const void*) (origem + i));
+        __m256i m = _mm256_or_si256(v, minusculo);
+        __m256i letras =
+            _mm256_cmpgt_epi8(limite, _mm256_add_epi8(m, deslocamento));
+        _mm256_storeu_si256((__m256i*) (void*) (destino + i), m);
+
+        unsigned mascara = (unsigned) _mm256_movemask_epi8(letras);
+        if (mascara != 0xFFFFFFFFu) {
+            return i + (size_t) __builtin_ctz(~mascara);
+        }
+    }
+
+    return i + letras_sse2(origem + i, tamanho - i, destino + i);
+}
+
+#endif
+
+static const funcao_letras NUCLEOS[] = {
+    letras_escalar,
+#ifdef NORMALIZACAO_X86
+    letras_sse2,
+    letras_avx2,
+#endif
+};
+
+static const char* const NOMES[] = {"escalar", "sse2", "avx2"};
+
+// Núcleo em uso; -1 enquanto a CPU não foi consultada
+static atomic_int nucleo_atual = -1;
+
+/*
+ * Implementação:
+ * - Consulta a CPU: AVX2 se disponível; SSE2 faz parte do x86-64.
+ */
+static bool nucleo_suportado(nucleo_normalizacao nucleo) {
+    switch (nucleo) {
+    case NORMALIZACAO_ESCALAR:
+        return true;
+#ifdef NORMALIZACAO_X86
+    case NORMALIZACAO_SSE2:
+        return true;
+    case NORMALIZACAO_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+/*
+ * Implementação:
+ * - Na primeira chamada escolhe a maior versão suportada. Corridas
+ *   entre threads gravam o mesmo valor.
+ */
+static funcao_letras nucleo_em_uso(void) {
+    int nucleo = atomic_load_explicit(&nucleo_atual, memory_order_relaxed);
+    if (nucleo < 0) {
+        nucleo = NORMALIZACAO_AVX2;
+        while (!nucleo_suportado((nucleo_normalizacao) nucleo)) {
+            nucleo--;
+        }
+        atomic_store_explicit(&nucleo_atual, nucleo, memory_order_relaxed);
+    }
+    return NUCLEOS[nucleo];
+}
+
+/*
+ * Implementação:
+ * - Delega para o núcleo em uso.
+ */
+size_t normalizar_letras(const char* origem, size_t tamanho, char* destino) {
+    return nucleo_em_uso()(origem, tamanho, destino);
+}
+
+/*
+ * Implementação:
+ * - Mesmos espaços de isspace no locale "C".
+ */
+static bool espaco(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*
+ * Implementação:
+ * - Para cada linha: ignora espaços iniciais, copia as letras com o
+ *   núcleo (que para sozinho na quebra de linha) e ignora espaços
+ *   finais.
+ * - Se sobrar algo antes da quebra, a linha é inválida e o restante
+ *   dela é pulado com memchr, sem ser escrito.
+ * - A saída nunca passa da posição lida, então 'destino' comporta
+ *   qualquer texto com tamanho + 1 bytes.
+ */
+size_t normalizar_linhas(const char* texto,
+                         size_t tamanho,
+                         char* destino,
+                         size_t* usados) {
+    funcao_letras letras = nucleo_em_uso();
+    const char* p = texto;
+    const char* fim = texto + tamanho;
+    char* d = destino;
+    size_t palavras = 0;
+
+    while (p < fim) {
+        while (p < fim && *p != '\n' && espaco(*p)) {
+            p++;
+        }
+
+        size_t copiadas = letras(p, (size_t) (fim - p), d);
+        const char* q = p + copiadas;
+        while (q < fim && *q != '\n' && espaco(*q)) {
+            q++;
+        }
+
+        if (q < fim && *q != '\n') {
+            q = memchr(q, '\n', (size_t) (fim - q));
+            if (!q) {
+                break;
+            }
+        } else if (copiadas > 0 && copiadas <= NORMALIZACAO_MAX_LETRAS) {
+            d[copiadas] = '\0';
+            d += copiadas + 1;
+            palavras++;
+        }
+
+        if (q == fim) {
+            break;
+        }
+        p = q + 1;
+    }
+
+    *usados = (size_t) (d - destino);
+    return palavras;
+}
+
+/*
+ * Implementação:
+ * - Consulta a CPU se ainda não tiver consultado.
+ */
+nucleo_normalizacao normalizacao_nucleo(void) {
+    nucleo_em_uso();
+    return (nucleo_normalizacao) atomic_load(&nucleo_atual);
+}
+
+/*
+ * Implementação:
+ * - Grava a versão pedida se a CPU a suportar.
+ */
+bool normalizacao_selecionar(nucleo_normalizacao nucleo) {
+    if (!nucleo_suportado(nucleo)) {
+        return false;
+    }
+    atomic_store(&nucleo_atual, (int) nucleo);
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Indexa a tabela de nomes.
+ */
+const char* normalizacao_nome(nucleo_normalizacao nucleo) {
+    return NOMES[nucleo];
+}
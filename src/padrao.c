@@ -0,0 +1,211 @@
+/**
+ * @file padrao.c
+ * @brief Implementação da busca por padrão com curingas.
+ */
+
+#include "padrao.h"
+
+#include "trie.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CURINGA_UM '?'
+#define CURINGA_VARIOS '*'
+
+/*
+ * Implementação:
+ * - Garante espaço para 'linhas' conjuntos e para o prefixo
+ *   correspondente, dobrando as capacidades.
+ */
+static bool garantir_linhas(busca_padrao* busca, size_t linhas) {
+    if (linhas > busca->capacidade_linhas) {
+        size_t nova_cap = busca->capacidade_linhas * 2;
+        while (nova_cap < linhas) {
+            nova_cap *= 2;
+        }
+        bool* tmp = realloc(busca->estados,
+                            nova_cap * (busca->tamanho + 1) * sizeof *tmp);
+        if (!tmp) {
+            return false;
+        }
+        busca->estados = tmp;
+        busca->capacidade_linhas = nova_cap;
+    }
+
+    return garantir_tamanho_buffer(
+        &busca->prefixo, &busca->capacidade_prefixo, linhas);
+}
+
+/*
+ * Implementação:
+ * - Fecho do conjunto: uma posição com '*' ativa também ativa a
+ *   seguinte, pois o asterisco pode casar zero letras.
+ */
+static void fechar_conjunto(const busca_padrao* busca, bool* linha) {
+    for (size_t i = 0; i < busca->tamanho; i++) {
+        if (linha[i] && busca->padrao[i] == CURINGA_VARIOS) {
+            linha[i + 1] = true;
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Remove espaços das pontas e converte para minúsculo.
+ * - Rejeita caracteres que não sejam letras ou curingas.
+ * - Copia o padrão sobre si mesmo, pulando asteriscos repetidos.
+ */
+bool padrao_normalizar(char* padrao) {
+    trim(padrao);
+
+    size_t escrita = 0;
+    for (size_t i = 0; padrao[i]; i++) {
+        unsigned char c = (unsigned char) padrao[i];
+        if (c != CURINGA_UM && c != CURINGA_VARIOS && !isalpha(c)) {
+            return false;
+        }
+        if (c == CURINGA_VARIOS && escrita > 0 &&
+            padrao[escrita - 1] == CURINGA_VARIOS) {
+            continue;
+        }
+        padrao[escrita++] = (char) tolower(c);
+    }
+    padrao[escrita] = '\0';
+
+    return escrita > 0;
+}
+
+/*
+ * Implementação:
+ * - O conjunto inicial contém a posição 0 e o seu fecho.
+ */
+bool busca_padrao_iniciar(busca_padrao* busca, const char* padrao) {
+    *busca = (busca_padrao){
+        .padrao = padrao,
+        .tamanho = strlen(padrao),
+        .capacidade_linhas = 1,
+    };
+
+    busca->estados = calloc(busca->tamanho + 1, sizeof *busca->estados);
+    if (!busca->estados || !garantir_linhas(busca, busca->tamanho + 2)) {
+        busca->falhou = true;
+        return false;
+    }
+
+    busca->estados[0] = true;
+    fechar_conjunto(busca, busca->estados);
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Percorre as posições ativas que ainda consomem letra: curingas
+ *   abrem o intervalo todo; letras o restringem às letras presentes.
+ * - Sem posições assim, o intervalo fica vazio (minimo > maximo).
+ */
+void busca_padrao_limites(const busca_padrao* busca,
+                          size_t profundidade,
+                          char* minimo,
+                          char* maximo) {
+    const bool* linha =
+        busca->estados + (profundidade * (busca->tamanho + 1));
+    *minimo = (char) 127;
+    *maximo = (char) 0;
+
+    for (size_t i = 0; i < busca->tamanho; i++) {
+        if (!linha[i]) {
+            continue;
+        }
+
+        char c = busca->padrao[i];
+        if (c == CURINGA_UM || c == CURINGA_VARIOS) {
+            *minimo = (char) 1;
+            *maximo = (char) 127;
+            return;
+        }
+        if (c < *minimo) {
+            *minimo = c;
+        }
+        if (c > *maximo) {
+            *maximo = c;
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Transição de cada posição ativa: '*' permanece, '?' e a letra
+ *   igual ao caractere avançam; depois aplica o fecho.
+ */
+bool busca_padrao_avancar(busca_padrao* busca,
+                          size_t profundidade,
+                          char caractere) {
+    if (busca->falhou || !garantir_linhas(busca, profundidade + 2)) {
+        busca->falhou = true;
+        return false;
+    }
+
+    size_t colunas = busca->tamanho + 1;
+    const bool* anterior = busca->estados + (profundidade * colunas);
+    bool* atual = busca->estados + ((profundidade + 1) * colunas);
+    busca->prefixo[profundidade] = caractere;
+
+    memset(atual, 0, colunas * sizeof *atual);
+    for (size_t i = 0; i < busca->tamanho; i++) {
+        if (!anterior[i]) {
+            continue;
+        }
+
+        char c = busca->padrao[i];
+        if (c == CURINGA_VARIOS) {
+            atual[i] = true;
+        } else if (c == CURINGA_UM || c == caractere) {
+            atual[i + 1] = true;
+        }
+    }
+    fechar_conjunto(busca, atual);
+
+    for (size_t i = 0; i < busca->tamanho; i++) {
+        if (atual[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Implementação:
+ * - Aceita se a posição final está no conjunto do prefixo.
+ */
+void busca_padrao_aceitar(busca_padrao* busca, size_t profundidade) {
+    size_t colunas = busca->tamanho + 1;
+    if (busca->falhou ||
+        !busca->estados[(profundidade * colunas) + busca->tamanho]) {
+        return;
+    }
+
+    busca->prefixo[profundidade] = '\0';
+    if (!lista_push(&busca->resultado, busca->prefixo)) {
+        busca->falhou = true;
+    }
+}
+
+/*
+ * Implementação:
+ * - Libera conjuntos e prefixo; em falha, libera também o resultado.
+ */
+char** busca_padrao_concluir(busca_padrao* busca, size_t* quantidade) {
+    free(busca->estados);
+    free(busca->prefixo);
+
+    if (busca->falhou) {
+        trie_liberar_lista(busca->resultado.palavras, busca->resultado.tamanho);
+        *quantidade = 0;
+        return NULL;
+    }
+
+    *quantidade = busca->resultado.tamanho;
+    return busca->resultado.palavras;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file ranqueamento.c
+ * @brief Implementação da busca das k palavras de maior peso.
+ */
+
+#include "ranqueamento.h"
+
+#include "trie.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Implementação:
+ * - Ordem da fila: maior peso primeiro; no empate, palavra completa.
+ */
+static bool precede(const candidato_ranqueado* a,
+                    const candidato_ranqueado* b) {
+    if (a->peso != b->peso) {
+        return a->peso > b->peso;
+    }
+    return a->completo && !b->completo;
+}
+
+/*
+ * Implementação:
+ * - Cria o elo 0 (prefixo buscado, profundidade 0).
+ */
+bool busca_ranqueada_iniciar(busca_ranqueada* busca, const char* prefixo) {
+    *busca = (busca_ranqueada){
+        .prefixo = prefixo,
+        .tamanho_prefixo = strlen(prefixo),
+    };
+
+    busca->elos = malloc(sizeof *busca->elos);
+    if (!busca->elos) {
+        busca->falhou = true;
+        return false;
+    }
+    busca->capacidade_elos = 1;
+    busca->elos[busca->quantidade_elos++] =
+        (elo_prefixo){.anterior = 0, .profundidade = 0, .caractere = '\0'};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Heap binário de máximo: acrescenta ao fim e sobe.
+ */
+void busca_ranqueada_inserir(busca_ranqueada* busca,
+                             candidato_ranqueado candidato) {
+    if (busca->falhou) {
+        return;
+    }
+
+    if (busca->tamanho_fila == busca->capacidade_fila) {
+        size_t nova_cap =
+            busca->capacidade_fila ? busca->capacidade_fila * 2 : 64;
+        candidato_ranqueado* tmp =
+            realloc(busca->fila, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            busca->falhou = true;
+            return;
+        }
+        busca->fila = tmp;
+        busca->capacidade_fila = nova_cap;
+    }
+
+    size_t i = busca->tamanho_fila++;
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (!precede(&candidato, &busca->fila[pai])) {
+            break;
+        }
+        busca->fila[i] = busca->fila[pai];
+        i = pai;
+    }
+    busca->fila[i] = candidato;
+}
+
+/*
+ * Implementação:
+ * - Retira a raiz do heap e desce o último elemento.
+ */
+bool busca_ranqueada_retirar(busca_ranqueada* busca,
+                             candidato_ranqueado* candidato) {
+    if (busca->falhou || busca->tamanho_fila == 0) {
+        return false;
+    }
+
+    *candidato = busca->fila[0];
+    candidato_ranqueado ultimo = busca->fila[--busca->tamanho_fila];
+    size_t n = busca->tamanho_fila;
+    size_t i = 0;
+
+    while ((2 * i) + 1 < n) {
+        size_t filho = (2 * i) + 1;
+        if (filho + 1 < n &&
+            precede(&busca->fila[filho + 1], &busca->fila[filho])) {
+            filho++;
+        }
+        if (!precede(&busca->fila[filho], &ultimo)) {
+            break;
+        }
+        busca->fila[i] = busca->fila[filho];
+        i = filho;
+    }
+    if (n > 0) {
+        busca->fila[i] = ultimo;
+    }
+
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Acrescenta o elo ao vetor, dobrando a capacidade.
+ */
+bool busca_ranqueada_estender(busca_ranqueada* busca,
+                              size_t elo,
+                              char caractere,
+                              size_t* novo) {
+    if (busca->quantidade_elos == busca->capacidade_elos) {
+        size_t nova_cap = busca->capacidade_elos * 2;
+        elo_prefixo* tmp = realloc(busca->elos, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            busca->falhou = true;
+            return false;
+        }
+        busca->elos = tmp;
+        busca->capacidade_elos = nova_cap;
+    }
+
+    *novo = busca->quantidade_elos++;
+    busca->elos[*novo] = (elo_prefixo){
+        .anterior = elo,
+        .profundidade = busca->elos[elo].profundidade + 1,
+        .caractere = caractere,
+    };
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Copia o prefixo buscado e preenche os caracteres dos elos de trás
+ *   para frente.
+ */
+void busca_ranqueada_aceitar(busca_ranqueada* busca, size_t elo) {
+    if (busca->falhou) {
+        return;
+    }
+
+    size_t tamanho = busca->tamanho_prefixo + busca->elos[elo].profundidade;
+    if (!garantir_tamanho_buffer(
+            &busca->buffer, &busca->capacidade_buffer, tamanho + 1)) {
+        busca->falhou = true;
+        return;
+    }
+
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(busca->buffer, busca->prefixo, busca->tamanho_prefixo);
+    busca->buffer[tamanho] = '\0';
+    for (size_t i = tamanho; elo != 0; elo = busca->elos[elo].anterior) {
+        busca->buffer[--i] = busca->elos[elo].caractere;
+    }
+
+    if (!lista_push(&busca->resultado, busca->buffer)) {
+        busca->falhou = true;
+    }
+}
+
+/*
+ * Implementação:
+ * - Libera fila, elos e buffer; em falha, libera também o resultado.
+ */
+char** busca_ranqueada_concluir(busca_ranqueada* busca, size_t* quantidade) {
+    free(busca->fila);
+    free(busca->elos);
+    free(busca->buffer);
+
+    if (busca->falhou) {
+        trie_liberar_lista(busca->resultado.palavras, busca->resultado.tamanho);
+        *quantidade = 0;
+        return NULL;
+    }
+
+    *quantidade = busca->resultado.tamanho;
+    return busca->resultado.palavras;
+}
@@ -0,0 +1,1026 @@
+/**
+ * @file snapshot.c
+ * @brief Implementação do snapshot binário da Trie.
+ */
+
+#include "snapshot.h"
+
+#include "arquivo.h"
+#include "distancia.h"
+#include "padrao.h"
+#include "ranqueamento.h"
+#include "trie.h"
+#include "util.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char MAGICO_SNAPSHOT[8] = {
+    'T', 'S', 'T', 'S', 'N', 'A', 'P', '\0'};
+
+/**
+ * @struct pendente_snapshot
+ * @brief Nó da Trie ainda não gravado e a ligação que aponta para ele.
+ */
+typedef struct {
+    const no_trie* no;
+    uint32_t pai;
+    int ligacao;
+} pendente_snapshot;
+
+enum { LIGACAO_ESQUERDA, LIGACAO_MEIO, LIGACAO_DIREITA };
+
+/*
+ * Implementação:
+ * - Empilha um nó pendente, dobrando a pilha se necessário.
+ * - Ignora filhos vazios.
+ */
+static bool empilhar_pendente(pendente_snapshot** pilha,
+                              size_t* topo,
+                              size_t* capacidade,
+                              pendente_snapshot item) {
+    if (!item.no) {
+        return true;
+    }
+
+    if (*topo == *capacidade) {
+        size_t nova_cap = *capacidade ? *capacidade * 2 : 64;
+        pendente_snapshot* tmp = realloc(*pilha, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            return false;
+        }
+        *pilha = tmp;
+        *capacidade = nova_cap;
+    }
+
+    (*pilha)[(*topo)++] = item;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Percorre a Trie em pré-ordem (nó, meio, esquerda, direita),
+ *   atribuindo índices na ordem de visita. Assim, a cadeia do meio
+ *   de cada palavra fica contígua no arquivo.
+ * - Ao visitar um nó, corrige a ligação do pai para o novo índice.
+ * - O vetor de nós dobra de tamanho conforme necessário.
+ */
+static bool
+serializar(const no_trie* raiz, no_snapshot** saida, size_t* total) {
+    pendente_snapshot* pilha = NULL;
+    size_t topo = 0;
+    size_t capacidade = 0;
+    no_snapshot* nos = NULL;
+    size_t quantidade = 0;
+    size_t capacidade_nos = 0;
+    bool ok = empilhar_pendente(
+        &pilha,
+        &topo,
+        &capacidade,
+        (pendente_snapshot){.no = raiz, .pai = 0, .ligacao = LIGACAO_MEIO});
+
+    while (ok && topo > 0) {
+        pendente_snapshot item = pilha[--topo];
+
+        if (quantidade == capacidade_nos) {
+            size_t nova_cap = capacidade_nos ? capacidade_nos * 2 : 1024;
+            no_snapshot* tmp = NULL;
+            if (nova_cap <= (size_t) UINT32_MAX + 1) {
+                tmp = realloc(nos, nova_cap * sizeof *tmp);
+            }
+            if (!tmp) {
+                ok = false;
+                break;
+            }
+            nos = tmp;
+            capacidade_nos = nova_cap;
+        }
+
+        uint32_t indice = (uint32_t) quantidade++;
+        nos[indice] = (no_snapshot){
+            .peso = item.no->peso,
+            .peso_maximo = item.no->peso_maximo,
+            .contagem = item.no->contagem,
+            .caractere = item.no->caractere,
+            .terminal = item.no->terminal ? 1 : 0,
+            .altura = item.no->altura,
+        };
+
+        if (indice > 0) {
+            no_snapshot* pai = &nos[item.pai];
+            if (item.ligacao == LIGACAO_ESQUERDA) {
+                pai->esquerdo = indice;
+            } else if (item.ligacao == LIGACAO_MEIO) {
+                pai->meio = indice;
+            } else {
+                pai->direito = indice;
+            }
+        }
+
+        pendente_snapshot filhos[] = {
+            {item.no->no_direito, indice, LIGACAO_DIREITA},
+            {item.no->no_esquerdo, indice, LIGACAO_ESQUERDA},
+            {item.no->no_meio, indice, LIGACAO_MEIO},
+        };
+        for (size_t i = 0; ok && i < 3; i++) {
+            ok = empilhar_pendente(&pilha, &topo, &capacidade, filhos[i]);
+        }
+    }
+
+    free(pilha);
+    if (!ok) {
+        free(nos);
+        return false;
+    }
+
+    *saida = nos;
+    *total = quantidade;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Monta o vetor de nós em memória.
+ * - Grava cabeçalho e vetor em "<caminho>.tmp", sincroniza com o
+ *   disco e renomeia para o caminho final apenas se tudo foi gravado.
+ * - Sincroniza também o diretório, para que a troca de nome não se
+ *   perca em uma queda do sistema.
+ */
+bool snapshot_salvar(const no_trie* raiz,
+                     size_t total_palavras,
+                     const char* caminho) {
+    if (!raiz || !caminho) {
+        return false;
+    }
+
+    no_snapshot* nos = NULL;
+    size_t total_nos = 0;
+    if (!serializar(raiz, &nos, &total_nos)) {
+        return false;
+    }
+
+    cabecalho_snapshot cabecalho = {
+        .versao = SNAPSHOT_VERSAO,
+        .tamanho_no = sizeof(no_snapshot),
+        .total_palavras = total_palavras,
+        .total_nos = total_nos,
+    };
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cabecalho.magico, MAGICO_SNAPSHOT, sizeof cabecalho.magico);
+
+    size_t tam_caminho = strlen(caminho);
+    char* temporario = malloc(tam_caminho + sizeof ".tmp");
+    if (!temporario) {
+        free(nos);
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(temporario, caminho, tam_caminho);
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(temporario + tam_caminho, ".tmp", sizeof ".tmp");
+
+    FILE* f = fopen(temporario, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        ok = fwrite(&cabecalho, sizeof cabecalho, 1, f) == 1 &&
+             fwrite(nos, sizeof *nos, total_nos, f) == total_nos &&
+             arquivo_sincronizar(f);
+        ok = (fclose(f) == 0) && ok;
+    }
+    if (ok) {
+        ok = rename(temporario, caminho) == 0;
+    }
+    if (ok) {
+        ok = arquivo_sincronizar_diretorio(caminho);
+    }
+    if (!ok) {
+        remove(temporario);
+    }
+
+    free(temporario);
+    free(nos);
+    return ok;
+}
+
+/**
+ * @struct limites_snapshot
+ * @brief Intervalo de caracteres aceito para um nó durante a validação.
+ *
+ * 'minimo' igual a INT16_MAX indica nó ainda não ligado a um pai.
+ */
+typedef struct {
+    int16_t minimo;
+    int16_t maximo;
+} limites_snapshot;
+
+/*
+ * Implementação:
+ * - Liga o filho ao intervalo informado; falha se o índice não vier
+ *   depois do pai, passar do vetor ou já tiver sido ligado.
+ */
+static bool ligar_filho(limites_snapshot* limites,
+                        size_t total,
+                        size_t pai,
+                        uint32_t filho,
+                        int minimo,
+                        int maximo) {
+    if (filho == 0) {
+        return true;
+    }
+    if (filho <= pai || filho >= total ||
+        limites[filho].minimo != INT16_MAX) {
+        return false;
+    }
+
+    limites[filho].minimo = (int16_t) minimo;
+    limites[filho].maximo = (int16_t) maximo;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Uma passagem em ordem de índice: cada filho vem depois do pai e
+ *   tem um único pai, então o grafo é uma árvore percorrida em
+ *   ordem crescente de índice (toda descida termina).
+ * - snapshot_salvar só grava nós alcançáveis: um nó sem pai (fora a
+ *   sentinela) torna o arquivo inválido, pois seus filhos nunca
+ *   seriam validados.
+ * - Os irmãos formam uma árvore de busca: o filho da esquerda herda
+ *   o intervalo abaixo do caractere do pai e o da direita, o acima;
+ *   o do meio começa um nível novo. Com caracteres distintos em cada
+ *   caminho de irmãos, a recursão por eles fica limitada ao alfabeto.
+ * - O total de palavras do cabeçalho deve ser a contagem do primeiro
+ *   nó abaixo da sentinela.
+ */
+static bool
+validar_nos(const no_snapshot* nos, size_t total, uint64_t total_palavras) {
+    limites_snapshot* limites = malloc(total * sizeof *limites);
+    if (!limites) {
+        return false;
+    }
+    for (size_t i = 0; i < total; i++) {
+        limites[i].minimo = INT16_MAX;
+    }
+    limites[0] = (limites_snapshot){.minimo = CHAR_MIN, .maximo = CHAR_MAX};
+
+    bool ok = true;
+    for (size_t i = 0; ok && i < total; i++) {
+        const no_snapshot* no = &nos[i];
+        int caractere = no->caractere;
+        ok = limites[i].minimo != INT16_MAX &&
+             caractere >= limites[i].minimo &&
+             caractere <= limites[i].maximo &&
+             ligar_filho(limites,
+                         total,
+                         i,
+                         no->esquerdo,
+                         limites[i].minimo,
+                         caractere - 1) &&
+             ligar_filho(limites,
+                         total,
+                         i,
+                         no->direito,
+                         caractere + 1,
+                         limites[i].maximo) &&
+             ligar_filho(limites, total, i, no->meio, CHAR_MIN, CHAR_MAX);
+    }
+
+    free(limites);
+    if (!ok) {
+        return false;
+    }
+    uint32_t contagem = nos[0].meio ? nos[nos[0].meio].contagem : 0;
+    return total_palavras == contagem;
+}
+
+/*
+ * Implementação:
+ * - Mapeia o arquivo para acesso aleatório.
+ * - Valida assinatura, versão, tamanho do nó e tamanho do arquivo.
+ * - Valida o grafo de nós uma única vez, antes de qualquer consulta.
+ */
+snapshot* snapshot_abrir(const char* caminho) {
+    if (!caminho) {
+        return NULL;
+    }
+
+    snapshot* s = calloc(1, sizeof *s);
+    if (!s) {
+        return NULL;
+    }
+
+    if (!arquivo_mapear(caminho, false, &s->arquivo)) {
+        free(s);
+        return NULL;
+    }
+
+    cabecalho_snapshot cabecalho;
+    bool valido = s->arquivo.tamanho >= sizeof cabecalho;
+    if (valido) {
+        // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+        memcpy(&cabecalho, s->arquivo.dados, sizeof cabecalho);
+        size_t bytes_nos = s->arquivo.tamanho - sizeof cabecalho;
+        valido = memcmp(cabecalho.magico,
+                        MAGICO_SNAPSHOT,
+                        sizeof cabecalho.magico) == 0 &&
+                 cabecalho.versao == SNAPSHOT_VERSAO &&
+                 cabecalho.tamanho_no == sizeof(no_snapshot) &&
+                 cabecalho.total_nos >= 1 &&
+                 bytes_nos % sizeof(no_snapshot) == 0 &&
+                 bytes_nos / sizeof(no_snapshot) == cabecalho.total_nos;
+    }
+    if (valido) {
+        valido = validar_nos(
+            (const no_snapshot*) (s->arquivo.dados + sizeof cabecalho),
+            (size_t) cabecalho.total_nos,
+            cabecalho.total_palavras);
+    }
+
+    if (!valido) {
+        arquivo_desmapear(&s->arquivo);
+        free(s);
+        return NULL;
+    }
+
+    s->nos = (const no_snapshot*) (s->arquivo.dados + sizeof cabecalho);
+    s->total_nos = (size_t) cabecalho.total_nos;
+    s->total_palavras = (size_t) cabecalho.total_palavras;
+    return s;
+}
+
+/*
+ * Implementação:
+ * - Primeira passagem: aloca e preenche os nós em ordem de índice.
+ * - Segunda passagem: liga os filhos. snapshot_abrir já garantiu que
+ *   cada índice vem depois do pai e é ligado uma única vez, então o
+ *   resultado é sempre uma árvore.
+ */
+no_trie* snapshot_copiar_para_trie(const snapshot* snapshot,
+                                   arena_nos* destino) {
+    if (!snapshot || !destino) {
+        return NULL;
+    }
+
+    size_t total = snapshot->total_nos;
+    no_trie** nos = malloc(total * sizeof *nos);
+    bool ok = nos != NULL;
+
+    for (size_t i = 0; ok && i < total; i++) {
+        const no_snapshot* origem = &snapshot->nos[i];
+        nos[i] = arena_alocar_no(destino);
+        ok = nos[i] != NULL;
+        if (ok) {
+            *nos[i] = (no_trie){
+                .peso = origem->peso,
+                .peso_maximo = origem->peso_maximo,
+                .contagem = origem->contagem,
+                .terminal = origem->terminal != 0,
+                .caractere = origem->caractere,
+                .altura = origem->altura,
+            };
+        }
+    }
+
+    for (size_t i = 0; ok && i < total; i++) {
+        const no_snapshot* origem = &snapshot->nos[i];
+        const uint32_t filhos[] = {
+            origem->esquerdo, origem->meio, origem->direito};
+        no_trie** ligacoes[] = {
+            &nos[i]->no_esquerdo, &nos[i]->no_meio, &nos[i]->no_direito};
+        for (size_t j = 0; j < 3; j++) {
+            if (filhos[j] != 0) {
+                *ligacoes[j] = nos[filhos[j]];
+            }
+        }
+    }
+
+    no_trie* raiz = ok ? nos[0] : NULL;
+    free((void*) nos);
+    return raiz;
+}
+
+/*
+ * Implementação:
+ * - Lê apenas os primeiros bytes e compara com a assinatura.
+ */
+bool snapshot_eh_arquivo(const char* caminho) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) {
+        return false;
+    }
+
+    char magico[sizeof MAGICO_SNAPSHOT];
+    bool eh = fread(magico, 1, sizeof magico, f) == sizeof magico &&
+              memcmp(magico, MAGICO_SNAPSHOT, sizeof magico) == 0;
+    fclose(f);
+    return eh;
+}
+
+/*
+ * Implementação:
+ * - Desfaz o mapeamento e libera a estrutura.
+ */
+void snapshot_fechar(snapshot* snapshot) {
+    if (!snapshot) {
+        return;
+    }
+
+    arquivo_desmapear(&snapshot->arquivo);
+    free(snapshot);
+}
+
+/*
+ * Implementação:
+ * - Converte índice em nó, tratando 0 e índices fora do vetor
+ *   (arquivo corrompido) como ausência de filho.
+ */
+static const no_snapshot* no_em(const snapshot* s, uint32_t indice) {
+    if (indice == 0 || indice >= s->total_nos) {
+        return NULL;
+    }
+    return &s->nos[indice];
+}
+
+/*
+ * Implementação:
+ * - Mesma descida de trie_localizar, sobre índices.
+ * - Retorna o nó do último caractere do prefixo ou NULL.
+ */
+static const no_snapshot* snapshot_localizar(const snapshot* s,
+                                             const char* prefixo) {
+    const no_snapshot* atual = no_em(s, s->nos[0].meio);
+    const char* p = prefixo;
+
+    while (atual && *p) {
+        if (*p < atual->caractere) {
+            atual = no_em(s, atual->esquerdo);
+        } else if (*p > atual->caractere) {
+            atual = no_em(s, atual->direito);
+        } else {
+            p++;
+            if (*p) {
+                atual = no_em(s, atual->meio);
+            }
+        }
+    }
+
+    return atual;
+}
+
+/*
+ * Implementação:
+ * - A palavra existe se o nó do seu último caractere for terminal.
+ */
+bool snapshot_contem(const snapshot* snapshot, const char* palavra) {
+    if (!snapshot || !palavra || !*palavra) {
+        return false;
+    }
+
+    const no_snapshot* no = snapshot_localizar(snapshot, palavra);
+    return no && no->terminal;
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de buscar_aproximado_rec (trie.c), sobre índices.
+ */
+static void snapshot_aproximado_rec(const snapshot* s,
+                                    const no_snapshot* no,
+                                    size_t profundidade,
+                                    busca_aproximada* busca) {
+    while (no && !busca->falhou) {
+        snapshot_aproximado_rec(
+            s, no_em(s, no->esquerdo), profundidade, busca);
+
+        size_t minimo =
+            busca_aproximada_avancar(busca, profundidade, no->caractere);
+        if (no->terminal) {
+            busca_aproximada_aceitar(busca, profundidade + 1);
+        }
+        if (minimo <= busca->max_distancia) {
+            snapshot_aproximado_rec(
+                s, no_em(s, no->meio), profundidade + 1, busca);
+        }
+
+        no = no_em(s, no->direito);
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir do filho do meio da sentinela (índice 0).
+ */
+char** snapshot_buscar_aproximado(const snapshot* snapshot,
+                                  const char* palavra,
+                                  size_t max_distancia,
+                                  size_t* quantidade) {
+    if (!snapshot || !palavra || !quantidade) {
+        return NULL;
+    }
+
+    busca_aproximada busca;
+    if (busca_aproximada_iniciar(&busca, palavra, max_distancia)) {
+        snapshot_aproximado_rec(
+            snapshot, no_em(snapshot, snapshot->nos[0].meio), 0, &busca);
+    }
+
+    return busca_aproximada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de buscar_padrao_rec (trie.c), sobre índices.
+ */
+static void snapshot_padrao_rec(const snapshot* s,
+                                const no_snapshot* no,
+                                size_t profundidade,
+                                busca_padrao* busca) {
+    char minimo = 0;
+    char maximo = 0;
+    busca_padrao_limites(busca, profundidade, &minimo, &maximo);
+
+    while (no && !busca->falhou) {
+        if (minimo < no->caractere) {
+            snapshot_padrao_rec(s, no_em(s, no->esquerdo), profundidade, busca);
+        }
+
+        if (no->caractere >= minimo && no->caractere <= maximo) {
+            bool continuar =
+                busca_padrao_avancar(busca, profundidade, no->caractere);
+            if (no->terminal) {
+                busca_padrao_aceitar(busca, profundidade + 1);
+            }
+            if (continuar) {
+                snapshot_padrao_rec(
+                    s, no_em(s, no->meio), profundidade + 1, busca);
+            }
+        }
+
+        if (maximo <= no->caractere) {
+            break;
+        }
+        no = no_em(s, no->direito);
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir do filho do meio da sentinela (índice 0).
+ */
+char** snapshot_buscar_padrao(const snapshot* snapshot,
+                              const char* padrao,
+                              size_t* quantidade) {
+    if (!snapshot || !padrao || !*padrao || !quantidade) {
+        return NULL;
+    }
+
+    busca_padrao busca;
+    if (busca_padrao_iniciar(&busca, padrao)) {
+        snapshot_padrao_rec(
+            snapshot, no_em(snapshot, snapshot->nos[0].meio), 0, &busca);
+    }
+
+    return busca_padrao_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Enfileira a subárvore do índice, ignorando índices sem nó.
+ */
+static void snapshot_enfileirar(busca_ranqueada* busca,
+                                const snapshot* s,
+                                uint32_t indice,
+                                size_t elo) {
+    const no_snapshot* no = no_em(s, indice);
+    if (no) {
+        busca_ranqueada_inserir(
+            busca,
+            (candidato_ranqueado){
+                .no = indice, .elo = elo, .peso = no->peso_maximo});
+    }
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_buscar_por_prefixo_ranqueado, sobre
+ *   índices.
+ */
+char** snapshot_buscar_por_prefixo_ranqueado(const snapshot* snapshot,
+                                             const char* prefixo,
+                                             size_t k,
+                                             size_t* quantidade) {
+    if (!snapshot || !quantidade) {
+        return NULL;
+    }
+
+    if (!prefixo) {
+        prefixo = "";
+    }
+
+    busca_ranqueada busca;
+    if (k == 0 || !busca_ranqueada_iniciar(&busca, prefixo)) {
+        *quantidade = 0;
+        return NULL;
+    }
+
+    if (!*prefixo) {
+        snapshot_enfileirar(&busca, snapshot, snapshot->nos[0].meio, 0);
+    } else {
+        const no_snapshot* no = snapshot_localizar(snapshot, prefixo);
+        if (no) {
+            uint32_t indice = (uint32_t) (no - snapshot->nos);
+            if (no->terminal) {
+                busca_ranqueada_inserir(&busca,
+                                        (candidato_ranqueado){
+                                            .no = indice,
+                                            .peso = no->peso,
+                                            .completo = true});
+            }
+            snapshot_enfileirar(&busca, snapshot, no->meio, 0);
+        }
+    }
+
+    candidato_ranqueado candidato;
+    while (busca.resultado.tamanho < k &&
+           busca_ranqueada_retirar(&busca, &candidato)) {
+        if (candidato.completo) {
+            busca_ranqueada_aceitar(&busca, candidato.elo);
+            continue;
+        }
+
+        const no_snapshot* no = &snapshot->nos[candidato.no];
+        snapshot_enfileirar(&busca, snapshot, no->esquerdo, candidato.elo);
+        snapshot_enfileirar(&busca, snapshot, no->direito, candidato.elo);
+
+        size_t elo;
+        if (!busca_ranqueada_estender(
+                &busca, candidato.elo, no->caractere, &elo)) {
+            break;
+        }
+        if (no->terminal) {
+            busca_ranqueada_inserir(&busca,
+                                    (candidato_ranqueado){.no = candidato.no,
+                                                          .elo = elo,
+                                                          .peso = no->peso,
+                                                          .completo = true});
+        }
+        snapshot_enfileirar(&busca, snapshot, no->meio, elo);
+    }
+
+    return busca_ranqueada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Empilha um quadro na fase inicial, dobrando a pilha se necessário.
+ * - Ignora índices que não representam nó.
+ */
+static bool snapshot_cursor_empilhar(snapshot_cursor* cursor,
+                                     uint32_t indice,
+                                     size_t profundidade) {
+    if (!no_em(cursor->snapshot, indice)) {
+        return true;
+    }
+
+    if (cursor->topo == cursor->capacidade_pilha) {
+        size_t nova_cap =
+            cursor->capacidade_pilha ? cursor->capacidade_pilha * 2 : 32;
+        snapshot_quadro* tmp =
+            realloc(cursor->pilha, nova_cap * sizeof *cursor->pilha);
+        if (!tmp) {
+            cursor->falhou = true;
+            return false;
+        }
+        cursor->pilha = tmp;
+        cursor->capacidade_pilha = nova_cap;
+    }
+
+    cursor->pilha[cursor->topo++] = (snapshot_quadro){
+        .no = indice, .fase = 0, .profundidade = profundidade};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_cursor_abrir, sobre índices.
+ */
+bool snapshot_cursor_abrir(snapshot_cursor* cursor,
+                           const snapshot* snapshot,
+                           const char* prefixo) {
+    *cursor = (snapshot_cursor){.snapshot = snapshot};
+    if (!snapshot) {
+        return true;
+    }
+
+    size_t len = prefixo ? strlen(prefixo) : 0;
+    if (!garantir_tamanho_buffer(
+            &cursor->buffer, &cursor->capacidade_buffer, len + 1)) {
+        cursor->falhou = true;
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cursor->buffer, prefixo ? prefixo : "", len);
+    cursor->buffer[len] = '\0';
+
+    if (len == 0) {
+        return snapshot_cursor_empilhar(cursor, snapshot->nos[0].meio, 0);
+    }
+
+    const no_snapshot* no = snapshot_localizar(snapshot, prefixo);
+    if (!no) {
+        return true;
+    }
+
+    cursor->prefixo_pendente = no->terminal;
+    return snapshot_cursor_empilhar(cursor, no->meio, len);
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso em ordem de trie_cursor_proximo, sobre índices.
+ */
+const char* snapshot_cursor_proximo(snapshot_cursor* cursor) {
+    if (cursor->prefixo_pendente) {
+        cursor->prefixo_pendente = false;
+        return cursor->buffer;
+    }
+
+    while (cursor->topo > 0 && !cursor->falhou) {
+        snapshot_quadro* q = &cursor->pilha[cursor->topo - 1];
+        const no_snapshot* no = &cursor->snapshot->nos[q->no];
+        size_t profundidade = q->profundidade;
+
+        if (q->fase == 0) {
+            q->fase = 1;
+            snapshot_cursor_empilhar(cursor, no->esquerdo, profundidade);
+            continue;
+        }
+
+        if (q->fase == 1) {
+            q->fase = 2;
+            if (!garantir_tamanho_buffer(&cursor->buffer,
+                                         &cursor->capacidade_buffer,
+                                         profundidade + 2)) {
+                cursor->falhou = true;
+                break;
+            }
+            cursor->buffer[profundidade] = no->caractere;
+            snapshot_cursor_empilhar(cursor, no->meio, profundidade + 1);
+            if (no->terminal) {
+                cursor->buffer[profundidade + 1] = '\0';
+                return cursor->buffer;
+            }
+            continue;
+        }
+
+        cursor->topo--;
+        snapshot_cursor_empilhar(cursor, no->direito, profundidade);
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Libera pilha e buffer; o cursor pode ser reaberto depois.
+ */
+void snapshot_cursor_fechar(snapshot_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    free(cursor->pilha);
+    free(cursor->buffer);
+    *cursor = (snapshot_cursor){0};
+}
+
+/*
+ * Implementação:
+ * - Quantidade de palavras da subárvore do índice (0 se não houver nó).
+ */
+static size_t contagem_em(const snapshot* s, uint32_t indice) {
+    const no_snapshot* no = no_em(s, indice);
+    return no ? no->contagem : 0;
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_contar_prefixo, sobre índices.
+ */
+size_t snapshot_contar_prefixo(const snapshot* snapshot, const char* prefixo) {
+    if (!snapshot) {
+        return 0;
+    }
+
+    if (!prefixo || !*prefixo) {
+        return contagem_em(snapshot, snapshot->nos[0].meio);
+    }
+
+    const no_snapshot* no = snapshot_localizar(snapshot, prefixo);
+    if (!no) {
+        return 0;
+    }
+
+    return (no->terminal ? 1 : 0) + contagem_em(snapshot, no->meio);
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_rank, sobre índices.
+ */
+size_t snapshot_rank(const snapshot* snapshot, const char* palavra) {
+    if (!snapshot || !palavra) {
+        return 0;
+    }
+
+    size_t posicao = 0;
+    const no_snapshot* no = no_em(snapshot, snapshot->nos[0].meio);
+    while (no && *palavra) {
+        if (*palavra < no->caractere) {
+            no = no_em(snapshot, no->esquerdo);
+        } else if (*palavra > no->caractere) {
+            posicao += no->contagem - contagem_em(snapshot, no->direito);
+            no = no_em(snapshot, no->direito);
+        } else {
+            posicao += contagem_em(snapshot, no->esquerdo);
+            if (*++palavra == '\0') {
+                break;
+            }
+            posicao += no->terminal ? 1 : 0;
+            no = no_em(snapshot, no->meio);
+        }
+    }
+
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_selecionar, sobre índices.
+ */
+char* snapshot_selecionar(const snapshot* snapshot, size_t k) {
+    if (!snapshot || k >= contagem_em(snapshot, snapshot->nos[0].meio)) {
+        return NULL;
+    }
+
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    size_t tamanho = 0;
+    const no_snapshot* no = no_em(snapshot, snapshot->nos[0].meio);
+
+    while (no) {
+        size_t esquerda = contagem_em(snapshot, no->esquerdo);
+        if (k < esquerda) {
+            no = no_em(snapshot, no->esquerdo);
+            continue;
+        }
+        k -= esquerda;
+
+        if (!garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 2)) {
+            free(buffer);
+            return NULL;
+        }
+
+        if (no->terminal) {
+            if (k == 0) {
+                buffer[tamanho++] = no->caractere;
+                buffer[tamanho] = '\0';
+                return buffer;
+            }
+            k--;
+        }
+
+        size_t meio = contagem_em(snapshot, no->meio);
+        if (k < meio) {
+            buffer[tamanho++] = no->caractere;
+            no = no_em(snapshot, no->meio);
+        } else {
+            k -= meio;
+            no = no_em(snapshot, no->direito);
+        }
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+/**
+ * @struct varredura_snapshot
+ * @brief Somas acumuladas durante snapshot_coletar_estatisticas.
+ */
+typedef struct {
+    estatisticas_trie* saida;
+    size_t palavras;
+    size_t soma_profundidades;
+    size_t soma_comprimentos;
+    size_t soma_alturas;
+} varredura_snapshot;
+
+/*
+ * Implementação:
+ * - Contabiliza um conjunto de irmãos de altura e tamanho dados, como
+ *   na varredura da trie.
+ */
+static void registrar_irmaos(varredura_snapshot* v,
+                             size_t altura,
+                             size_t tamanho) {
+    estatisticas_trie* e = v->saida;
+    size_t faixa =
+        altura < TRIE_FAIXAS_IRMAOS ? altura : TRIE_FAIXAS_IRMAOS - 1;
+
+    e->histograma_irmaos[faixa]++;
+    e->conjuntos_irmaos++;
+    v->soma_alturas += altura;
+    if (altura > e->altura_maxima_irmaos) {
+        e->altura_maxima_irmaos = altura;
+    }
+    if (tamanho >= 3 && altura == tamanho) {
+        e->conjuntos_degenerados++;
+    }
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de coletar_estatisticas_rec na trie, sobre índices.
+ */
+static size_t coletar_estatisticas_rec(const snapshot* s,
+                                       const no_snapshot* no,
+                                       size_t profundidade,
+                                       size_t comprimento,
+                                       size_t* tamanho,
+                                       varredura_snapshot* v) {
+    if (!no) {
+        return 0;
+    }
+
+    estatisticas_trie* e = v->saida;
+    (*tamanho)++;
+
+    if (no->terminal) {
+        v->palavras++;
+        v->soma_profundidades += profundidade;
+        v->soma_comprimentos += comprimento;
+        if (profundidade > e->profundidade_maxima) {
+            e->profundidade_maxima = profundidade;
+        }
+        if (comprimento > e->comprimento_maximo) {
+            e->comprimento_maximo = comprimento;
+        }
+    }
+
+    const no_snapshot* meio = no_em(s, no->meio);
+    if (meio) {
+        size_t tamanho_meio = 0;
+        size_t altura_meio = coletar_estatisticas_rec(
+            s, meio, profundidade + 1, comprimento + 1, &tamanho_meio, v);
+        registrar_irmaos(v, altura_meio, tamanho_meio);
+    }
+
+    size_t esquerda = coletar_estatisticas_rec(s,
+                                               no_em(s, no->esquerdo),
+                                               profundidade + 1,
+                                               comprimento,
+                                               tamanho,
+                                               v);
+    size_t direita = coletar_estatisticas_rec(s,
+                                              no_em(s, no->direito),
+                                              profundidade + 1,
+                                              comprimento,
+                                              tamanho,
+                                              v);
+
+    return 1 + (esquerda > direita ? esquerda : direita);
+}
+
+/*
+ * Implementação:
+ * - Zera a saída e percorre a partir do filho do meio da sentinela.
+ * - Converte as somas em médias ao final.
+ */
+void snapshot_coletar_estatisticas(const snapshot* snapshot,
+                                   estatisticas_trie* estatisticas) {
+    *estatisticas = (estatisticas_trie){0};
+    const no_snapshot* primeiro = no_em(snapshot, snapshot->nos[0].meio);
+    if (!primeiro) {
+        return;
+    }
+
+    varredura_snapshot v = {.saida = estatisticas};
+    size_t tamanho = 0;
+    size_t altura =
+        coletar_estatisticas_rec(snapshot, primeiro, 1, 1, &tamanho, &v);
+    registrar_irmaos(&v, altura, tamanho);
+
+    if (v.palavras > 0) {
+        estatisticas->profundidade_media =
+            (double) v.soma_profundidades / (double) v.palavras;
+        estatisticas->comprimento_medio =
+            (double) v.soma_comprimentos / (double) v.palavras;
+    }
+    estatisticas->altura_media_irmaos =
+        (double) v.soma_alturas / (double) estatisticas->conjuntos_irmaos;
+}
@@ -5,118 +5,447 @@
 
 #include "trie.h"
 
+#include "distancia.h"
+#include "padrao.h"
+#include "ranqueamento.h"
 #include "util.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define TRIE_VIAS_LOTE 8
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(endereco) __builtin_prefetch(endereco)
+#else
+#define PREFETCH(endereco) ((void) (endereco))
+#endif
+
 /**
- * @struct lista_palavras
- * @brief Array dinâmico de strings.
- *
- * Armazena o array de strings de forma dinâmica,
- * sempre atualizando a capacidade e tamanho.
+ * @struct via_busca
+ * @brief Estado de uma busca em andamento na busca em lote.
  */
-typedef struct {
-    char** palavras;
-    size_t tamanho;
-    size_t capacidade;
-} lista_palavras;
+typedef struct via_busca {
+    const no_trie* no;
+    const char* resto;
+    size_t indice;
+} via_busca;
 
 /*
  * Implementação:
- * - Assume capacidade inicial como 8.
- * - Quando tamanho for igual a capacidade, capacidade é dobrada.
+ * - Empilha um quadro na fase inicial, dobrando a pilha se necessário.
+ * - Ignora subárvores vazias.
  */
-static bool lista_push(lista_palavras* l, const char* palavra) {
-    if (l->tamanho == l->capacidade) {
-        size_t nova_cap = l->capacidade ? l->capacidade * 2 : 8;
-        char** tmp =
-            (char**) realloc((void*) l->palavras, nova_cap * sizeof *tmp);
+static bool
+cursor_empilhar(trie_cursor* cursor, const no_trie* no, size_t profundidade) {
+    if (!no) {
+        return true;
+    }
+
+    if (cursor->topo == cursor->capacidade_pilha) {
+        size_t nova_cap =
+            cursor->capacidade_pilha ? cursor->capacidade_pilha * 2 : 32;
+        trie_quadro* tmp =
+            realloc(cursor->pilha, nova_cap * sizeof *cursor->pilha);
         if (!tmp) {
+            cursor->falhou = true;
             return false;
         }
-        l->palavras = tmp;
-        l->capacidade = nova_cap;
+        cursor->pilha = tmp;
+        cursor->capacidade_pilha = nova_cap;
     }
 
-    char* dup = string_dup(palavra);
-    if (!dup) {
-        return false;
+    cursor->pilha[cursor->topo++] =
+        (trie_quadro){.no = no, .profundidade = profundidade, .fase = 0};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Desce pela árvore consumindo o prefixo.
+ * - Retorna o nó do último caractere do prefixo ou NULL se não existir.
+ */
+static const no_trie* trie_localizar(const no_trie* raiz, const char* prefixo) {
+    const no_trie* atual = raiz->no_meio;
+    const char* p = prefixo;
+
+    while (atual && *p) {
+        if (*p < atual->caractere) {
+            atual = atual->no_esquerdo;
+        } else if (*p > atual->caractere) {
+            atual = atual->no_direito;
+        } else {
+            p++;
+            if (*p) {
+                atual = atual->no_meio;
+            }
+        }
     }
 
-    l->palavras[l->tamanho++] = dup;
-    return true;
+    return atual;
 }
 
 /*
  * Implementação:
- * - Função utilitária para garantir crescimento seguro de buffer.
- * - Assume capacidade inicial de 32.
- * - Quando necessário, dobra a capacidade.
+ * - Consome o cursor copiando cada palavra para a lista.
+ * - Para após 'limite' palavras, deixando o restante sem visitar.
  */
 static bool
-garantir_tamanho_buffer(char** buf, size_t* cap, size_t necessario) {
-    if (necessario <= *cap) {
-        return true;
+cursor_coletar(trie_cursor* cursor, lista_palavras* lista, size_t limite) {
+    const char* palavra = NULL;
+
+    while (lista->tamanho < limite &&
+           (palavra = trie_cursor_proximo(cursor))) {
+        if (!lista_push(lista, palavra)) {
+            return false;
+        }
     }
 
-    size_t nova_cap = *cap ? *cap * 2 : 32;
-    while (nova_cap < necessario) {
-        nova_cap *= 2;
+    return !cursor->falhou;
+}
+
+/*
+ * Implementação:
+ * - Soma o comprimento do caminho de cada nó terminal e guarda o maior.
+ * - 'comprimento' conta os nós visitados até 'no', inclusive.
+ */
+static void medir_caminhos_rec(const no_trie* no,
+                               size_t comprimento,
+                               size_t* soma,
+                               size_t* palavras,
+                               size_t* maximo) {
+    if (!no) {
+        return;
     }
 
-    char* tmp = realloc(*buf, nova_cap);
-    if (!tmp) {
-        return false;
+    if (no->terminal) {
+        *soma += comprimento;
+        (*palavras)++;
+        if (comprimento > *maximo) {
+            *maximo = comprimento;
+        }
     }
 
-    *buf = tmp;
-    *cap = nova_cap;
-    return true;
+    medir_caminhos_rec(
+        no->no_esquerdo, comprimento + 1, soma, palavras, maximo);
+    medir_caminhos_rec(no->no_meio, comprimento + 1, soma, palavras, maximo);
+    medir_caminhos_rec(
+        no->no_direito, comprimento + 1, soma, palavras, maximo);
 }
 
 /*
  * Implementação:
- * - Função interna utilizada para obter as palavras contidas na Trie.
- * - Obtém palavras em ordem lexicográfica.
+ * - Percurso em ordem (esquerda, nó, meio, direita), de modo que as
+ *   palavras saem em ordem lexicográfica.
+ * - Irmãos compartilham a linha do pai ('profundidade'); o filho do
+ *   meio só é visitado se a linha do nó ainda admitir a distância.
+ * - A subárvore direita é percorrida no próprio laço.
  */
-static bool tst_coletar(no_trie* no,
-                        char** buffer,
-                        size_t* capacidade,
-                        size_t profundidade,
-                        lista_palavras* lista) {
-    if (!no) {
+static void buscar_aproximado_rec(const no_trie* no,
+                                  size_t profundidade,
+                                  busca_aproximada* busca) {
+    while (no && !busca->falhou) {
+        buscar_aproximado_rec(no->no_esquerdo, profundidade, busca);
+
+        size_t minimo =
+            busca_aproximada_avancar(busca, profundidade, no->caractere);
+        if (no->terminal) {
+            busca_aproximada_aceitar(busca, profundidade + 1);
+        }
+        if (minimo <= busca->max_distancia) {
+            buscar_aproximado_rec(no->no_meio, profundidade + 1, busca);
+        }
+
+        no = no->no_direito;
+    }
+}
+
+/*
+ * Implementação:
+ * - Percurso em ordem, como em buscar_aproximado_rec.
+ * - Os irmãos são uma árvore de busca: sem curinga ativo, só se desce
+ *   à esquerda/direita se ainda houver letra do padrão naquele lado.
+ * - O filho do meio só é visitado se o padrão ainda consumir letras.
+ */
+static void buscar_padrao_rec(const no_trie* no,
+                              size_t profundidade,
+                              busca_padrao* busca) {
+    char minimo = 0;
+    char maximo = 0;
+    busca_padrao_limites(busca, profundidade, &minimo, &maximo);
+
+    while (no && !busca->falhou) {
+        if (minimo < no->caractere) {
+            buscar_padrao_rec(no->no_esquerdo, profundidade, busca);
+        }
+
+        if (no->caractere >= minimo && no->caractere <= maximo) {
+            bool continuar =
+                busca_padrao_avancar(busca, profundidade, no->caractere);
+            if (no->terminal) {
+                busca_padrao_aceitar(busca, profundidade + 1);
+            }
+            if (continuar) {
+                buscar_padrao_rec(no->no_meio, profundidade + 1, busca);
+            }
+        }
+
+        if (maximo <= no->caractere) {
+            break;
+        }
+        no = no->no_direito;
+    }
+}
+
+/*
+ * Implementação:
+ * - Obtém nó da arena quando houver uma; do contrário, usa calloc.
+ */
+static no_trie* no_alocar(arena_nos* arena) {
+    if (arena) {
+        return arena_alocar_no(arena);
+    }
+    return calloc(1, sizeof(no_trie));
+}
+
+/*
+ * Implementação:
+ * - Devolve o nó para a arena de origem ou para o heap.
+ */
+static void no_liberar(arena_nos* arena, no_trie* no) {
+    if (arena) {
+        arena_liberar_no(arena, no);
+    } else {
+        free(no);
+    }
+}
+
+/**
+ * @struct escrita_trie
+ * @brief Contexto compartilhado pelas rotinas recursivas de alteração.
+ *
+ * Com 'aposentar' NULL os nós são alterados no lugar. Do contrário,
+ * todo nó já existente é copiado antes de ser alterado e o original é
+ * entregue a 'aposentar', sem ser modificado nem liberado.
+ * Na inserção, 'peso' é gravado no nó final se 'com_peso' for true.
+ * Na remoção, com 'adiar_poda' os nós que ficam vazios não são
+ * liberados (ver trie_desmarcar).
+ * Com 'balancear', cada nó alterado tem sua árvore de irmãos
+ * rebalanceada por rotações (ver trie_balancear).
+ */
+typedef struct escrita_trie {
+    arena_nos* arena;
+    trie_aposentar aposentar;
+    void* contexto;
+    uint32_t peso;
+    bool com_peso;
+    bool adiar_poda;
+    bool balancear;
+    bool falhou;
+} escrita_trie;
+
+/*
+ * Implementação:
+ * - Um nó privado (criado ou já copiado nesta operação) ainda não é
+ *   visível e pode ser alterado diretamente, assim como qualquer nó
+ *   no modo sem cópia.
+ * - Nos demais casos, troca *no por uma cópia e aposenta o original.
+ * - Retorna false (e marca a falha) se a cópia não puder ser alocada;
+ *   nesse caso *no não muda.
+ */
+static bool
+tornar_privado(no_trie** no, bool* privado, escrita_trie* escrita) {
+    if (*privado || !escrita->aposentar) {
         return true;
     }
 
-    if (!tst_coletar(
-            no->no_esquerdo, buffer, capacidade, profundidade, lista)) {
+    no_trie* copia = no_alocar(escrita->arena);
+    if (!copia) {
+        escrita->falhou = true;
         return false;
     }
 
-    if (no->caractere != '\0') {
-        if (!garantir_tamanho_buffer(buffer, capacidade, profundidade + 2)) {
-            return false;
-        }
+    *copia = **no;
+    escrita->aposentar(*no, escrita->contexto);
+    *no = copia;
+    *privado = true;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Descarta um nó que saiu da árvore. Um nó privado (ou qualquer nó
+ *   no modo sem cópia) não é visível e volta direto para a arena.
+ * - Um nó já publicado ainda pode estar em uso por leitores e é
+ *   entregue a 'aposentar', como em tornar_privado.
+ */
+static void
+descartar_no(no_trie* no, bool privado, escrita_trie* escrita) {
+    if (privado || !escrita->aposentar) {
+        no_liberar(escrita->arena, no);
+    } else {
+        escrita->aposentar(no, escrita->contexto);
+    }
+}
+
+/*
+ * Implementação:
+ * - Quantidade de palavras da subárvore (0 para subárvore vazia).
+ */
+static size_t contagem_de(const no_trie* no) {
+    return no ? no->contagem : 0;
+}
 
-        (*buffer)[profundidade] = no->caractere;
+/*
+ * Implementação:
+ * - Maior peso entre a palavra do próprio nó e as três subárvores.
+ * - Soma a palavra do próprio nó às contagens das três subárvores.
+ */
+static void calcular_agregados(const no_trie* no,
+                               uint32_t* peso_maximo,
+                               uint32_t* contagem) {
+    uint32_t maximo = no->terminal ? no->peso : 0;
+    uint32_t total = no->terminal ? 1 : 0;
+    const no_trie* filhos[] = {no->no_esquerdo, no->no_meio, no->no_direito};
 
-        if (no->terminal) {
-            (*buffer)[profundidade + 1] = '\0';
-            if (!lista_push(lista, *buffer)) {
-                return false;
+    for (size_t i = 0; i < 3; i++) {
+        if (filhos[i]) {
+            if (filhos[i]->peso_maximo > maximo) {
+                maximo = filhos[i]->peso_maximo;
             }
+            total += filhos[i]->contagem;
         }
+    }
 
-        if (!tst_coletar(
-                no->no_meio, buffer, capacidade, profundidade + 1, lista)) {
-            return false;
+    *peso_maximo = maximo;
+    *contagem = total;
+}
+
+/*
+ * Implementação:
+ * - Recalcula os campos agregados a partir dos filhos e só altera
+ *   (e, no modo com cópia, copia) o nó se algum valor mudou.
+ */
+static void
+atualizar_agregados(no_trie** no, bool* privado, escrita_trie* escrita) {
+    uint32_t maximo = 0;
+    uint32_t contagem = 0;
+    calcular_agregados(*no, &maximo, &contagem);
+    if ((maximo != (*no)->peso_maximo || contagem != (*no)->contagem) &&
+        tornar_privado(no, privado, escrita)) {
+        (*no)->peso_maximo = maximo;
+        (*no)->contagem = contagem;
+    }
+}
+
+/*
+ * Implementação:
+ * - Altura da árvore de irmãos (0 para subárvore vazia).
+ */
+static int altura_de(const no_trie* no) {
+    return no ? no->altura : 0;
+}
+
+/*
+ * Implementação:
+ * - Um a mais que a maior altura entre os irmãos esquerdo e direito.
+ */
+static uint8_t calcular_altura(const no_trie* no) {
+    int esquerda = altura_de(no->no_esquerdo);
+    int direita = altura_de(no->no_direito);
+    return (uint8_t) (1 + (esquerda > direita ? esquerda : direita));
+}
+
+/*
+ * Implementação:
+ * - Sobe o filho esquerdo (ou, com 'para_esquerda', o direito) para o
+ *   lugar de *no, que desce para o lado oposto.
+ * - Os dois nós são tornados privados; no modo com cópia, o filho é
+ *   sempre copiado, mesmo que já seja uma cópia desta operação.
+ * - Recalcula altura e agregados do nó que desceu e do que subiu.
+ */
+static bool girar(no_trie** no,
+                  bool* privado,
+                  bool para_esquerda,
+                  escrita_trie* escrita) {
+    if (!tornar_privado(no, privado, escrita)) {
+        return false;
+    }
+
+    no_trie* x = *no;
+    no_trie* filho = para_esquerda ? x->no_direito : x->no_esquerdo;
+    bool filho_privado = false;
+    if (!tornar_privado(&filho, &filho_privado, escrita)) {
+        return false;
+    }
+
+    if (para_esquerda) {
+        x->no_direito = filho->no_esquerdo;
+        filho->no_esquerdo = x;
+    } else {
+        x->no_esquerdo = filho->no_direito;
+        filho->no_direito = x;
+    }
+
+    x->altura = calcular_altura(x);
+    calcular_agregados(x, &x->peso_maximo, &x->contagem);
+    filho->altura = calcular_altura(filho);
+    calcular_agregados(filho, &filho->peso_maximo, &filho->contagem);
+    *no = filho;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Enquanto as alturas dos irmãos esquerdo e direito diferirem em
+ *   mais de 1, gira para o lado mais baixo (com rotação dupla se o
+ *   neto interno for o mais alto, como na árvore AVL) e rebalanceia o
+ *   nó que desceu. Após uma inserção ou remoção simples a diferença
+ *   é no máximo 2 e basta uma rotação; a remoção em lote pode deixar
+ *   diferenças maiores.
+ * - Por fim, atualiza a altura de *no se ela mudou.
+ */
+static void
+balancear_irmaos(no_trie** no, bool* privado, escrita_trie* escrita) {
+    int fator = altura_de((*no)->no_esquerdo) - altura_de((*no)->no_direito);
+
+    while ((fator > 1 || fator < -1) && !escrita->falhou) {
+        if (!tornar_privado(no, privado, escrita)) {
+            return;
+        }
+
+        bool para_esquerda = fator < 0;
+        no_trie** alto =
+            para_esquerda ? &(*no)->no_direito : &(*no)->no_esquerdo;
+        int interno = para_esquerda ? altura_de((*alto)->no_esquerdo)
+                                    : altura_de((*alto)->no_direito);
+        int externo = para_esquerda ? altura_de((*alto)->no_direito)
+                                    : altura_de((*alto)->no_esquerdo);
+        bool alto_privado = false;
+        if (interno > externo &&
+            !girar(alto, &alto_privado, !para_esquerda, escrita)) {
+            return;
+        }
+        if (!girar(no, privado, para_esquerda, escrita)) {
+            return;
         }
+
+        no_trie** desceu =
+            para_esquerda ? &(*no)->no_esquerdo : &(*no)->no_direito;
+        bool desceu_privado = true;
+        balancear_irmaos(desceu, &desceu_privado, escrita);
+        (*no)->altura = calcular_altura(*no);
+        calcular_agregados(*no, &(*no)->peso_maximo, &(*no)->contagem);
+
+        fator = altura_de((*no)->no_esquerdo) - altura_de((*no)->no_direito);
     }
 
-    return tst_coletar(no->no_direito, buffer, capacidade, profundidade, lista);
+    uint8_t altura = calcular_altura(*no);
+    if (altura != (*no)->altura && tornar_privado(no, privado, escrita)) {
+        (*no)->altura = altura;
+    }
 }
 
 /*
@@ -124,42 +453,61 @@ static bool tst_coletar(no_trie* no,
  * - Função interna utilizada para inserção de forma recursiva.
  * - Insere caractere a caractere na Trie, utilizando nós esquerdos,
  *   direitos e do meio.
+ * - Um nó só é tocado se algo abaixo dele mudou; inserir uma palavra
+ *   já existente (sem mudar o peso) não altera nem copia nenhum nó.
  */
-static no_trie*
-trie_inserir_rec(no_trie* no, const char* palavra, bool* inseriu) {
+static no_trie* trie_inserir_rec(no_trie* no,
+                                 escrita_trie* escrita,
+                                 const char* palavra,
+                                 bool* inseriu) {
+    bool privado = false;
     if (!no) {
-        no = calloc(1, sizeof *no);
+        no = no_alocar(escrita->arena);
         if (!no) {
+            escrita->falhou = true;
             return NULL;
         }
         no->caractere = *palavra;
+        privado = true;
     }
 
     if (*palavra < no->caractere) {
-        no_trie* tmp = trie_inserir_rec(no->no_esquerdo, palavra, inseriu);
-        if (!tmp) {
-            return no;
+        no_trie* tmp =
+            trie_inserir_rec(no->no_esquerdo, escrita, palavra, inseriu);
+        if (tmp && tmp != no->no_esquerdo &&
+            tornar_privado(&no, &privado, escrita)) {
+            no->no_esquerdo = tmp;
         }
-        no->no_esquerdo = tmp;
     } else if (*palavra > no->caractere) {
-        no_trie* tmp = trie_inserir_rec(no->no_direito, palavra, inseriu);
-        if (!tmp) {
-            return no;
+        no_trie* tmp =
+            trie_inserir_rec(no->no_direito, escrita, palavra, inseriu);
+        if (tmp && tmp != no->no_direito &&
+            tornar_privado(&no, &privado, escrita)) {
+            no->no_direito = tmp;
         }
-        no->no_direito = tmp;
-    } else {
-        if (*(palavra + 1) == '\0') {
+    } else if (*(palavra + 1) == '\0') {
+        bool novo_peso = escrita->com_peso && no->peso != escrita->peso;
+        if ((!no->terminal || novo_peso) &&
+            tornar_privado(&no, &privado, escrita)) {
+            *inseriu = !no->terminal;
             no->terminal = true;
-            *inseriu = true;
-        } else {
-            no_trie* tmp = trie_inserir_rec(no->no_meio, palavra + 1, inseriu);
-            if (!tmp) {
-                return no;
+            if (escrita->com_peso) {
+                no->peso = escrita->peso;
             }
+        }
+    } else {
+        no_trie* tmp =
+            trie_inserir_rec(no->no_meio, escrita, palavra + 1, inseriu);
+        if (tmp && tmp != no->no_meio &&
+            tornar_privado(&no, &privado, escrita)) {
             no->no_meio = tmp;
         }
     }
 
+    if (escrita->balancear) {
+        balancear_irmaos(&no, &privado, escrita);
+    }
+    atualizar_agregados(&no, &privado, escrita);
     return no;
 }
 
@@ -182,36 +530,169 @@ static bool no_eh_removivel(const no_trie* no) {
 /*
  * Implementação:
  * - Percorre a árvore comparando o caractere atual.
- * - Ao atingir o fim da palavra, desmarca o flag terminal.
- * - Na subida da recursão, remove nós inúteis (poda).
+ * - Ao atingir o fim da palavra, desmarca o flag terminal (se marcado).
+ * - Na subida da recursão, remove nós inúteis (poda), exceto com
+ *   'adiar_poda'. O nó podado passa por descartar_no: um nó privado
+ *   volta para a arena e um já publicado (por exemplo, deixado vazio
+ *   por uma remoção adiada) é aposentado.
  * - Retorna o ponteiro atualizado da subárvore.
  */
-static no_trie*
-trie_remover_rec(no_trie* raiz, const char* palavra, bool* removeu) {
+static no_trie* trie_remover_rec(no_trie* raiz,
+                                 escrita_trie* escrita,
+                                 const char* palavra,
+                                 bool* removeu) {
     if (raiz == NULL) {
         return NULL;
     }
+
+    bool privado = false;
     if (*palavra < raiz->caractere) {
-        raiz->no_esquerdo =
-            trie_remover_rec(raiz->no_esquerdo, palavra, removeu);
+        no_trie* tmp =
+            trie_remover_rec(raiz->no_esquerdo, escrita, palavra, removeu);
+        if (tmp != raiz->no_esquerdo &&
+            tornar_privado(&raiz, &privado, escrita)) {
+            raiz->no_esquerdo = tmp;
+        }
     } else if (*palavra > raiz->caractere) {
-        raiz->no_direito = trie_remover_rec(raiz->no_direito, palavra, removeu);
-    } else {
-        if (*(palavra + 1) == '\0') {
+        no_trie* tmp =
+            trie_remover_rec(raiz->no_direito, escrita, palavra, removeu);
+        if (tmp != raiz->no_direito &&
+            tornar_privado(&raiz, &privado, escrita)) {
+            raiz->no_direito = tmp;
+        }
+    } else if (*(palavra + 1) == '\0') {
+        if (raiz->terminal && tornar_privado(&raiz, &privado, escrita)) {
             raiz->terminal = false;
+            raiz->peso = 0;
             *removeu = true;
+        }
+    } else {
+        no_trie* tmp =
+            trie_remover_rec(raiz->no_meio, escrita, palavra + 1, removeu);
+        if (tmp != raiz->no_meio && tornar_privado(&raiz, &privado, escrita)) {
+            raiz->no_meio = tmp;
+        }
+    }
+
+    if (!escrita->adiar_poda && no_eh_removivel(raiz)) {
+        descartar_no(raiz, privado, escrita);
+        return NULL;
+    }
+
+    if (escrita->balancear) {
+        balancear_irmaos(&raiz, &privado, escrita);
+    }
+    atualizar_agregados(&raiz, &privado, escrita);
+    return raiz;
+}
+/*
+ * Implementação:
+ * - Busca binária pela primeira posição do intervalo ordenado cujo
+ *   caractere em 'profundidade' não é menor que 'c' (ou, com
+ *   'apos_iguais', é maior que 'c').
+ */
+static size_t limite_caractere(char* const* palavras,
+                               size_t quantidade,
+                               size_t profundidade,
+                               char c,
+                               bool apos_iguais) {
+    size_t inicio = 0;
+    size_t fim = quantidade;
+    while (inicio < fim) {
+        size_t meio = inicio + ((fim - inicio) / 2);
+        char atual = palavras[meio][profundidade];
+        if (atual < c || (apos_iguais && atual == c)) {
+            inicio = meio + 1;
         } else {
-            raiz->no_meio =
-                trie_remover_rec(raiz->no_meio, palavra + 1, removeu);
+            fim = meio;
         }
     }
-    if (no_eh_removivel(raiz)) {
-        free(raiz);
+    return inicio;
+}
+
+/*
+ * Implementação:
+ * - 'palavras' é um intervalo ordenado cujas palavras compartilham os
+ *   'profundidade' primeiros caracteres e são mais longas que isso.
+ * - Divide o intervalo pelo caractere do nó com duas buscas binárias:
+ *   as menores descem pela esquerda, as maiores pela direita e as
+ *   iguais pelo meio. As que terminam no nó (as primeiras do meio,
+ *   por serem as mais curtas) desmarcam o terminal.
+ * - Subárvores sem palavras do intervalo não são visitadas; cada nó
+ *   é visitado no máximo uma vez. Poda e agregados seguem
+ *   trie_remover_rec.
+ */
+static no_trie* trie_remover_lote_rec(no_trie* raiz,
+                                      escrita_trie* escrita,
+                                      char* const* palavras,
+                                      size_t quantidade,
+                                      size_t profundidade,
+                                      size_t* removidas) {
+    if (raiz == NULL || quantidade == 0) {
+        return raiz;
+    }
+
+    bool privado = false;
+    char c = raiz->caractere;
+    size_t menores =
+        limite_caractere(palavras, quantidade, profundidade, c, false);
+    size_t fim_iguais =
+        menores + limite_caractere(palavras + menores,
+                                   quantidade - menores,
+                                   profundidade,
+                                   c,
+                                   true);
+
+    no_trie* tmp = trie_remover_lote_rec(
+        raiz->no_esquerdo, escrita, palavras, menores, profundidade, removidas);
+    if (tmp != raiz->no_esquerdo && tornar_privado(&raiz, &privado, escrita)) {
+        raiz->no_esquerdo = tmp;
+    }
+
+    size_t inicio_meio = menores;
+    while (inicio_meio < fim_iguais &&
+           palavras[inicio_meio][profundidade + 1] == '\0') {
+        inicio_meio++;
+    }
+    if (inicio_meio > menores && raiz->terminal &&
+        tornar_privado(&raiz, &privado, escrita)) {
+        raiz->terminal = false;
+        raiz->peso = 0;
+        (*removidas)++;
+    }
+
+    tmp = trie_remover_lote_rec(raiz->no_meio,
+                                escrita,
+                                palavras + inicio_meio,
+                                fim_iguais - inicio_meio,
+                                profundidade + 1,
+                                removidas);
+    if (tmp != raiz->no_meio && tornar_privado(&raiz, &privado, escrita)) {
+        raiz->no_meio = tmp;
+    }
+
+    tmp = trie_remover_lote_rec(raiz->no_direito,
+                                escrita,
+                                palavras + fim_iguais,
+                                quantidade - fim_iguais,
+                                profundidade,
+                                removidas);
+    if (tmp != raiz->no_direito && tornar_privado(&raiz, &privado, escrita)) {
+        raiz->no_direito = tmp;
+    }
+
+    if (!escrita->adiar_poda && no_eh_removivel(raiz)) {
+        descartar_no(raiz, privado, escrita);
         return NULL;
     }
 
+    if (escrita->balancear) {
+        balancear_irmaos(&raiz, &privado, escrita);
+    }
+    atualizar_agregados(&raiz, &privado, escrita);
     return raiz;
 }
+
 /*
  * Implementação:
  * - Usa calloc para garantir inicialização zero de todos os campos,
@@ -241,29 +722,115 @@ void trie_destruir(no_trie* raiz) {
     free(raiz);
 }
 
+/*
+ * Implementação:
+ * - Aplica a alteração ao filho do meio da sentinela e, em seguida,
+ *   à própria sentinela, que só é copiada se algo mudou.
+ * - Em falha, retorna NULL sem publicar nada.
+ */
+static no_trie* alterar_sentinela(no_trie* raiz,
+                                  no_trie* meio,
+                                  escrita_trie* escrita) {
+    bool privado = false;
+    if (escrita->falhou) {
+        return NULL;
+    }
+
+    if (meio != raiz->no_meio && tornar_privado(&raiz, &privado, escrita)) {
+        raiz->no_meio = meio;
+    }
+    atualizar_agregados(&raiz, &privado, escrita);
+
+    return escrita->falhou ? NULL : raiz;
+}
+
 /*
  * Implementação:
  * - Assume raiz como sentinela
  * - Chama função interna trie_inserir_rec a partir do
  *   no_meio da raiz.
+ * - O peso de uma palavra já existente é mantido.
+ * - Se a sentinela marcar a Trie como balanceada, os irmãos de cada
+ *   nó alterado são rebalanceados na subida.
  */
-bool trie_inserir(no_trie* raiz, const char* palavra) {
+bool trie_inserir(no_trie* raiz, arena_nos* arena, const char* palavra) {
     if (!raiz || !palavra || !*palavra) {
         return false;
     }
 
     bool inseriu = false;
+    escrita_trie escrita = {.arena = arena,
+                            .balancear = raiz->altura != 0};
     // Inserção sempre começa no filho do meio da raiz sentinela
-    raiz->no_meio = trie_inserir_rec(raiz->no_meio, palavra, &inseriu);
+    no_trie* tmp = trie_inserir_rec(raiz->no_meio, &escrita, palavra, &inseriu);
+    alterar_sentinela(raiz, tmp ? tmp : raiz->no_meio, &escrita);
+
+    return inseriu;
+}
+
+/*
+ * Implementação:
+ * - Mesma inserção de trie_inserir, gravando o peso no nó final.
+ */
+bool trie_inserir_com_peso(no_trie* raiz,
+                           arena_nos* arena,
+                           const char* palavra,
+                           uint32_t peso) {
+    if (!raiz || !palavra || !*palavra) {
+        return false;
+    }
+
+    bool inseriu = false;
+    escrita_trie escrita = {.arena = arena,
+                            .peso = peso,
+                            .com_peso = true,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_inserir_rec(raiz->no_meio, &escrita, palavra, &inseriu);
+    alterar_sentinela(raiz, tmp ? tmp : raiz->no_meio, &escrita);
 
     return inseriu;
 }
 
+/*
+ * Implementação:
+ * - Mesma recursão de trie_inserir, com cópia de caminho habilitada.
+ * - Se o filho do meio mudou, a própria sentinela é copiada, de modo
+ *   que a versão anterior da Trie continua intacta.
+ * - Em falha de alocação, nada é publicado; as cópias já feitas ficam
+ *   inacessíveis e os nós entregues a 'aposentar' continuam em uso,
+ *   por isso o chamador deve descartá-los.
+ */
+no_trie* trie_inserir_copiando(no_trie* raiz,
+                               arena_nos* arena,
+                               const char* palavra,
+                               const uint32_t* peso,
+                               trie_aposentar aposentar,
+                               void* contexto,
+                               bool* inseriu) {
+    *inseriu = false;
+    if (!raiz || !palavra || !*palavra || !aposentar) {
+        return NULL;
+    }
+
+    escrita_trie escrita = {.arena = arena,
+                            .aposentar = aposentar,
+                            .contexto = contexto,
+                            .peso = peso ? *peso : 0,
+                            .com_peso = peso != NULL,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_inserir_rec(raiz->no_meio, &escrita, palavra, inseriu);
+    no_trie* nova = alterar_sentinela(raiz, tmp, &escrita);
+    if (!nova) {
+        *inseriu = false;
+    }
+    return nova;
+}
+
 /*
  * Implementação:
  * - Utiliza a estrutura lista_palavras para obter as palavras
  *   sem definir limite máximo.
- * - Utiliza a função interna tst_coletar para obter as palavras.
+ * - Percorre a Trie com um cursor sem prefixo.
  * - Retorna array de strings e indica quantidade de palavras
  *   encontradas.
  */
@@ -273,85 +840,567 @@ char** trie_listar_palavras(no_trie* raiz, size_t* quantidade) {
     }
 
     lista_palavras lista = {0};
-    char* buffer = NULL;
-    size_t cap = 0;
+    trie_cursor cursor;
+
+    bool ok = trie_cursor_abrir(&cursor, raiz, NULL) &&
+              cursor_coletar(&cursor, &lista, SIZE_MAX);
+    trie_cursor_fechar(&cursor);
 
-    if (!tst_coletar(raiz->no_meio, &buffer, &cap, 0, &lista)) {
-        free(buffer);
+    if (!ok) {
         trie_liberar_lista(lista.palavras, lista.tamanho);
         return NULL;
     }
 
-    free(buffer);
-
     *quantidade = lista.tamanho;
     return lista.palavras;
 }
 
 /*
  * Implementação:
- * - Navega pela trie até consumir todo o prefixo.
- * - Se o prefixo não existir, retorna NULL e quantidade = 0.
- * - A partir do nó correspondente ao último caractere do prefixo,
- *   coleta todas as palavras descendentes.
- * - Inclui o próprio prefixo se ele for terminal.
+ * - Descida iterativa: a cada nó, ou consome um caractere pelo meio
+ *   ou segue para o irmão; a escolha entre esquerda e direita é uma
+ *   seleção simples, sem desvio a prever.
+ * - Não aloca memória.
  */
-char** trie_buscar_por_prefixo(no_trie* raiz,
-                               const char* prefixo,
-                               size_t* quantidade) {
-    if (!raiz || !prefixo || !*prefixo || !quantidade) {
-        return NULL;
+bool trie_contem(const no_trie* raiz, const char* palavra) {
+    if (!raiz || !palavra || !*palavra) {
+        return false;
     }
 
-    no_trie* atual = raiz->no_meio;
-    const char* p = prefixo;
-
-    while (atual && *p) {
-        if (*p < atual->caractere) {
-            atual = atual->no_esquerdo;
-        } else if (*p > atual->caractere) {
-            atual = atual->no_direito;
-        } else {
-            p++;
-            if (*p) {
-                atual = atual->no_meio;
+    const no_trie* no = raiz->no_meio;
+    while (no) {
+        char c = *palavra;
+        if (c == no->caractere) {
+            palavra++;
+            if (*palavra == '\0') {
+                return no->terminal;
             }
+            no = no->no_meio;
+        } else {
+            no = c < no->caractere ? no->no_esquerdo : no->no_direito;
         }
     }
 
-    if (!atual) {
-        *quantidade = 0;
-        return NULL;
+    return false;
+}
+
+/*
+ * Implementação:
+ * - Mesma descida de trie_contem; retorna o peso do nó final se ele
+ *   for terminal.
+ */
+uint32_t trie_peso(const no_trie* raiz, const char* palavra) {
+    if (!raiz || !palavra || !*palavra) {
+        return 0;
     }
 
-    lista_palavras lista = {0};
-    char* buffer = NULL;
-    size_t cap = 0;
-    size_t len = strlen(prefixo);
+    const no_trie* no = raiz->no_meio;
+    while (no) {
+        char c = *palavra;
+        if (c == no->caractere) {
+            palavra++;
+            if (*palavra == '\0') {
+                return no->terminal ? no->peso : 0;
+            }
+            no = no->no_meio;
+        } else {
+            no = c < no->caractere ? no->no_esquerdo : no->no_direito;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Implementação:
+ * - Ocupa a via com a próxima palavra não vazia; palavras vazias são
+ *   respondidas na hora.
+ * - Retorna false se não houver mais palavras.
+ */
+static bool via_iniciar(via_busca* via,
+                        const no_trie* raiz,
+                        const char* const* palavras,
+                        size_t n,
+                        size_t* proxima,
+                        bool* resultados) {
+    while (*proxima < n) {
+        size_t i = (*proxima)++;
+        if (!palavras[i] || !*palavras[i]) {
+            resultados[i] = false;
+            continue;
+        }
+
+        *via = (via_busca){
+            .no = raiz->no_meio, .resto = palavras[i], .indice = i};
+        PREFETCH(via->no);
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Implementação:
+ * - Mantém até TRIE_VIAS_LOTE buscas em andamento e avança cada uma
+ *   um nó por rodada, com a mesma descida de trie_contem.
+ * - Após cada passo, pede ao processador o próximo nó da via; quando
+ *   a rodada volta a ela, o nó tende a já estar no cache, e as faltas
+ *   de cache das vias se sobrepõem.
+ * - Uma via concluída recebe a próxima palavra; sem palavras, é
+ *   substituída pela última via ativa.
+ */
+void trie_contem_lote(const no_trie* raiz,
+                      const char* const* palavras,
+                      size_t n,
+                      bool* resultados) {
+    if (!raiz || !palavras || !resultados) {
+        return;
+    }
+
+    via_busca vias[TRIE_VIAS_LOTE];
+    size_t proxima = 0;
+    size_t ativas = 0;
+    while (ativas < TRIE_VIAS_LOTE &&
+           via_iniciar(
+               &vias[ativas], raiz, palavras, n, &proxima, resultados)) {
+        ativas++;
+    }
+
+    while (ativas > 0) {
+        for (size_t i = 0; i < ativas;) {
+            via_busca* via = &vias[i];
+            const no_trie* no = via->no;
+            bool concluida = true;
+
+            if (!no) {
+                resultados[via->indice] = false;
+            } else if (*via->resto == no->caractere) {
+                via->resto++;
+                if (*via->resto == '\0') {
+                    resultados[via->indice] = no->terminal;
+                } else {
+                    via->no = no->no_meio;
+                    concluida = false;
+                }
+            } else {
+                via->no = *via->resto < no->caractere ? no->no_esquerdo
+                                                      : no->no_direito;
+                concluida = false;
+            }
 
-    if (!garantir_tamanho_buffer(&buffer, &cap, len + 1)) {
+            if (!concluida) {
+                PREFETCH(via->no);
+                i++;
+            } else if (!via_iniciar(
+                           via, raiz, palavras, n, &proxima, resultados)) {
+                vias[i] = vias[--ativas];
+            }
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a árvore a partir do filho do meio da sentinela,
+ *   mantendo uma linha de Levenshtein por profundidade.
+ */
+char** trie_buscar_aproximado(const no_trie* raiz,
+                              const char* palavra,
+                              size_t max_distancia,
+                              size_t* quantidade) {
+    if (!raiz || !palavra || !quantidade) {
         return NULL;
     }
 
-    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
-    memcpy(buffer, prefixo, len);
-    buffer[len] = '\0';
+    busca_aproximada busca;
+    if (busca_aproximada_iniciar(&busca, palavra, max_distancia)) {
+        buscar_aproximado_rec(raiz->no_meio, 0, &busca);
+    }
+
+    return busca_aproximada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Percorre a árvore a partir do filho do meio da sentinela,
+ *   mantendo o conjunto de posições ativas por profundidade.
+ */
+char** trie_buscar_padrao(const no_trie* raiz,
+                          const char* padrao,
+                          size_t* quantidade) {
+    if (!raiz || !padrao || !*padrao || !quantidade) {
+        return NULL;
+    }
+
+    busca_padrao busca;
+    if (busca_padrao_iniciar(&busca, padrao)) {
+        buscar_padrao_rec(raiz->no_meio, 0, &busca);
+    }
+
+    return busca_padrao_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Equivale à busca limitada sem limite de resultados.
+ */
+char** trie_buscar_por_prefixo(no_trie* raiz,
+                               const char* prefixo,
+                               size_t* quantidade) {
+    return trie_buscar_por_prefixo_limitado(
+        raiz, prefixo, SIZE_MAX, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Se o prefixo não existir, retorna NULL e quantidade = 0.
+ * - Do contrário, consome um cursor aberto sobre o prefixo,
+ *   que já inclui o próprio prefixo se ele for terminal,
+ *   até obter k palavras.
+ */
+char** trie_buscar_por_prefixo_limitado(no_trie* raiz,
+                                        const char* prefixo,
+                                        size_t k,
+                                        size_t* quantidade) {
+    if (!raiz || !prefixo || !*prefixo || !quantidade) {
+        return NULL;
+    }
 
-    if (atual->terminal) {
-        lista_push(&lista, buffer);
+    if (k == 0 || !trie_localizar(raiz, prefixo)) {
+        *quantidade = 0;
+        return NULL;
     }
 
-    if (!tst_coletar(atual->no_meio, &buffer, &cap, len, &lista)) {
-        free(buffer);
+    lista_palavras lista = {0};
+    trie_cursor cursor;
+
+    bool ok = trie_cursor_abrir(&cursor, raiz, prefixo) &&
+              cursor_coletar(&cursor, &lista, k);
+    trie_cursor_fechar(&cursor);
+
+    if (!ok) {
         trie_liberar_lista(lista.palavras, lista.tamanho);
         return NULL;
     }
 
-    free(buffer);
     *quantidade = lista.tamanho;
     return lista.palavras;
 }
 
+/*
+ * Implementação:
+ * - Enfileira a subárvore com chave igual ao maior peso dentro dela.
+ */
+static void enfileirar_subarvore(busca_ranqueada* busca,
+                                 const no_trie* no,
+                                 size_t elo) {
+    if (no) {
+        busca_ranqueada_inserir(
+            busca,
+            (candidato_ranqueado){.no = (uintptr_t) no,
+                                  .elo = elo,
+                                  .peso = no->peso_maximo});
+    }
+}
+
+/*
+ * Implementação:
+ * - Enfileira a subárvore do meio do nó do prefixo (ou a árvore toda,
+ *   sem prefixo) e o próprio prefixo se ele for terminal.
+ * - Ao retirar uma subárvore, enfileira os irmãos no mesmo elo, a
+ *   palavra do nó e a subárvore do meio em um novo elo.
+ * - Ao retirar uma palavra, ela é a mais pesada restante.
+ */
+char** trie_buscar_por_prefixo_ranqueado(const no_trie* raiz,
+                                         const char* prefixo,
+                                         size_t k,
+                                         size_t* quantidade) {
+    if (!raiz || !quantidade) {
+        return NULL;
+    }
+
+    if (!prefixo) {
+        prefixo = "";
+    }
+
+    busca_ranqueada busca;
+    if (k == 0 || !busca_ranqueada_iniciar(&busca, prefixo)) {
+        *quantidade = 0;
+        return NULL;
+    }
+
+    if (!*prefixo) {
+        enfileirar_subarvore(&busca, raiz->no_meio, 0);
+    } else {
+        const no_trie* no = trie_localizar(raiz, prefixo);
+        if (no && no->terminal) {
+            busca_ranqueada_inserir(&busca,
+                                    (candidato_ranqueado){.no = (uintptr_t) no,
+                                                          .peso = no->peso,
+                                                          .completo = true});
+        }
+        enfileirar_subarvore(&busca, no ? no->no_meio : NULL, 0);
+    }
+
+    candidato_ranqueado candidato;
+    while (busca.resultado.tamanho < k &&
+           busca_ranqueada_retirar(&busca, &candidato)) {
+        if (candidato.completo) {
+            busca_ranqueada_aceitar(&busca, candidato.elo);
+            continue;
+        }
+
+        const no_trie* no = (const no_trie*) candidato.no;
+        enfileirar_subarvore(&busca, no->no_esquerdo, candidato.elo);
+        enfileirar_subarvore(&busca, no->no_direito, candidato.elo);
+
+        size_t elo;
+        if (!busca_ranqueada_estender(
+                &busca, candidato.elo, no->caractere, &elo)) {
+            break;
+        }
+        if (no->terminal) {
+            busca_ranqueada_inserir(
+                &busca,
+                (candidato_ranqueado){.no = candidato.no,
+                                      .elo = elo,
+                                      .peso = no->peso,
+                                      .completo = true});
+        }
+        enfileirar_subarvore(&busca, no->no_meio, elo);
+    }
+
+    return busca_ranqueada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Localiza o nó do prefixo e copia o prefixo para o buffer.
+ * - Empilha a subárvore do meio desse nó (ou a árvore toda, sem prefixo).
+ * - Marca o próprio prefixo como pendente se ele for terminal.
+ */
+bool trie_cursor_abrir(trie_cursor* cursor,
+                       const no_trie* raiz,
+                       const char* prefixo) {
+    *cursor = (trie_cursor){0};
+    if (!raiz) {
+        return true;
+    }
+
+    size_t len = prefixo ? strlen(prefixo) : 0;
+    if (!garantir_tamanho_buffer(
+            &cursor->buffer, &cursor->capacidade_buffer, len + 1)) {
+        cursor->falhou = true;
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cursor->buffer, prefixo ? prefixo : "", len);
+    cursor->buffer[len] = '\0';
+
+    if (len == 0) {
+        return cursor_empilhar(cursor, raiz->no_meio, 0);
+    }
+
+    const no_trie* no = trie_localizar(raiz, prefixo);
+    if (!no) {
+        return true;
+    }
+
+    cursor->prefixo_pendente = no->terminal;
+    return cursor_empilhar(cursor, no->no_meio, len);
+}
+
+/*
+ * Implementação:
+ * - Simula o percurso em ordem (esquerda, nó, meio, direita) com a
+ *   pilha de quadros, retornando ao encontrar um nó terminal.
+ * - O quadro do nó é desempilhado antes de visitar a direita, o que
+ *   limita a pilha à profundidade da árvore.
+ */
+const char* trie_cursor_proximo(trie_cursor* cursor) {
+    if (cursor->prefixo_pendente) {
+        cursor->prefixo_pendente = false;
+        return cursor->buffer;
+    }
+
+    while (cursor->topo > 0 && !cursor->falhou) {
+        trie_quadro* q = &cursor->pilha[cursor->topo - 1];
+        const no_trie* no = q->no;
+        size_t profundidade = q->profundidade;
+
+        if (q->fase == 0) {
+            q->fase = 1;
+            cursor_empilhar(cursor, no->no_esquerdo, profundidade);
+            continue;
+        }
+
+        if (q->fase == 1) {
+            q->fase = 2;
+            if (!garantir_tamanho_buffer(&cursor->buffer,
+                                         &cursor->capacidade_buffer,
+                                         profundidade + 2)) {
+                cursor->falhou = true;
+                break;
+            }
+            cursor->buffer[profundidade] = no->caractere;
+            cursor_empilhar(cursor, no->no_meio, profundidade + 1);
+            if (no->terminal) {
+                cursor->buffer[profundidade + 1] = '\0';
+                return cursor->buffer;
+            }
+            continue;
+        }
+
+        cursor->topo--;
+        cursor_empilhar(cursor, no->no_direito, profundidade);
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Libera pilha e buffer; o cursor pode ser reaberto depois.
+ */
+void trie_cursor_fechar(trie_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    free(cursor->pilha);
+    free(cursor->buffer);
+    *cursor = (trie_cursor){0};
+}
+
+/*
+ * Implementação:
+ * - Percorre a árvore real (a partir de raiz->no_meio) somando os
+ *   comprimentos dos nós terminais.
+ */
+void trie_medir_caminhos(const no_trie* raiz, double* media, size_t* maximo) {
+    size_t soma = 0;
+    size_t palavras = 0;
+    size_t maior = 0;
+
+    if (raiz) {
+        medir_caminhos_rec(raiz->no_meio, 1, &soma, &palavras, &maior);
+    }
+
+    if (media) {
+        *media = palavras ? (double) soma / (double) palavras : 0.0;
+    }
+    if (maximo) {
+        *maximo = maior;
+    }
+}
+
+/**
+ * @struct varredura_trie
+ * @brief Somas acumuladas durante trie_coletar_estatisticas.
+ */
+typedef struct {
+    estatisticas_trie* saida;
+    size_t palavras;
+    size_t soma_profundidades;
+    size_t soma_comprimentos;
+    size_t soma_alturas;
+} varredura_trie;
+
+/*
+ * Implementação:
+ * - Contabiliza um conjunto de irmãos de altura e tamanho dados.
+ */
+static void registrar_irmaos(varredura_trie* v, size_t altura, size_t tamanho) {
+    estatisticas_trie* e = v->saida;
+    size_t faixa =
+        altura < TRIE_FAIXAS_IRMAOS ? altura : TRIE_FAIXAS_IRMAOS - 1;
+
+    e->histograma_irmaos[faixa]++;
+    e->conjuntos_irmaos++;
+    v->soma_alturas += altura;
+    if (altura > e->altura_maxima_irmaos) {
+        e->altura_maxima_irmaos = altura;
+    }
+    if (tamanho >= 3 && altura == tamanho) {
+        e->conjuntos_degenerados++;
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre o conjunto de irmãos do nó pela esquerda e direita,
+ *   retornando sua altura e somando seu tamanho em 'tamanho'.
+ * - O filho do meio inicia um novo conjunto, registrado aqui.
+ * - 'profundidade' conta nós visitados; 'comprimento', caracteres.
+ */
+static size_t coletar_estatisticas_rec(const no_trie* no,
+                                       size_t profundidade,
+                                       size_t comprimento,
+                                       size_t* tamanho,
+                                       varredura_trie* v) {
+    if (!no) {
+        return 0;
+    }
+
+    estatisticas_trie* e = v->saida;
+    (*tamanho)++;
+
+    if (no->terminal) {
+        v->palavras++;
+        v->soma_profundidades += profundidade;
+        v->soma_comprimentos += comprimento;
+        if (profundidade > e->profundidade_maxima) {
+            e->profundidade_maxima = profundidade;
+        }
+        if (comprimento > e->comprimento_maximo) {
+            e->comprimento_maximo = comprimento;
+        }
+    }
+
+    if (no->no_meio) {
+        size_t tamanho_meio = 0;
+        size_t altura_meio = coletar_estatisticas_rec(
+            no->no_meio, profundidade + 1, comprimento + 1, &tamanho_meio, v);
+        registrar_irmaos(v, altura_meio, tamanho_meio);
+    }
+
+    size_t esquerda = coletar_estatisticas_rec(
+        no->no_esquerdo, profundidade + 1, comprimento, tamanho, v);
+    size_t direita = coletar_estatisticas_rec(
+        no->no_direito, profundidade + 1, comprimento, tamanho, v);
+
+    return 1 + (esquerda > direita ? esquerda : direita);
+}
+
+/*
+ * Implementação:
+ * - Zera a saída e percorre a partir do filho do meio da sentinela,
+ *   que forma o primeiro conjunto de irmãos.
+ * - Converte as somas em médias ao final.
+ */
+void trie_coletar_estatisticas(const no_trie* raiz,
+                               estatisticas_trie* estatisticas) {
+    *estatisticas = (estatisticas_trie){0};
+    if (!raiz || !raiz->no_meio) {
+        return;
+    }
+
+    varredura_trie v = {.saida = estatisticas};
+    size_t tamanho = 0;
+    size_t altura =
+        coletar_estatisticas_rec(raiz->no_meio, 1, 1, &tamanho, &v);
+    registrar_irmaos(&v, altura, tamanho);
+
+    if (v.palavras > 0) {
+        estatisticas->profundidade_media =
+            (double) v.soma_profundidades / (double) v.palavras;
+        estatisticas->comprimento_medio =
+            (double) v.soma_comprimentos / (double) v.palavras;
+    }
+    estatisticas->altura_media_irmaos =
+        (double) v.soma_alturas / (double) estatisticas->conjuntos_irmaos;
+}
+
 /*
  * Implementação:
  * - Percorre o array de strings e libera cada palavra.
@@ -375,12 +1424,426 @@ void trie_liberar_lista(char** palavras, size_t n) {
  * - A árvore real começa em raiz->no_meio.
  * - Ignora chamadas inválidas (NULL ou string vazia).
  */
-bool trie_remover(no_trie* raiz, const char* palavra) {
+bool trie_remover(no_trie* raiz, arena_nos* arena, const char* palavra) {
+    if (!raiz || !palavra || !*palavra) {
+        return false;
+    }
+    bool removeu = false;
+    escrita_trie escrita = {.arena = arena,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_remover_rec(raiz->no_meio, &escrita, palavra, &removeu);
+    alterar_sentinela(raiz, tmp, &escrita);
+
+    return removeu;
+}
+
+/*
+ * Implementação:
+ * - Mesma recursão de trie_remover, com cópia de caminho habilitada.
+ * - Copia a sentinela se o filho do meio mudou.
+ * - Falhas de alocação seguem o contrato de trie_inserir_copiando.
+ */
+no_trie* trie_remover_copiando(no_trie* raiz,
+                               arena_nos* arena,
+                               const char* palavra,
+                               trie_aposentar aposentar,
+                               void* contexto,
+                               bool* removeu) {
+    *removeu = false;
+    if (!raiz || !palavra || !*palavra || !aposentar) {
+        return NULL;
+    }
+
+    escrita_trie escrita = {.arena = arena,
+                            .aposentar = aposentar,
+                            .contexto = contexto,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_remover_rec(raiz->no_meio, &escrita, palavra, removeu);
+    no_trie* nova = alterar_sentinela(raiz, tmp, &escrita);
+    if (!nova) {
+        *removeu = false;
+    }
+    return nova;
+}
+
+/*
+ * Implementação:
+ * - Ignora as strings vazias (as primeiras do intervalo ordenado).
+ * - Um único percurso de trie_remover_lote_rec a partir do filho do
+ *   meio da sentinela.
+ */
+size_t trie_remover_lote(no_trie* raiz,
+                         arena_nos* arena,
+                         char* const* palavras,
+                         size_t quantidade) {
+    if (!raiz || !palavras) {
+        return 0;
+    }
+    while (quantidade > 0 && **palavras == '\0') {
+        palavras++;
+        quantidade--;
+    }
+
+    size_t removidas = 0;
+    escrita_trie escrita = {.arena = arena,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_remover_lote_rec(
+        raiz->no_meio, &escrita, palavras, quantidade, 0, &removidas);
+    alterar_sentinela(raiz, tmp, &escrita);
+
+    return removidas;
+}
+
+/*
+ * Implementação:
+ * - Mesmo percurso de trie_remover_lote, com cópia de caminho
+ *   habilitada: cada nó alterado é copiado uma única vez.
+ * - Falhas de alocação seguem o contrato de trie_inserir_copiando.
+ */
+no_trie* trie_remover_lote_copiando(no_trie* raiz,
+                                    arena_nos* arena,
+                                    char* const* palavras,
+                                    size_t quantidade,
+                                    trie_aposentar aposentar,
+                                    void* contexto,
+                                    size_t* removidas) {
+    *removidas = 0;
+    if (!raiz || !palavras || !aposentar) {
+        return NULL;
+    }
+    while (quantidade > 0 && **palavras == '\0') {
+        palavras++;
+        quantidade--;
+    }
+
+    escrita_trie escrita = {.arena = arena,
+                            .aposentar = aposentar,
+                            .contexto = contexto,
+                            .balancear = raiz->altura != 0};
+    no_trie* tmp = trie_remover_lote_rec(
+        raiz->no_meio, &escrita, palavras, quantidade, 0, removidas);
+    no_trie* nova = alterar_sentinela(raiz, tmp, &escrita);
+    if (!nova) {
+        *removidas = 0;
+    }
+    return nova;
+}
+
+/*
+ * Implementação:
+ * - Mesma recursão de trie_remover com 'adiar_poda': só o terminal,
+ *   o peso e os agregados do caminho mudam.
+ */
+bool trie_desmarcar(no_trie* raiz, const char* palavra) {
     if (!raiz || !palavra || !*palavra) {
         return false;
     }
     bool removeu = false;
-    raiz->no_meio = trie_remover_rec(raiz->no_meio, palavra, &removeu);
+    escrita_trie escrita = {.adiar_poda = true};
+    no_trie* tmp = trie_remover_rec(raiz->no_meio, &escrita, palavra, &removeu);
+    alterar_sentinela(raiz, tmp, &escrita);
 
     return removeu;
 }
+
+/*
+ * Implementação:
+ * - Mesmo percurso de trie_remover_lote com 'adiar_poda'.
+ */
+size_t trie_desmarcar_lote(no_trie* raiz,
+                           char* const* palavras,
+                           size_t quantidade) {
+    if (!raiz || !palavras) {
+        return 0;
+    }
+    while (quantidade > 0 && **palavras == '\0') {
+        palavras++;
+        quantidade--;
+    }
+
+    size_t removidas = 0;
+    escrita_trie escrita = {.adiar_poda = true};
+    no_trie* tmp = trie_remover_lote_rec(
+        raiz->no_meio, &escrita, palavras, quantidade, 0, &removidas);
+    alterar_sentinela(raiz, tmp, &escrita);
+
+    return removidas;
+}
+
+/**
+ * @struct reconstrucao_trie
+ * @brief Estado de trie_compactar e trie_balancear.
+ *
+ * A pilha guarda os nós de cada conjunto de irmãos em ordem, um
+ * conjunto por nível da recursão; é acessada por índice, pois pode
+ * ser realocada pelos níveis de baixo. Com 'destino', os nós que
+ * levam a alguma palavra são copiados para ele e os demais
+ * descartados; sem, todos são religados no lugar.
+ */
+typedef struct reconstrucao_trie {
+    no_trie** pilha;
+    size_t topo;
+    size_t capacidade;
+    arena_nos* destino;
+    bool falhou;
+} reconstrucao_trie;
+
+/*
+ * Implementação:
+ * - Empilha os irmãos em ordem (esquerda, nó, direita).
+ * - Ao copiar, descarta subárvores sem palavras e nós que não são
+ *   terminais e cujo filho do meio não tem palavras: estes só
+ *   separavam irmãos.
+ */
+static void empilhar_irmaos(reconstrucao_trie* r, no_trie* no) {
+    while (no && !r->falhou) {
+        if (r->destino && no->contagem == 0) {
+            return;
+        }
+
+        empilhar_irmaos(r, no->no_esquerdo);
+        bool vivo = no->terminal || contagem_de(no->no_meio) > 0;
+        if (!r->falhou && (!r->destino || vivo)) {
+            if (r->topo == r->capacidade) {
+                size_t nova_cap = r->capacidade ? r->capacidade * 2 : 256;
+                no_trie** tmp = realloc((void*) r->pilha,
+                                        nova_cap * sizeof *tmp);
+                if (!tmp) {
+                    r->falhou = true;
+                    return;
+                }
+                r->pilha = tmp;
+                r->capacidade = nova_cap;
+            }
+            r->pilha[r->topo++] = no;
+        }
+        no = no->no_direito;
+    }
+}
+
+/*
+ * Implementação:
+ * - Liga os nós em ordem de [inicio, fim) como árvore binária
+ *   perfeitamente balanceada, com a mediana como raiz, calculando
+ *   altura e agregados de cada nó depois de ligar seus filhos.
+ */
+static no_trie* ligar_irmaos(no_trie** nos, size_t inicio, size_t fim) {
+    if (inicio >= fim) {
+        return NULL;
+    }
+
+    size_t meio = inicio + ((fim - inicio) / 2);
+    no_trie* no = nos[meio];
+    no->no_esquerdo = ligar_irmaos(nos, inicio, meio);
+    no->no_direito = ligar_irmaos(nos, meio + 1, fim);
+    no->altura = calcular_altura(no);
+    calcular_agregados(no, &no->peso_maximo, &no->contagem);
+    return no;
+}
+
+/*
+ * Implementação:
+ * - Um conjunto de irmãos por chamada: empilha os nós, copia cada um
+ *   (com 'destino'), reconstrói o conjunto do filho do meio e só
+ *   então liga o conjunto balanceado.
+ * - As cópias são feitas em pré-ordem, o filho do meio logo depois
+ *   do nó, para que a descida por uma palavra fique em nós vizinhos.
+ * - Em falha no lugar, o conjunto é mantido como estava (os conjuntos
+ *   de baixo já religados continuam válidos). Ao copiar, o resultado
+ *   é descartado pelo chamador.
+ */
+static no_trie* reconstruir_irmaos(reconstrucao_trie* r, no_trie* primeiro) {
+    if (!primeiro || r->falhou) {
+        return r->destino ? NULL : primeiro;
+    }
+
+    size_t inicio = r->topo;
+    empilhar_irmaos(r, primeiro);
+    size_t fim = r->topo;
+
+    for (size_t i = inicio; i < fim && !r->falhou; i++) {
+        no_trie* no = r->pilha[i];
+        if (r->destino) {
+            no_trie* copia = no_alocar(r->destino);
+            if (!copia) {
+                r->falhou = true;
+                break;
+            }
+            *copia = *no;
+            no = copia;
+        }
+        no_trie* meio = reconstruir_irmaos(r, no->no_meio);
+        no->no_meio = meio;
+        r->pilha[i] = no;
+    }
+
+    no_trie* raiz = r->falhou ? (r->destino ? NULL : primeiro)
+                              : ligar_irmaos(r->pilha, inicio, fim);
+    r->topo = inicio;
+    return raiz;
+}
+
+/*
+ * Implementação:
+ * - Copia a sentinela e reconstrói os conjuntos de irmãos a partir
+ *   do filho do meio, copiando só os nós que levam a alguma palavra.
+ *   Os agregados não mudam: nós descartados não contribuem para
+ *   contagem nem para peso máximo.
+ * - Em falha, os nós já copiados ficam em 'destino', que o chamador
+ *   descarta.
+ */
+no_trie* trie_compactar(const no_trie* raiz, arena_nos* destino) {
+    if (!raiz || !destino) {
+        return NULL;
+    }
+
+    no_trie* sentinela = no_alocar(destino);
+    if (!sentinela) {
+        return NULL;
+    }
+
+    reconstrucao_trie r = {.destino = destino};
+    *sentinela = *raiz;
+    sentinela->no_meio = reconstruir_irmaos(&r, raiz->no_meio);
+    free((void*) r.pilha);
+    return r.falhou ? NULL : sentinela;
+}
+
+/*
+ * Implementação:
+ * - Religa no lugar todos os conjuntos de irmãos, calculando as
+ *   alturas, e só então marca a sentinela.
+ */
+bool trie_balancear(no_trie* raiz) {
+    if (!raiz) {
+        return false;
+    }
+
+    reconstrucao_trie r = {0};
+    raiz->no_meio = reconstruir_irmaos(&r, raiz->no_meio);
+    free((void*) r.pilha);
+    if (r.falhou) {
+        return false;
+    }
+
+    raiz->altura = 1;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Recalcula os campos agregados a partir dos filhos, no lugar.
+ */
+void trie_recalcular_agregados(no_trie* no) {
+    if (no) {
+        calcular_agregados(no, &no->peso_maximo, &no->contagem);
+    }
+}
+
+/*
+ * Implementação:
+ * - Sem prefixo, a contagem do filho do meio da sentinela.
+ * - Do contrário, a palavra do nó do prefixo (se terminal) mais a
+ *   contagem de sua subárvore do meio.
+ */
+size_t trie_contar_prefixo(const no_trie* raiz, const char* prefixo) {
+    if (!raiz) {
+        return 0;
+    }
+
+    if (!prefixo || !*prefixo) {
+        return contagem_de(raiz->no_meio);
+    }
+
+    const no_trie* no = trie_localizar(raiz, prefixo);
+    if (!no) {
+        return 0;
+    }
+
+    return (no->terminal ? 1 : 0) + contagem_de(no->no_meio);
+}
+
+/*
+ * Implementação:
+ * - Desce pelo caminho da palavra somando as palavras que ficam antes
+ *   dela em ordem lexicográfica:
+ *   - ao seguir à direita, a subárvore esquerda, a palavra do nó e a
+ *     subárvore do meio;
+ *   - ao casar um caractere, a subárvore esquerda e, se a palavra
+ *     continuar, a palavra do nó (um prefixo dela).
+ */
+size_t trie_rank(const no_trie* raiz, const char* palavra) {
+    if (!raiz || !palavra) {
+        return 0;
+    }
+
+    size_t posicao = 0;
+    const no_trie* no = raiz->no_meio;
+    while (no && *palavra) {
+        if (*palavra < no->caractere) {
+            no = no->no_esquerdo;
+        } else if (*palavra > no->caractere) {
+            posicao += no->contagem - contagem_de(no->no_direito);
+            no = no->no_direito;
+        } else {
+            posicao += contagem_de(no->no_esquerdo);
+            if (*++palavra == '\0') {
+                break;
+            }
+            posicao += no->terminal ? 1 : 0;
+            no = no->no_meio;
+        }
+    }
+
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Desce pelas contagens: pula a subárvore esquerda se k não cai
+ *   nela, depois a palavra do nó e, por fim, a subárvore do meio.
+ * - Os caracteres dos nós casados formam a palavra em um buffer.
+ */
+char* trie_selecionar(const no_trie* raiz, size_t k) {
+    if (!raiz || k >= contagem_de(raiz->no_meio)) {
+        return NULL;
+    }
+
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    size_t tamanho = 0;
+    const no_trie* no = raiz->no_meio;
+
+    while (no) {
+        if (k < contagem_de(no->no_esquerdo)) {
+            no = no->no_esquerdo;
+            continue;
+        }
+        k -= contagem_de(no->no_esquerdo);
+
+        if (!garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 2)) {
+            free(buffer);
+            return NULL;
+        }
+
+        if (no->terminal) {
+            if (k == 0) {
+                buffer[tamanho++] = no->caractere;
+                buffer[tamanho] = '\0';
+                return buffer;
+            }
+            k--;
+        }
+
+        if (k < contagem_de(no->no_meio)) {
+            buffer[tamanho++] = no->caractere;
+            no = no->no_meio;
+        } else {
+            k -= contagem_de(no->no_meio);
+            no = no->no_direito;
+        }
+    }
+
+    free(buffer);
+    return NULL;
+}
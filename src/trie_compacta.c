@@ -0,0 +1,330 @@
+/**
+ * @file trie_compacta.c
+ * @brief Implementação da Trie ternária compacta.
+ */
+
+#include "trie_compacta.h"
+
+#include "trie.h"
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_INICIAL 1024
+
+enum { LIGACAO_ESQUERDA, LIGACAO_MEIO, LIGACAO_DIREITA };
+
+/*
+ * Implementação:
+ * - Reserva o vetor com a sentinela no índice 0.
+ */
+trie_compacta* trie_compacta_criar(void) {
+    trie_compacta* trie = calloc(1, sizeof *trie);
+    if (!trie) {
+        return NULL;
+    }
+
+    trie->nos = calloc(CAPACIDADE_INICIAL, sizeof *trie->nos);
+    if (!trie->nos) {
+        free(trie);
+        return NULL;
+    }
+
+    trie->capacidade = CAPACIDADE_INICIAL;
+    trie->usados = 1;
+    return trie;
+}
+
+/*
+ * Implementação:
+ * - Um único free libera todos os nós.
+ */
+void trie_compacta_destruir(trie_compacta* trie) {
+    if (!trie) {
+        return;
+    }
+
+    free(trie->nos);
+    free(trie);
+}
+
+/*
+ * Implementação:
+ * - Reaproveita primeiro um nó da lista livre.
+ * - Do contrário, usa o próximo índice do vetor, dobrando-o quando
+ *   cheio (o vetor pode mudar de endereço).
+ * - Retorna 0 em falha.
+ */
+static uint32_t no_alocar(trie_compacta* trie, char caractere) {
+    uint32_t indice = trie->livres;
+
+    if (indice) {
+        trie->livres = trie->nos[indice].meio;
+    } else {
+        if (trie->usados == trie->capacidade) {
+            if (trie->capacidade > UINT32_MAX / 2) {
+                return 0;
+            }
+            uint32_t nova_cap = trie->capacidade * 2;
+            no_compacto* tmp = realloc(trie->nos, nova_cap * sizeof *tmp);
+            if (!tmp) {
+                return 0;
+            }
+            trie->nos = tmp;
+            trie->capacidade = nova_cap;
+        }
+        indice = trie->usados++;
+    }
+
+    trie->nos[indice] = (no_compacto){.caractere = caractere};
+    trie->nos_ativos++;
+    return indice;
+}
+
+/*
+ * Implementação:
+ * - Empilha o nó na lista livre usando o campo meio como ligação.
+ */
+static void no_liberar(trie_compacta* trie, uint32_t indice) {
+    trie->nos[indice].meio = trie->livres;
+    trie->livres = indice;
+    trie->nos_ativos--;
+}
+
+/*
+ * Implementação:
+ * - Descida iterativa guardando o pai e a ligação de onde veio, e não
+ *   um ponteiro, pois alocar um nó pode mover o vetor.
+ */
+bool trie_compacta_inserir(trie_compacta* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    uint32_t pai = 0;
+    int ligacao = LIGACAO_MEIO;
+    uint32_t atual = trie->nos[0].meio;
+
+    while (true) {
+        if (!atual) {
+            atual = no_alocar(trie, *palavra);
+            if (!atual) {
+                return false;
+            }
+            no_compacto* p = &trie->nos[pai];
+            if (ligacao == LIGACAO_ESQUERDA) {
+                p->esquerdo = atual;
+            } else if (ligacao == LIGACAO_MEIO) {
+                p->meio = atual;
+            } else {
+                p->direito = atual;
+            }
+        }
+
+        no_compacto* no = &trie->nos[atual];
+        pai = atual;
+        if (*palavra < no->caractere) {
+            ligacao = LIGACAO_ESQUERDA;
+            atual = no->esquerdo;
+        } else if (*palavra > no->caractere) {
+            ligacao = LIGACAO_DIREITA;
+            atual = no->direito;
+        } else if (*(palavra + 1) == '\0') {
+            if (no->terminal) {
+                return false;
+            }
+            no->terminal = 1;
+            trie->total_palavras++;
+            return true;
+        } else {
+            ligacao = LIGACAO_MEIO;
+            atual = no->meio;
+            palavra++;
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Mesma recursão de trie_remover_rec, sobre índices: desmarca o
+ *   terminal e, na subida, poda nós sem palavra e sem filhos.
+ * - Retorna o índice atualizado da subárvore.
+ */
+static uint32_t remover_rec(trie_compacta* trie,
+                            uint32_t indice,
+                            const char* palavra,
+                            bool* removeu) {
+    if (!indice) {
+        return 0;
+    }
+
+    no_compacto* no = &trie->nos[indice];
+    if (*palavra < no->caractere) {
+        no->esquerdo = remover_rec(trie, no->esquerdo, palavra, removeu);
+    } else if (*palavra > no->caractere) {
+        no->direito = remover_rec(trie, no->direito, palavra, removeu);
+    } else if (*(palavra + 1) == '\0') {
+        if (no->terminal) {
+            no->terminal = 0;
+            *removeu = true;
+        }
+    } else {
+        no->meio = remover_rec(trie, no->meio, palavra + 1, removeu);
+    }
+
+    if (!no->terminal && !no->esquerdo && !no->meio && !no->direito) {
+        no_liberar(trie, indice);
+        return 0;
+    }
+    return indice;
+}
+
+/*
+ * Implementação:
+ * - Remove a partir do filho do meio da sentinela.
+ */
+bool trie_compacta_remover(trie_compacta* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    bool removeu = false;
+    trie->nos[0].meio = remover_rec(trie, trie->nos[0].meio, palavra, &removeu);
+    if (removeu) {
+        trie->total_palavras--;
+    }
+    return removeu;
+}
+
+/*
+ * Implementação:
+ * - Desce a partir da sentinela até o nó do último caractere.
+ * - Retorna 0 se o caminho não existir.
+ */
+static uint32_t localizar(const trie_compacta* trie, const char* palavra) {
+    uint32_t atual = trie->nos[0].meio;
+
+    while (atual) {
+        const no_compacto* no = &trie->nos[atual];
+        if (*palavra < no->caractere) {
+            atual = no->esquerdo;
+        } else if (*palavra > no->caractere) {
+            atual = no->direito;
+        } else if (*(palavra + 1) == '\0') {
+            return atual;
+        } else {
+            atual = no->meio;
+            palavra++;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Implementação:
+ * - A palavra existe se o caminho existir e terminar em nó terminal.
+ */
+bool trie_compacta_contem(const trie_compacta* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    uint32_t indice = localizar(trie, palavra);
+    return indice && trie->nos[indice].terminal;
+}
+
+/**
+ * @struct coleta_compacta
+ * @brief Estado da coleta de palavras de uma subárvore.
+ */
+typedef struct {
+    const trie_compacta* trie;
+    char* buffer;
+    size_t capacidade;
+    lista_palavras lista;
+    bool falhou;
+} coleta_compacta;
+
+/*
+ * Implementação:
+ * - Percurso em ordem (esquerda, nó, meio, direita), escrevendo o
+ *   caractere de cada nó na posição 'profundidade' do buffer.
+ */
+static void coletar_rec(coleta_compacta* coleta,
+                        uint32_t indice,
+                        size_t profundidade) {
+    while (indice && !coleta->falhou) {
+        const no_compacto* no = &coleta->trie->nos[indice];
+        coletar_rec(coleta, no->esquerdo, profundidade);
+
+        if (!garantir_tamanho_buffer(
+                &coleta->buffer, &coleta->capacidade, profundidade + 2)) {
+            coleta->falhou = true;
+            return;
+        }
+        coleta->buffer[profundidade] = no->caractere;
+        if (no->terminal) {
+            coleta->buffer[profundidade + 1] = '\0';
+            if (!lista_push(&coleta->lista, coleta->buffer)) {
+                coleta->falhou = true;
+                return;
+            }
+        }
+
+        coletar_rec(coleta, no->meio, profundidade + 1);
+        indice = no->direito;
+    }
+}
+
+/*
+ * Implementação:
+ * - Localiza o nó do prefixo, copia o prefixo para o buffer e coleta
+ *   o próprio prefixo (se terminal) e sua subárvore do meio.
+ */
+char** trie_compacta_buscar_por_prefixo(const trie_compacta* trie,
+                                        const char* prefixo,
+                                        size_t* quantidade) {
+    if (!trie || !prefixo || !*prefixo || !quantidade) {
+        return NULL;
+    }
+
+    *quantidade = 0;
+    uint32_t indice = localizar(trie, prefixo);
+    if (!indice) {
+        return NULL;
+    }
+
+    size_t tamanho = strlen(prefixo);
+    coleta_compacta coleta = {.trie = trie};
+    if (!garantir_tamanho_buffer(
+            &coleta.buffer, &coleta.capacidade, tamanho + 1)) {
+        return NULL;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(coleta.buffer, prefixo, tamanho + 1);
+
+    if (trie->nos[indice].terminal &&
+        !lista_push(&coleta.lista, coleta.buffer)) {
+        coleta.falhou = true;
+    }
+    coletar_rec(&coleta, trie->nos[indice].meio, tamanho);
+    free(coleta.buffer);
+
+    if (coleta.falhou) {
+        trie_liberar_lista(coleta.lista.palavras, coleta.lista.tamanho);
+        return NULL;
+    }
+
+    *quantidade = coleta.lista.tamanho;
+    return coleta.lista.palavras;
+}
+
+/*
+ * Implementação:
+ * - Capacidade do vetor vezes o tamanho do nó.
+ */
+size_t trie_compacta_bytes_reservados(const trie_compacta* trie) {
+    return trie ? (size_t) trie->capacidade * sizeof(no_compacto) : 0;
+}
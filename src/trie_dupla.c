@@ -0,0 +1,1055 @@
+/**
+ * @file trie_dupla.c
+ * @brief Implementação da Trie de vetor duplo.
+ */
+
+#include "trie_dupla.h"
+
+#include "distancia.h"
+#include "padrao.h"
+#include "ranqueamento.h"
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CAPACIDADE_INICIAL 1024
+#define SEM_LIVRE (-1)
+#define TENTATIVAS_BASE 64
+#define JANELA_BUSCA 512
+
+/**
+ * @struct varredura_dupla
+ * @brief Somas acumuladas durante trie_dupla_coletar_estatisticas.
+ */
+typedef struct {
+    estatisticas_trie* saida;
+    size_t palavras;
+    size_t soma_comprimentos;
+} varredura_dupla;
+
+/*
+ * Implementação:
+ * - Código da letra (1 a 26) ou 0 se estiver fora de a–z.
+ */
+static int codigo_de(char caractere) {
+    if (caractere < 'a' || caractere > 'z') {
+        return 0;
+    }
+    return caractere - 'a' + 1;
+}
+
+/*
+ * Implementação:
+ * - Letra do código (inverso de codigo_de).
+ */
+static char letra_de(int codigo) {
+    return (char) ('a' + codigo - 1);
+}
+
+/*
+ * Implementação:
+ * - Um único acesso: o filho existe se a posição base + código
+ *   pertence ao estado. A base de um estado sem filhos é 0 ou uma
+ *   base antiga; em ambos os casos nenhuma posição pertence a ele.
+ * - Retorna -1 se não houver filho pelo código.
+ */
+static int32_t filho_de(const trie_dupla* trie, int32_t estado, int codigo) {
+    int32_t posicao = trie->celulas[estado].base + codigo;
+    return trie->celulas[posicao].verificacao == estado ? posicao : -1;
+}
+
+/*
+ * Implementação:
+ * - Próxima e anterior posição livre, guardadas negativas nos campos
+ *   de uma posição livre.
+ */
+static int32_t proximo_livre(const trie_dupla* trie, int32_t posicao) {
+    return -trie->celulas[posicao].verificacao - 1;
+}
+
+static int32_t anterior_livre(const trie_dupla* trie, int32_t posicao) {
+    return -trie->celulas[posicao].base - 1;
+}
+
+static void definir_livre(trie_dupla* trie,
+                          int32_t posicao,
+                          int32_t proximo,
+                          int32_t anterior) {
+    trie->celulas[posicao].verificacao = -proximo - 1;
+    trie->celulas[posicao].base = -anterior - 1;
+}
+
+/*
+ * Implementação:
+ * - Acrescenta a posição ao fim da lista circular de livres, de modo
+ *   que a busca por base, a partir do início, tente primeiro as
+ *   posições mais antigas.
+ */
+static void vincular_livre(trie_dupla* trie, int32_t posicao) {
+    if (trie->livre == SEM_LIVRE) {
+        definir_livre(trie, posicao, posicao, posicao);
+        trie->livre = posicao;
+        return;
+    }
+
+    int32_t cabeca = trie->livre;
+    int32_t cauda = anterior_livre(trie, cabeca);
+    definir_livre(trie, posicao, cabeca, cauda);
+    trie->celulas[cauda].verificacao = -posicao - 1;
+    trie->celulas[cabeca].base = -posicao - 1;
+}
+
+/*
+ * Implementação:
+ * - Retira a posição da lista de livres.
+ */
+static void desvincular_livre(trie_dupla* trie, int32_t posicao) {
+    int32_t proximo = proximo_livre(trie, posicao);
+    int32_t anterior = anterior_livre(trie, posicao);
+
+    if (proximo == posicao) {
+        trie->livre = SEM_LIVRE;
+        return;
+    }
+
+    trie->celulas[anterior].verificacao = -proximo - 1;
+    trie->celulas[proximo].base = -anterior - 1;
+    if (trie->livre == posicao) {
+        trie->livre = proximo;
+    }
+}
+
+/*
+ * Implementação:
+ * - Dobra os vetores até comportarem 'necessario' posições; as novas
+ *   posições entram na lista de livres em ordem crescente.
+ */
+static bool garantir_capacidade(trie_dupla* trie, size_t necessario) {
+    if (necessario <= trie->capacidade) {
+        return true;
+    }
+
+    size_t nova_cap = trie->capacidade;
+    while (nova_cap < necessario) {
+        nova_cap *= 2;
+    }
+    if (nova_cap > INT32_MAX) {
+        return false;
+    }
+
+    celula_dupla* celulas =
+        realloc(trie->celulas, nova_cap * sizeof *trie->celulas);
+    if (!celulas) {
+        return false;
+    }
+    trie->celulas = celulas;
+
+    info_dupla* infos = realloc(trie->infos, nova_cap * sizeof *trie->infos);
+    if (!infos) {
+        return false;
+    }
+    trie->infos = infos;
+
+    for (size_t i = trie->capacidade; i < nova_cap; i++) {
+        trie->infos[i] = (info_dupla){0};
+        vincular_livre(trie, (int32_t) i);
+    }
+    trie->capacidade = nova_cap;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Verifica se as posições base + código estão livres para todos os
+ *   códigos; posições além do fim dos vetores contam como livres.
+ */
+static bool cabe_em(const trie_dupla* trie,
+                    int32_t base,
+                    const uint8_t* codigos,
+                    size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        size_t posicao = (size_t) base + codigos[i];
+        if (posicao < trie->capacidade &&
+            trie->celulas[posicao].verificacao >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Um único código cabe em quase qualquer posição livre: usa a mais
+ *   antiga da lista de livres (em poucas tentativas).
+ * - Vários códigos são posicionados por uma varredura em ordem de
+ *   índice a partir de 'busca', que só avança: trechos em que nenhum
+ *   conjunto coube em JANELA_BUSCA posições ficam para os estados de
+ *   um só filho. Assim a varredura total é limitada pela capacidade
+ *   e os vetores só crescem quando ela chega ao fim.
+ * - Sem posição, usa uma base que põe todos os códigos além do fim
+ *   dos vetores.
+ */
+static int32_t
+encontrar_base(trie_dupla* trie, const uint8_t* codigos, size_t n) {
+    if (n == 1 && trie->livre != SEM_LIVRE) {
+        int32_t posicao = trie->livre;
+        size_t tentativas = 0;
+        do {
+            if (posicao >= codigos[0]) {
+                return posicao - codigos[0];
+            }
+            posicao = proximo_livre(trie, posicao);
+        } while (posicao != trie->livre && ++tentativas < TENTATIVAS_BASE);
+    }
+
+    while (trie->busca < trie->capacidade &&
+           trie->celulas[trie->busca].verificacao >= 0) {
+        trie->busca++;
+    }
+
+    size_t inicio = trie->busca;
+    for (size_t i = inicio; i < trie->capacidade; i++) {
+        if (i - inicio == JANELA_BUSCA) {
+            trie->busca = i;
+            inicio = i;
+        }
+        int32_t base = (int32_t) i - codigos[0];
+        if (trie->celulas[i].verificacao < 0 && base >= 0 &&
+            cabe_em(trie, base, codigos, n)) {
+            return base;
+        }
+    }
+
+    trie->busca = trie->capacidade;
+    return (int32_t) trie->capacidade - codigos[0];
+}
+
+/*
+ * Implementação:
+ * - Ocupa uma posição livre como estado filho de 'pai', sem filhos.
+ */
+static void ocupar(trie_dupla* trie, int32_t posicao, int32_t pai) {
+    desvincular_livre(trie, posicao);
+    trie->celulas[posicao] = (celula_dupla){.base = 0, .verificacao = pai};
+    trie->infos[posicao] = (info_dupla){0};
+    trie->estados++;
+}
+
+/*
+ * Implementação:
+ * - Devolve a posição do estado à lista de livres.
+ */
+static void liberar(trie_dupla* trie, int32_t posicao) {
+    vincular_livre(trie, posicao);
+    trie->infos[posicao] = (info_dupla){0};
+    trie->estados--;
+}
+
+/*
+ * Implementação:
+ * - Procura uma base onde caibam os filhos atuais do estado e o novo
+ *   código e move cada filho para ela.
+ * - Os filhos de cada estado movido passam a apontar (verificacao)
+ *   para a nova posição.
+ */
+static bool realocar(trie_dupla* trie, int32_t estado, int novo_codigo) {
+    uint8_t codigos[TRIE_DUPLA_LETRAS];
+    size_t n = 0;
+    int32_t antiga = trie->celulas[estado].base;
+
+    for (int c = 1; c <= TRIE_DUPLA_LETRAS; c++) {
+        if (c == novo_codigo ||
+            trie->celulas[antiga + c].verificacao == estado) {
+            codigos[n++] = (uint8_t) c;
+        }
+    }
+
+    int32_t base = encontrar_base(trie, codigos, n);
+    if (!garantir_capacidade(trie,
+                             (size_t) base + TRIE_DUPLA_LETRAS + 1)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (codigos[i] == novo_codigo) {
+            continue;
+        }
+
+        int32_t de = antiga + codigos[i];
+        int32_t para = base + codigos[i];
+        desvincular_livre(trie, para);
+        trie->celulas[para] = (celula_dupla){
+            .base = trie->celulas[de].base, .verificacao = estado};
+        trie->infos[para] = trie->infos[de];
+
+        if (trie->infos[de].filhos) {
+            int32_t neto_base = trie->celulas[de].base;
+            for (int c = 1; c <= TRIE_DUPLA_LETRAS; c++) {
+                if (trie->celulas[neto_base + c].verificacao == de) {
+                    trie->celulas[neto_base + c].verificacao = para;
+                }
+            }
+        }
+
+        vincular_livre(trie, de);
+        trie->infos[de] = (info_dupla){0};
+    }
+
+    trie->celulas[estado].base = base;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Sem filhos, o estado recebe uma base nova só para o código.
+ * - Com filhos, usa a posição base + código se estiver livre ou
+ *   realoca os filhos do estado.
+ * - Retorna a posição do novo filho ou -1 em falha.
+ */
+static int32_t criar_filho(trie_dupla* trie, int32_t estado, int codigo) {
+    if (!trie->infos[estado].filhos) {
+        uint8_t unico = (uint8_t) codigo;
+        int32_t base = encontrar_base(trie, &unico, 1);
+        if (!garantir_capacidade(trie,
+                                 (size_t) base + TRIE_DUPLA_LETRAS + 1)) {
+            return -1;
+        }
+        trie->celulas[estado].base = base;
+    } else if (trie->celulas[trie->celulas[estado].base + codigo]
+                   .verificacao >= 0) {
+        if (!realocar(trie, estado, codigo)) {
+            return -1;
+        }
+    }
+
+    int32_t posicao = trie->celulas[estado].base + codigo;
+    ocupar(trie, posicao, estado);
+    trie->infos[estado].filhos++;
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Libera, subindo pelos pais, os estados sem palavras abaixo.
+ * - Retorna o primeiro estado mantido.
+ */
+static int32_t podar(trie_dupla* trie, int32_t estado) {
+    while (estado != 0 && trie->infos[estado].contagem == 0) {
+        int32_t pai = trie->celulas[estado].verificacao;
+        liberar(trie, estado);
+        trie->infos[pai].filhos--;
+        estado = pai;
+    }
+    return estado;
+}
+
+/*
+ * Implementação:
+ * - Recalcula o maior peso de cada estado, do informado até a raiz.
+ * - Para no primeiro estado cujo valor não mudou: os de cima também
+ *   não mudam.
+ */
+static void recalcular_pesos(trie_dupla* trie, int32_t estado) {
+    while (true) {
+        const info_dupla* info = &trie->infos[estado];
+        uint32_t maximo = info->terminal ? info->peso : 0;
+        if (info->filhos) {
+            int32_t base = trie->celulas[estado].base;
+            for (int c = 1; c <= TRIE_DUPLA_LETRAS; c++) {
+                int32_t filho = base + c;
+                if (trie->celulas[filho].verificacao == estado &&
+                    trie->infos[filho].peso_maximo > maximo) {
+                    maximo = trie->infos[filho].peso_maximo;
+                }
+            }
+        }
+
+        if (maximo == trie->infos[estado].peso_maximo) {
+            return;
+        }
+        trie->infos[estado].peso_maximo = maximo;
+        if (estado == 0) {
+            return;
+        }
+        estado = trie->celulas[estado].verificacao;
+    }
+}
+
+/*
+ * Implementação:
+ * - Incrementa (ou decrementa) a contagem de cada estado, do
+ *   informado até a raiz.
+ */
+static void
+ajustar_contagens(trie_dupla* trie, int32_t estado, bool incrementar) {
+    while (true) {
+        if (incrementar) {
+            trie->infos[estado].contagem++;
+        } else {
+            trie->infos[estado].contagem--;
+        }
+        if (estado == 0) {
+            return;
+        }
+        estado = trie->celulas[estado].verificacao;
+    }
+}
+
+/*
+ * Implementação:
+ * - Desce pelo prefixo; retorna o estado alcançado ou -1.
+ */
+static int32_t localizar(const trie_dupla* trie, const char* prefixo) {
+    int32_t estado = 0;
+    for (; *prefixo; prefixo++) {
+        int codigo = codigo_de(*prefixo);
+        if (!codigo) {
+            return -1;
+        }
+        estado = filho_de(trie, estado, codigo);
+        if (estado < 0) {
+            return -1;
+        }
+    }
+    return estado;
+}
+
+/*
+ * Implementação:
+ * - Aloca os vetores com todas as posições livres e ocupa a raiz.
+ */
+trie_dupla* trie_dupla_criar(void) {
+    trie_dupla* trie = calloc(1, sizeof *trie);
+    if (!trie) {
+        return NULL;
+    }
+
+    trie->livre = SEM_LIVRE;
+    trie->capacidade = 1;
+    trie->celulas = malloc(sizeof *trie->celulas);
+    trie->infos = malloc(sizeof *trie->infos);
+    if (!trie->celulas || !trie->infos) {
+        trie_dupla_destruir(trie);
+        return NULL;
+    }
+
+    trie->infos[0] = (info_dupla){0};
+    vincular_livre(trie, 0);
+    if (!garantir_capacidade(trie, CAPACIDADE_INICIAL)) {
+        trie_dupla_destruir(trie);
+        return NULL;
+    }
+
+    ocupar(trie, 0, 0);
+    return trie;
+}
+
+/*
+ * Implementação:
+ * - Libera os vetores e a estrutura.
+ */
+void trie_dupla_destruir(trie_dupla* trie) {
+    if (!trie) {
+        return;
+    }
+
+    free(trie->celulas);
+    free(trie->infos);
+    free(trie);
+}
+
+/*
+ * Implementação:
+ * - Valida a palavra antes de criar qualquer estado.
+ * - Desce criando os filhos que faltam; em falha, poda os estados
+ *   criados e nada muda.
+ * - Marca o estado final, atualiza as contagens (se a palavra for
+ *   nova) e os maiores pesos (se houver peso).
+ */
+bool trie_dupla_inserir(trie_dupla* trie,
+                        const char* palavra,
+                        const uint32_t* peso) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+    for (const char* p = palavra; *p; p++) {
+        if (!codigo_de(*p)) {
+            return false;
+        }
+    }
+
+    int32_t estado = 0;
+    for (; *palavra; palavra++) {
+        int codigo = codigo_de(*palavra);
+        int32_t proximo = filho_de(trie, estado, codigo);
+        if (proximo < 0) {
+            proximo = criar_filho(trie, estado, codigo);
+            if (proximo < 0) {
+                podar(trie, estado);
+                return false;
+            }
+        }
+        estado = proximo;
+    }
+
+    info_dupla* info = &trie->infos[estado];
+    bool inseriu = !info->terminal;
+    info->terminal = true;
+    if (peso) {
+        info->peso = *peso;
+    }
+
+    if (inseriu) {
+        ajustar_contagens(trie, estado, true);
+        trie->total_palavras++;
+    }
+    if (peso) {
+        recalcular_pesos(trie, estado);
+    }
+    return inseriu;
+}
+
+/*
+ * Implementação:
+ * - Desmarca o estado final e atualiza as contagens.
+ * - Poda os estados que ficaram sem palavras e recalcula os maiores
+ *   pesos a partir do primeiro estado mantido.
+ */
+bool trie_dupla_remover(trie_dupla* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    int32_t estado = localizar(trie, palavra);
+    if (estado <= 0 || !trie->infos[estado].terminal) {
+        return false;
+    }
+
+    trie->infos[estado].terminal = false;
+    trie->infos[estado].peso = 0;
+    ajustar_contagens(trie, estado, false);
+    trie->total_palavras--;
+
+    recalcular_pesos(trie, podar(trie, estado));
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Um acesso por caractere; a palavra existe se o estado final for
+ *   terminal.
+ */
+bool trie_dupla_contem(const trie_dupla* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    int32_t estado = localizar(trie, palavra);
+    return estado > 0 && trie->infos[estado].terminal;
+}
+
+/*
+ * Implementação:
+ * - Peso do estado final, se ele for terminal.
+ */
+uint32_t trie_dupla_peso(const trie_dupla* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return 0;
+    }
+
+    int32_t estado = localizar(trie, palavra);
+    if (estado <= 0 || !trie->infos[estado].terminal) {
+        return 0;
+    }
+    return trie->infos[estado].peso;
+}
+
+/*
+ * Implementação:
+ * - Enfileira cada filho do estado com chave igual ao maior peso
+ *   abaixo dele.
+ */
+static void enfileirar_filhos(busca_ranqueada* busca,
+                              const trie_dupla* trie,
+                              int32_t estado,
+                              size_t elo) {
+    if (!trie->infos[estado].filhos) {
+        return;
+    }
+
+    int32_t base = trie->celulas[estado].base;
+    for (int c = 1; c <= TRIE_DUPLA_LETRAS; c++) {
+        int32_t filho = base + c;
+        if (trie->celulas[filho].verificacao == estado) {
+            busca_ranqueada_inserir(
+                busca,
+                (candidato_ranqueado){
+                    .no = (uintptr_t) filho,
+                    .elo = elo,
+                    .peso = trie->infos[filho].peso_maximo});
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Mesmo procedimento de trie_buscar_por_prefixo_ranqueado; cada
+ *   candidato não completo é um estado, cujo caractere é obtido pela
+ *   diferença entre sua posição e a base do pai.
+ */
+char** trie_dupla_buscar_por_prefixo_ranqueado(const trie_dupla* trie,
+                                               const char* prefixo,
+                                               size_t k,
+                                               size_t* quantidade) {
+    if (!trie || !quantidade) {
+        return NULL;
+    }
+
+    if (!prefixo) {
+        prefixo = "";
+    }
+
+    busca_ranqueada busca;
+    if (k == 0 || !busca_ranqueada_iniciar(&busca, prefixo)) {
+        *quantidade = 0;
+        return NULL;
+    }
+
+    int32_t inicio = localizar(trie, prefixo);
+    if (inicio >= 0) {
+        if (inicio > 0 && trie->infos[inicio].terminal) {
+            busca_ranqueada_inserir(
+                &busca,
+                (candidato_ranqueado){.no = (uintptr_t) inicio,
+                                      .peso = trie->infos[inicio].peso,
+                                      .completo = true});
+        }
+        enfileirar_filhos(&busca, trie, inicio, 0);
+    }
+
+    candidato_ranqueado candidato;
+    while (busca.resultado.tamanho < k &&
+           busca_ranqueada_retirar(&busca, &candidato)) {
+        if (candidato.completo) {
+            busca_ranqueada_aceitar(&busca, candidato.elo);
+            continue;
+        }
+
+        int32_t estado = (int32_t) candidato.no;
+        int32_t pai = trie->celulas[estado].verificacao;
+        char caractere = letra_de(estado - trie->celulas[pai].base);
+
+        size_t elo;
+        if (!busca_ranqueada_estender(
+                &busca, candidato.elo, caractere, &elo)) {
+            break;
+        }
+        if (trie->infos[estado].terminal) {
+            busca_ranqueada_inserir(
+                &busca,
+                (candidato_ranqueado){.no = candidato.no,
+                                      .elo = elo,
+                                      .peso = trie->infos[estado].peso,
+                                      .completo = true});
+        }
+        enfileirar_filhos(&busca, trie, estado, elo);
+    }
+
+    return busca_ranqueada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Visita os filhos em ordem de código, calculando a linha de cada
+ *   um, e só desce se a linha ainda admite alguma palavra.
+ */
+static void buscar_aproximado_rec(const trie_dupla* trie,
+                                  int32_t estado,
+                                  size_t profundidade,
+                                  busca_aproximada* busca) {
+    int32_t base = trie->celulas[estado].base;
+    for (int c = 1; c <= TRIE_DUPLA_LETRAS && !busca->falhou; c++) {
+        int32_t filho = base + c;
+        if (trie->celulas[filho].verificacao != estado) {
+            continue;
+        }
+
+        size_t minimo =
+            busca_aproximada_avancar(busca, profundidade, letra_de(c));
+        if (trie->infos[filho].terminal) {
+            busca_aproximada_aceitar(busca, profundidade + 1);
+        }
+        if (minimo <= busca->max_distancia && trie->infos[filho].filhos) {
+            buscar_aproximado_rec(trie, filho, profundidade + 1, busca);
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a Trie a partir da raiz, mantendo uma linha de
+ *   Levenshtein por profundidade.
+ */
+char** trie_dupla_buscar_aproximado(const trie_dupla* trie,
+                                    const char* palavra,
+                                    size_t max_distancia,
+                                    size_t* quantidade) {
+    if (!trie || !palavra || !quantidade) {
+        return NULL;
+    }
+
+    busca_aproximada busca;
+    if (busca_aproximada_iniciar(&busca, palavra, max_distancia)) {
+        buscar_aproximado_rec(trie, 0, 0, &busca);
+    }
+
+    return busca_aproximada_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - Visita apenas os códigos dentro dos limites aceitos na
+ *   profundidade.
+ */
+static void buscar_padrao_rec(const trie_dupla* trie,
+                              int32_t estado,
+                              size_t profundidade,
+                              busca_padrao* busca) {
+    char minimo = 0;
+    char maximo = 0;
+    busca_padrao_limites(busca, profundidade, &minimo, &maximo);
+
+    int primeiro = minimo < 'a' ? 1 : codigo_de(minimo);
+    int ultimo = maximo > 'z' ? TRIE_DUPLA_LETRAS : codigo_de(maximo);
+    if (!primeiro || !ultimo) {
+        return;
+    }
+
+    int32_t base = trie->celulas[estado].base;
+    for (int c = primeiro; c <= ultimo && !busca->falhou; c++) {
+        int32_t filho = base + c;
+        if (trie->celulas[filho].verificacao != estado) {
+            continue;
+        }
+
+        bool continuar =
+            busca_padrao_avancar(busca, profundidade, letra_de(c));
+        if (trie->infos[filho].terminal) {
+            busca_padrao_aceitar(busca, profundidade + 1);
+        }
+        if (continuar && trie->infos[filho].filhos) {
+            buscar_padrao_rec(trie, filho, profundidade + 1, busca);
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a Trie a partir da raiz, mantendo o conjunto de posições
+ *   ativas por profundidade.
+ */
+char** trie_dupla_buscar_padrao(const trie_dupla* trie,
+                                const char* padrao,
+                                size_t* quantidade) {
+    if (!trie || !padrao || !*padrao || !quantidade) {
+        return NULL;
+    }
+
+    busca_padrao busca;
+    if (busca_padrao_iniciar(&busca, padrao)) {
+        buscar_padrao_rec(trie, 0, 0, &busca);
+    }
+
+    return busca_padrao_concluir(&busca, quantidade);
+}
+
+/*
+ * Implementação:
+ * - A contagem do estado do prefixo já é a resposta.
+ */
+size_t trie_dupla_contar_prefixo(const trie_dupla* trie, const char* prefixo) {
+    if (!trie) {
+        return 0;
+    }
+
+    int32_t estado = localizar(trie, prefixo ? prefixo : "");
+    return estado < 0 ? 0 : trie->infos[estado].contagem;
+}
+
+/*
+ * Implementação:
+ * - A cada caractere, soma as contagens dos irmãos de código menor e,
+ *   se a palavra continuar, a do próprio estado (que é um prefixo
+ *   próprio da palavra, portanto menor).
+ */
+size_t trie_dupla_rank(const trie_dupla* trie, const char* palavra) {
+    if (!trie || !palavra) {
+        return 0;
+    }
+
+    size_t posicao = 0;
+    int32_t estado = 0;
+    for (; *palavra; palavra++) {
+        int codigo = codigo_de(*palavra);
+        if (!codigo) {
+            break;
+        }
+
+        if (trie->infos[estado].filhos) {
+            int32_t base = trie->celulas[estado].base;
+            for (int c = 1; c < codigo; c++) {
+                if (trie->celulas[base + c].verificacao == estado) {
+                    posicao += trie->infos[base + c].contagem;
+                }
+            }
+        }
+
+        estado = filho_de(trie, estado, codigo);
+        if (estado < 0 || *(palavra + 1) == '\0') {
+            break;
+        }
+        posicao += trie->infos[estado].terminal ? 1 : 0;
+    }
+
+    return posicao;
+}
+
+/*
+ * Implementação:
+ * - Desce pelas contagens: pula os filhos cujas palavras vêm antes da
+ *   k-ésima e, ao descer por um filho, conta a sua própria palavra.
+ */
+char* trie_dupla_selecionar(const trie_dupla* trie, size_t k) {
+    if (!trie || k >= trie->infos[0].contagem) {
+        return NULL;
+    }
+
+    char* buffer = NULL;
+    size_t capacidade = 0;
+    size_t tamanho = 0;
+    int32_t estado = 0;
+
+    while (trie->infos[estado].filhos) {
+        int32_t base = trie->celulas[estado].base;
+        int32_t escolhido = -1;
+        int c = 1;
+        for (; c <= TRIE_DUPLA_LETRAS; c++) {
+            int32_t filho = base + c;
+            if (trie->celulas[filho].verificacao != estado) {
+                continue;
+            }
+            if (k < trie->infos[filho].contagem) {
+                escolhido = filho;
+                break;
+            }
+            k -= trie->infos[filho].contagem;
+        }
+        if (escolhido < 0 ||
+            !garantir_tamanho_buffer(&buffer, &capacidade, tamanho + 2)) {
+            break;
+        }
+
+        buffer[tamanho++] = letra_de(c);
+        if (trie->infos[escolhido].terminal) {
+            if (k == 0) {
+                buffer[tamanho] = '\0';
+                return buffer;
+            }
+            k--;
+        }
+        estado = escolhido;
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Empilha o estado a partir do primeiro código, dobrando a pilha
+ *   se necessário. Ignora estados sem filhos.
+ */
+static bool cursor_empilhar(trie_dupla_cursor* cursor,
+                            int32_t estado,
+                            size_t profundidade) {
+    if (!cursor->trie->infos[estado].filhos) {
+        return true;
+    }
+
+    if (cursor->topo == cursor->capacidade_pilha) {
+        size_t nova_cap =
+            cursor->capacidade_pilha ? cursor->capacidade_pilha * 2 : 32;
+        trie_dupla_quadro* tmp =
+            realloc(cursor->pilha, nova_cap * sizeof *cursor->pilha);
+        if (!tmp) {
+            cursor->falhou = true;
+            return false;
+        }
+        cursor->pilha = tmp;
+        cursor->capacidade_pilha = nova_cap;
+    }
+
+    cursor->pilha[cursor->topo++] = (trie_dupla_quadro){
+        .estado = estado, .proximo = 1, .profundidade = profundidade};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Copia o prefixo para o buffer e desce até o seu estado.
+ * - Empilha esse estado e marca o próprio prefixo como pendente se
+ *   for palavra.
+ */
+bool trie_dupla_cursor_abrir(trie_dupla_cursor* cursor,
+                             const trie_dupla* trie,
+                             const char* prefixo) {
+    *cursor = (trie_dupla_cursor){.trie = trie};
+    if (!trie) {
+        return true;
+    }
+
+    size_t len = prefixo ? strlen(prefixo) : 0;
+    if (!garantir_tamanho_buffer(
+            &cursor->buffer, &cursor->capacidade_buffer, len + 1)) {
+        cursor->falhou = true;
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cursor->buffer, prefixo ? prefixo : "", len);
+    cursor->buffer[len] = '\0';
+
+    int32_t estado = localizar(trie, cursor->buffer);
+    if (estado < 0) {
+        return true;
+    }
+
+    cursor->prefixo_pendente = estado > 0 && trie->infos[estado].terminal;
+    return cursor_empilhar(cursor, estado, len);
+}
+
+/*
+ * Implementação:
+ * - O topo da pilha indica o estado e o próximo código a testar.
+ *   Encontrado o próximo filho, o quadro avança além dele, o
+ *   caractere é escrito no buffer e o filho é empilhado, para ser
+ *   percorrido antes dos irmãos seguintes.
+ * - Sem mais filhos, o quadro sai da pilha.
+ */
+const char* trie_dupla_cursor_proximo(trie_dupla_cursor* cursor) {
+    if (cursor->prefixo_pendente) {
+        cursor->prefixo_pendente = false;
+        return cursor->buffer;
+    }
+
+    const trie_dupla* trie = cursor->trie;
+    while (cursor->topo > 0 && !cursor->falhou) {
+        trie_dupla_quadro* q = &cursor->pilha[cursor->topo - 1];
+        int32_t base = trie->celulas[q->estado].base;
+        int c = q->proximo;
+        while (c <= TRIE_DUPLA_LETRAS &&
+               trie->celulas[base + c].verificacao != q->estado) {
+            c++;
+        }
+        if (c > TRIE_DUPLA_LETRAS) {
+            cursor->topo--;
+            continue;
+        }
+
+        q->proximo = (uint8_t) (c + 1);
+        size_t profundidade = q->profundidade;
+        int32_t filho = base + c;
+
+        if (!garantir_tamanho_buffer(&cursor->buffer,
+                                     &cursor->capacidade_buffer,
+                                     profundidade + 2)) {
+            cursor->falhou = true;
+            break;
+        }
+        cursor->buffer[profundidade] = letra_de(c);
+        cursor_empilhar(cursor, filho, profundidade + 1);
+        if (trie->infos[filho].terminal) {
+            cursor->buffer[profundidade + 1] = '\0';
+            return cursor->buffer;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Libera pilha e buffer e zera o cursor.
+ */
+void trie_dupla_cursor_fechar(trie_dupla_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    free(cursor->pilha);
+    free(cursor->buffer);
+    *cursor = (trie_dupla_cursor){0};
+}
+
+/*
+ * Implementação:
+ * - Conta os estados com filhos (conjuntos de irmãos de altura 1) e
+ *   o comprimento de cada palavra.
+ */
+static void coletar_estatisticas_rec(const trie_dupla* trie,
+                                     int32_t estado,
+                                     size_t profundidade,
+                                     varredura_dupla* v) {
+    const info_dupla* info = &trie->infos[estado];
+    if (info->terminal) {
+        v->palavras++;
+        v->soma_comprimentos += profundidade;
+        if (profundidade > v->saida->comprimento_maximo) {
+            v->saida->comprimento_maximo = profundidade;
+        }
+    }
+    if (!info->filhos) {
+        return;
+    }
+
+    v->saida->conjuntos_irmaos++;
+    int32_t base = trie->celulas[estado].base;
+    for (int c = 1; c <= TRIE_DUPLA_LETRAS; c++) {
+        if (trie->celulas[base + c].verificacao == estado) {
+            coletar_estatisticas_rec(trie, base + c, profundidade + 1, v);
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir da raiz; profundidade e comprimento coincidem.
+ */
+void trie_dupla_coletar_estatisticas(const trie_dupla* trie,
+                                     estatisticas_trie* estatisticas) {
+    *estatisticas = (estatisticas_trie){0};
+    if (!trie || !trie->infos[0].filhos) {
+        return;
+    }
+
+    varredura_dupla v = {.saida = estatisticas};
+    coletar_estatisticas_rec(trie, 0, 0, &v);
+
+    if (v.palavras > 0) {
+        estatisticas->comprimento_medio =
+            (double) v.soma_comprimentos / (double) v.palavras;
+    }
+    estatisticas->profundidade_media = estatisticas->comprimento_medio;
+    estatisticas->profundidade_maxima = estatisticas->comprimento_maximo;
+    estatisticas->altura_media_irmaos = 1.0;
+    estatisticas->altura_maxima_irmaos = 1;
+    estatisticas->histograma_irmaos[1] = estatisticas->conjuntos_irmaos;
+}
+
+/*
+ * Implementação:
+ * - Capacidade dos dois vetores.
+ */
+size_t trie_dupla_bytes_reservados(const trie_dupla* trie) {
+    return trie->capacidade * (sizeof(celula_dupla) + sizeof(info_dupla));
+}
@@ -0,0 +1,888 @@
+/**
+ * @file trie_rajada.c
+ * @brief Implementação da Trie de rajada.
+ */
+
+#include "trie_rajada.h"
+
+#include "util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TAM_CABECALHO_ENTRADA 2
+#define TAM_PESO_ENTRADA 4
+#define CAPACIDADE_BALDE_INICIAL 64
+#define MAX_SUFIXO UINT16_MAX
+
+/**
+ * @struct varredura_rajada
+ * @brief Somas acumuladas durante trie_rajada_coletar_estatisticas.
+ */
+typedef struct {
+    estatisticas_trie* saida;
+    size_t palavras;
+    size_t soma_profundidades;
+    size_t soma_comprimentos;
+} varredura_rajada;
+
+/*
+ * Implementação:
+ * - Código da letra (1 a 26) ou 0 se estiver fora de a–z.
+ */
+static int codigo_de(char caractere) {
+    if (caractere < 'a' || caractere > 'z') {
+        return 0;
+    }
+    return caractere - 'a' + 1;
+}
+
+/*
+ * Implementação:
+ * - Letra do código (inverso de codigo_de).
+ */
+static char letra_de(int codigo) {
+    return (char) ('a' + codigo - 1);
+}
+
+/*
+ * Implementação:
+ * - Bit de 'recipientes' correspondente ao código.
+ */
+static uint32_t bit_de(int codigo) {
+    return UINT32_C(1) << (codigo - 1);
+}
+
+/*
+ * Implementação:
+ * - Bytes de uma entrada com sufixo de n caracteres.
+ */
+static size_t tamanho_entrada(size_t n) {
+    return TAM_CABECALHO_ENTRADA + n + TAM_PESO_ENTRADA;
+}
+
+/*
+ * Implementação:
+ * - Campos de uma entrada, lidos e gravados com memcpy (as entradas
+ *   não são alinhadas).
+ */
+static size_t ler_tamanho(const char* entrada) {
+    uint16_t tamanho;
+    memcpy(&tamanho, entrada, sizeof tamanho);
+    return tamanho;
+}
+
+static uint32_t ler_peso(const char* entrada) {
+    uint32_t peso;
+    memcpy(&peso,
+           entrada + TAM_CABECALHO_ENTRADA + ler_tamanho(entrada),
+           sizeof peso);
+    return peso;
+}
+
+static void gravar_peso(char* entrada, uint32_t peso) {
+    memcpy(entrada + TAM_CABECALHO_ENTRADA + ler_tamanho(entrada),
+           &peso,
+           sizeof peso);
+}
+
+/*
+ * Implementação:
+ * - FNV-1a de 32 bits sobre o sufixo, reduzido ao número de baldes
+ *   (potência de 2).
+ */
+static uint32_t indice_balde(const char* sufixo, size_t n) {
+    uint32_t hash = UINT32_C(2166136261);
+    for (size_t i = 0; i < n; i++) {
+        hash ^= (uint8_t) sufixo[i];
+        hash *= UINT32_C(16777619);
+    }
+    return hash & (TRIE_RAJADA_BALDES - 1);
+}
+
+/*
+ * Implementação:
+ * - Percorre as entradas do balde em sequência, comparando primeiro
+ *   o tamanho.
+ * - Retorna a entrada ou NULL.
+ */
+static char*
+procurar_entrada(const balde_rajada* balde, const char* sufixo, size_t n) {
+    if (!balde) {
+        return NULL;
+    }
+
+    const char* entrada = balde->dados;
+    const char* fim = balde->dados + balde->usados;
+    while (entrada < fim) {
+        size_t tamanho = ler_tamanho(entrada);
+        if (tamanho == n &&
+            memcmp(entrada + TAM_CABECALHO_ENTRADA, sufixo, n) == 0) {
+            return (char*) entrada;
+        }
+        entrada += tamanho_entrada(tamanho);
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Entrada do sufixo no recipiente, ou NULL.
+ */
+static char* procurar_no_recipiente(const recipiente_rajada* recipiente,
+                                    const char* sufixo) {
+    size_t n = strlen(sufixo);
+    return procurar_entrada(
+        recipiente->baldes[indice_balde(sufixo, n)], sufixo, n);
+}
+
+/*
+ * Implementação:
+ * - Aloca um recipiente vazio (todos os baldes NULL).
+ */
+static recipiente_rajada* criar_recipiente(trie_rajada* trie) {
+    recipiente_rajada* recipiente = calloc(1, sizeof *recipiente);
+    if (recipiente) {
+        trie->total_recipientes++;
+    }
+    return recipiente;
+}
+
+/*
+ * Implementação:
+ * - Libera os baldes e o recipiente, descontando-os dos contadores.
+ */
+static void destruir_recipiente(trie_rajada* trie,
+                                recipiente_rajada* recipiente) {
+    for (size_t i = 0; i < TRIE_RAJADA_BALDES; i++) {
+        balde_rajada* balde = recipiente->baldes[i];
+        if (balde) {
+            trie->bytes_baldes -= balde->usados;
+            trie->capacidade_baldes -= sizeof *balde + balde->capacidade;
+            free(balde);
+        }
+    }
+
+    free(recipiente);
+    trie->total_recipientes--;
+}
+
+/*
+ * Implementação:
+ * - Acrescenta a entrada ao fim do balde do sufixo, dobrando o balde
+ *   se preciso. Não verifica duplicatas.
+ */
+static bool acrescentar_entrada(trie_rajada* trie,
+                                recipiente_rajada* recipiente,
+                                const char* sufixo,
+                                size_t n,
+                                uint32_t peso) {
+    balde_rajada** posicao = &recipiente->baldes[indice_balde(sufixo, n)];
+    balde_rajada* balde = *posicao;
+    size_t necessario = tamanho_entrada(n);
+    size_t usados = balde ? balde->usados : 0;
+    size_t capacidade = balde ? balde->capacidade : 0;
+
+    if (usados + necessario > capacidade) {
+        size_t nova_cap =
+            capacidade ? capacidade * 2 : CAPACIDADE_BALDE_INICIAL;
+        while (nova_cap < usados + necessario) {
+            nova_cap *= 2;
+        }
+        balde_rajada* tmp = realloc(balde, sizeof *balde + nova_cap);
+        if (!tmp) {
+            return false;
+        }
+        if (!balde) {
+            tmp->usados = 0;
+            trie->capacidade_baldes += sizeof *balde;
+        }
+        tmp->capacidade = (uint32_t) nova_cap;
+        trie->capacidade_baldes += nova_cap - capacidade;
+        balde = tmp;
+        *posicao = balde;
+    }
+
+    char* entrada = balde->dados + balde->usados;
+    uint16_t tamanho = (uint16_t) n;
+    memcpy(entrada, &tamanho, sizeof tamanho);
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(entrada + TAM_CABECALHO_ENTRADA, sufixo, n);
+    gravar_peso(entrada, peso);
+
+    balde->usados += (uint32_t) necessario;
+    trie->bytes_baldes += necessario;
+    recipiente->palavras++;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Fecha o espaço da entrada deslocando as seguintes; um balde que
+ *   fica vazio é liberado.
+ */
+static void retirar_entrada(trie_rajada* trie,
+                            recipiente_rajada* recipiente,
+                            char* entrada) {
+    size_t n = ler_tamanho(entrada);
+    uint32_t indice = indice_balde(entrada + TAM_CABECALHO_ENTRADA, n);
+    balde_rajada* balde = recipiente->baldes[indice];
+    size_t tamanho = tamanho_entrada(n);
+    const char* fim = balde->dados + balde->usados;
+
+    memmove(entrada, entrada + tamanho, (size_t) (fim - (entrada + tamanho)));
+    balde->usados -= (uint32_t) tamanho;
+    trie->bytes_baldes -= tamanho;
+    recipiente->palavras--;
+
+    if (balde->usados == 0) {
+        trie->capacidade_baldes -= sizeof *balde + balde->capacidade;
+        free(balde);
+        recipiente->baldes[indice] = NULL;
+    }
+}
+
+/*
+ * Implementação:
+ * - Aloca um nó sem filhos.
+ */
+static no_rajada* criar_no(trie_rajada* trie) {
+    no_rajada* no = calloc(1, sizeof *no);
+    if (no) {
+        trie->nos++;
+    }
+    return no;
+}
+
+/*
+ * Implementação:
+ * - Libera recursivamente os filhos (nós e recipientes) e o nó.
+ */
+static void destruir_no(trie_rajada* trie, no_rajada* no) {
+    for (int c = 1; c <= TRIE_RAJADA_LETRAS; c++) {
+        void* filho = no->filhos[c - 1];
+        if (!filho) {
+            continue;
+        }
+        if (no->recipientes & bit_de(c)) {
+            destruir_recipiente(trie, filho);
+        } else {
+            destruir_no(trie, filho);
+        }
+    }
+
+    free(no);
+    trie->nos--;
+}
+
+/*
+ * Implementação:
+ * - Monta um nó com as entradas do recipiente pai->filhos[c - 1]: o
+ *   sufixo vazio vira a palavra do nó e os demais vão, sem o primeiro
+ *   caractere, para o recipiente da sua letra.
+ * - Só então troca o recipiente pelo nó; em falha, descarta o nó e o
+ *   recipiente fica como estava (apenas maior que o limite).
+ * - Recipientes novos que ainda passem do limite (todos os sufixos
+ *   com a mesma letra) também estouram.
+ */
+static void estourar(trie_rajada* trie, no_rajada* pai, int c) {
+    recipiente_rajada* recipiente = pai->filhos[c - 1];
+    no_rajada* novo = criar_no(trie);
+    bool ok = novo != NULL;
+
+    for (size_t i = 0; ok && i < TRIE_RAJADA_BALDES; i++) {
+        const balde_rajada* balde = recipiente->baldes[i];
+        if (!balde) {
+            continue;
+        }
+        const char* entrada = balde->dados;
+        const char* fim = balde->dados + balde->usados;
+        for (; ok && entrada < fim;
+             entrada += tamanho_entrada(ler_tamanho(entrada))) {
+            size_t n = ler_tamanho(entrada);
+            const char* sufixo = entrada + TAM_CABECALHO_ENTRADA;
+            if (n == 0) {
+                novo->terminal = true;
+                novo->peso = ler_peso(entrada);
+                continue;
+            }
+
+            int d = codigo_de(sufixo[0]);
+            recipiente_rajada* filho = novo->filhos[d - 1];
+            if (!filho) {
+                filho = criar_recipiente(trie);
+                ok = filho != NULL;
+                novo->filhos[d - 1] = filho;
+                novo->recipientes |= bit_de(d);
+            }
+            ok = ok && acrescentar_entrada(
+                           trie, filho, sufixo + 1, n - 1, ler_peso(entrada));
+        }
+    }
+
+    if (!ok) {
+        if (novo) {
+            destruir_no(trie, novo);
+        }
+        return;
+    }
+
+    pai->filhos[c - 1] = novo;
+    pai->recipientes &= ~bit_de(c);
+    destruir_recipiente(trie, recipiente);
+
+    for (int d = 1; d <= TRIE_RAJADA_LETRAS; d++) {
+        const recipiente_rajada* filho = novo->filhos[d - 1];
+        if (filho && (novo->recipientes & bit_de(d)) &&
+            filho->palavras > TRIE_RAJADA_LIMITE) {
+            estourar(trie, novo, d);
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Desce pelos nós, um caractere por nó.
+ * - Se a palavra terminar em um nó, retorna-o em 'no' e NULL; se
+ *   chegar a um recipiente, retorna a entrada do restante da palavra
+ *   (NULL se não houver) e 'no' fica NULL.
+ */
+static char*
+localizar(const trie_rajada* trie, const char* palavra, no_rajada** no) {
+    no_rajada* atual = trie->raiz;
+    *no = NULL;
+
+    for (; *palavra; palavra++) {
+        int c = codigo_de(*palavra);
+        void* filho = c ? atual->filhos[c - 1] : NULL;
+        if (!filho) {
+            return NULL;
+        }
+        if (atual->recipientes & bit_de(c)) {
+            return procurar_no_recipiente(filho, palavra + 1);
+        }
+        atual = filho;
+    }
+
+    *no = atual;
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Aloca a estrutura e o nó raiz.
+ */
+trie_rajada* trie_rajada_criar(void) {
+    trie_rajada* trie = calloc(1, sizeof *trie);
+    if (!trie) {
+        return NULL;
+    }
+
+    trie->raiz = criar_no(trie);
+    if (!trie->raiz) {
+        free(trie);
+        return NULL;
+    }
+
+    return trie;
+}
+
+/*
+ * Implementação:
+ * - Libera a árvore a partir da raiz e a estrutura.
+ */
+void trie_rajada_destruir(trie_rajada* trie) {
+    if (!trie) {
+        return;
+    }
+
+    destruir_no(trie, trie->raiz);
+    free(trie);
+}
+
+/*
+ * Implementação:
+ * - Valida a palavra (a–z, sufixos de até MAX_SUFIXO caracteres).
+ * - Desce pelos nós; sem filho pela letra, cria um recipiente vazio.
+ * - No recipiente, atualiza o peso de uma entrada existente ou
+ *   acrescenta uma nova e estoura o recipiente se ele passar do
+ *   limite. Um recipiente criado aqui que continue vazio por falha é
+ *   descartado.
+ * - Se a palavra terminar em um nó, marca-o.
+ */
+bool trie_rajada_inserir(trie_rajada* trie,
+                         const char* palavra,
+                         const uint32_t* peso) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+    size_t tamanho = 0;
+    for (; palavra[tamanho]; tamanho++) {
+        if (!codigo_de(palavra[tamanho])) {
+            return false;
+        }
+    }
+    if (tamanho > MAX_SUFIXO) {
+        return false;
+    }
+
+    no_rajada* no = trie->raiz;
+    for (const char* p = palavra; *p; p++) {
+        int c = codigo_de(*p);
+        void* filho = no->filhos[c - 1];
+        if (!filho) {
+            filho = criar_recipiente(trie);
+            if (!filho) {
+                return false;
+            }
+            no->filhos[c - 1] = filho;
+            no->recipientes |= bit_de(c);
+        }
+        if (!(no->recipientes & bit_de(c))) {
+            no = filho;
+            continue;
+        }
+
+        recipiente_rajada* recipiente = filho;
+        const char* sufixo = p + 1;
+        char* entrada = procurar_no_recipiente(recipiente, sufixo);
+        if (entrada) {
+            if (peso) {
+                gravar_peso(entrada, *peso);
+            }
+            return false;
+        }
+
+        if (!acrescentar_entrada(trie,
+                                 recipiente,
+                                 sufixo,
+                                 tamanho - (size_t) (sufixo - palavra),
+                                 peso ? *peso : 0)) {
+            if (recipiente->palavras == 0) {
+                destruir_recipiente(trie, recipiente);
+                no->filhos[c - 1] = NULL;
+                no->recipientes &= ~bit_de(c);
+            }
+            return false;
+        }
+
+        trie->total_palavras++;
+        if (recipiente->palavras > TRIE_RAJADA_LIMITE) {
+            estourar(trie, no, c);
+        }
+        return true;
+    }
+
+    bool inseriu = !no->terminal;
+    no->terminal = true;
+    if (peso) {
+        no->peso = *peso;
+    }
+    if (inseriu) {
+        trie->total_palavras++;
+    }
+    return inseriu;
+}
+
+/*
+ * Implementação:
+ * - Desce como localizar, guardando o pai do recipiente.
+ * - Retira a entrada e libera o recipiente se ele ficar vazio, ou
+ *   desmarca o nó em que a palavra termina.
+ */
+bool trie_rajada_remover(trie_rajada* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    no_rajada* no = trie->raiz;
+    for (; *palavra; palavra++) {
+        int c = codigo_de(*palavra);
+        void* filho = c ? no->filhos[c - 1] : NULL;
+        if (!filho) {
+            return false;
+        }
+        if (!(no->recipientes & bit_de(c))) {
+            no = filho;
+            continue;
+        }
+
+        recipiente_rajada* recipiente = filho;
+        char* entrada = procurar_no_recipiente(recipiente, palavra + 1);
+        if (!entrada) {
+            return false;
+        }
+
+        retirar_entrada(trie, recipiente, entrada);
+        if (recipiente->palavras == 0) {
+            destruir_recipiente(trie, recipiente);
+            no->filhos[c - 1] = NULL;
+            no->recipientes &= ~bit_de(c);
+        }
+        trie->total_palavras--;
+        return true;
+    }
+
+    if (!no->terminal) {
+        return false;
+    }
+    no->terminal = false;
+    no->peso = 0;
+    trie->total_palavras--;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - A palavra existe se houver entrada no recipiente ou se o nó em
+ *   que ela termina for terminal.
+ */
+bool trie_rajada_contem(const trie_rajada* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return false;
+    }
+
+    no_rajada* no = NULL;
+    const char* entrada = localizar(trie, palavra, &no);
+    return entrada || (no && no->terminal);
+}
+
+/*
+ * Implementação:
+ * - Peso da entrada ou do nó terminal.
+ */
+uint32_t trie_rajada_peso(const trie_rajada* trie, const char* palavra) {
+    if (!trie || !palavra || !*palavra) {
+        return 0;
+    }
+
+    no_rajada* no = NULL;
+    const char* entrada = localizar(trie, palavra, &no);
+    if (entrada) {
+        return ler_peso(entrada);
+    }
+    return no && no->terminal ? no->peso : 0;
+}
+
+/*
+ * Implementação:
+ * - Ordem lexicográfica dos sufixos de duas entradas; um sufixo vem
+ *   antes dos que o estendem.
+ */
+static int comparar_entradas(const void* a, const void* b) {
+    const char* x = *(const char* const*) a;
+    const char* y = *(const char* const*) b;
+    size_t tx = ler_tamanho(x);
+    size_t ty = ler_tamanho(y);
+    int r = memcmp(x + TAM_CABECALHO_ENTRADA,
+                   y + TAM_CABECALHO_ENTRADA,
+                   tx < ty ? tx : ty);
+    if (r != 0) {
+        return r;
+    }
+    return (tx > ty) - (tx < ty);
+}
+
+/*
+ * Implementação:
+ * - Reúne as entradas do recipiente cujo sufixo começa com 'resto' e
+ *   as ordena; os sufixos serão escritos no buffer a partir de
+ *   'profundidade'.
+ */
+static bool carregar_recipiente(trie_rajada_cursor* cursor,
+                                const recipiente_rajada* recipiente,
+                                size_t profundidade,
+                                const char* resto,
+                                size_t tamanho_resto) {
+    if (recipiente->palavras > cursor->capacidade_entradas) {
+        const char** tmp = realloc(
+            cursor->entradas, recipiente->palavras * sizeof *cursor->entradas);
+        if (!tmp) {
+            cursor->falhou = true;
+            return false;
+        }
+        cursor->entradas = tmp;
+        cursor->capacidade_entradas = recipiente->palavras;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < TRIE_RAJADA_BALDES; i++) {
+        const balde_rajada* balde = recipiente->baldes[i];
+        if (!balde) {
+            continue;
+        }
+        const char* entrada = balde->dados;
+        const char* fim = balde->dados + balde->usados;
+        for (; entrada < fim;
+             entrada += tamanho_entrada(ler_tamanho(entrada))) {
+            if (ler_tamanho(entrada) >= tamanho_resto &&
+                memcmp(entrada + TAM_CABECALHO_ENTRADA,
+                       resto,
+                       tamanho_resto) == 0) {
+                cursor->entradas[total++] = entrada;
+            }
+        }
+    }
+
+    qsort(cursor->entradas, total, sizeof *cursor->entradas, comparar_entradas);
+    cursor->total_entradas = total;
+    cursor->proxima_entrada = 0;
+    cursor->profundidade_recipiente = profundidade;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Empilha um quadro para o nó, começando pela palavra do próprio
+ *   nó (código 0).
+ */
+static bool cursor_empilhar(trie_rajada_cursor* cursor,
+                            const no_rajada* no,
+                            size_t profundidade) {
+    if (cursor->topo == cursor->capacidade_pilha) {
+        size_t nova_cap =
+            cursor->capacidade_pilha ? cursor->capacidade_pilha * 2 : 32;
+        trie_rajada_quadro* tmp =
+            realloc(cursor->pilha, nova_cap * sizeof *cursor->pilha);
+        if (!tmp) {
+            cursor->falhou = true;
+            return false;
+        }
+        cursor->pilha = tmp;
+        cursor->capacidade_pilha = nova_cap;
+    }
+
+    cursor->pilha[cursor->topo++] = (trie_rajada_quadro){
+        .no = no, .proximo = 0, .profundidade = profundidade};
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Copia o prefixo para o buffer e desce por ele.
+ * - Se o prefixo terminar em um nó, empilha esse nó; se chegar a um
+ *   recipiente, carrega dele apenas as entradas que completam o
+ *   prefixo, e não há pilha.
+ */
+bool trie_rajada_cursor_abrir(trie_rajada_cursor* cursor,
+                              const trie_rajada* trie,
+                              const char* prefixo) {
+    *cursor = (trie_rajada_cursor){0};
+    if (!trie) {
+        return true;
+    }
+
+    size_t len = prefixo ? strlen(prefixo) : 0;
+    if (!garantir_tamanho_buffer(
+            &cursor->buffer, &cursor->capacidade_buffer, len + 1)) {
+        cursor->falhou = true;
+        return false;
+    }
+    // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+    memcpy(cursor->buffer, prefixo ? prefixo : "", len);
+    cursor->buffer[len] = '\0';
+
+    const no_rajada* no = trie->raiz;
+    for (size_t i = 0; i < len; i++) {
+        int c = codigo_de(cursor->buffer[i]);
+        const void* filho = c ? no->filhos[c - 1] : NULL;
+        if (!filho) {
+            return true;
+        }
+        if (no->recipientes & bit_de(c)) {
+            return carregar_recipiente(
+                cursor, filho, i + 1, cursor->buffer + i + 1, len - i - 1);
+        }
+        no = filho;
+    }
+
+    return cursor_empilhar(cursor, no, len);
+}
+
+/*
+ * Implementação:
+ * - Entradas carregadas de um recipiente saem primeiro, escritas no
+ *   buffer após o caminho até o recipiente.
+ * - Depois, o topo da pilha indica o nó e o próximo código: o código
+ *   0 devolve a palavra do próprio nó; os demais escrevem a letra no
+ *   buffer e descem ao filho, empilhando um nó ou carregando um
+ *   recipiente. Sem mais filhos, o quadro sai da pilha.
+ */
+const char* trie_rajada_cursor_proximo(trie_rajada_cursor* cursor) {
+    while (!cursor->falhou) {
+        if (cursor->proxima_entrada < cursor->total_entradas) {
+            const char* entrada = cursor->entradas[cursor->proxima_entrada++];
+            size_t n = ler_tamanho(entrada);
+            size_t profundidade = cursor->profundidade_recipiente;
+            if (!garantir_tamanho_buffer(&cursor->buffer,
+                                         &cursor->capacidade_buffer,
+                                         profundidade + n + 1)) {
+                cursor->falhou = true;
+                break;
+            }
+            // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+            memcpy(cursor->buffer + profundidade,
+                   entrada + TAM_CABECALHO_ENTRADA,
+                   n);
+            cursor->buffer[profundidade + n] = '\0';
+            return cursor->buffer;
+        }
+        if (cursor->topo == 0) {
+            break;
+        }
+
+        trie_rajada_quadro* q = &cursor->pilha[cursor->topo - 1];
+        const no_rajada* no = q->no;
+        size_t profundidade = q->profundidade;
+        if (q->proximo == 0) {
+            q->proximo = 1;
+            if (no->terminal) {
+                cursor->buffer[profundidade] = '\0';
+                return cursor->buffer;
+            }
+            continue;
+        }
+
+        int c = q->proximo;
+        while (c <= TRIE_RAJADA_LETRAS && !no->filhos[c - 1]) {
+            c++;
+        }
+        if (c > TRIE_RAJADA_LETRAS) {
+            cursor->topo--;
+            continue;
+        }
+        q->proximo = (uint8_t) (c + 1);
+
+        if (!garantir_tamanho_buffer(&cursor->buffer,
+                                     &cursor->capacidade_buffer,
+                                     profundidade + 2)) {
+            cursor->falhou = true;
+            break;
+        }
+        cursor->buffer[profundidade] = letra_de(c);
+        if (no->recipientes & bit_de(c)) {
+            carregar_recipiente(
+                cursor, no->filhos[c - 1], profundidade + 1, "", 0);
+        } else {
+            cursor_empilhar(cursor, no->filhos[c - 1], profundidade + 1);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Implementação:
+ * - Libera pilha, entradas e buffer e zera o cursor.
+ */
+void trie_rajada_cursor_fechar(trie_rajada_cursor* cursor) {
+    if (!cursor) {
+        return;
+    }
+
+    free(cursor->pilha);
+    free(cursor->entradas);
+    free(cursor->buffer);
+    *cursor = (trie_rajada_cursor){0};
+}
+
+/*
+ * Implementação:
+ * - Acumula profundidade e comprimento de uma palavra.
+ */
+static void registrar_palavra(varredura_rajada* v,
+                              size_t profundidade,
+                              size_t comprimento) {
+    v->palavras++;
+    v->soma_profundidades += profundidade;
+    v->soma_comprimentos += comprimento;
+    if (profundidade > v->saida->profundidade_maxima) {
+        v->saida->profundidade_maxima = profundidade;
+    }
+    if (comprimento > v->saida->comprimento_maximo) {
+        v->saida->comprimento_maximo = comprimento;
+    }
+}
+
+/*
+ * Implementação:
+ * - Registra a palavra do nó e as entradas de cada recipiente filho
+ *   (um acesso a mais que o nó) e desce pelos nós filhos.
+ */
+static void coletar_estatisticas_rec(const no_rajada* no,
+                                     size_t profundidade,
+                                     varredura_rajada* v) {
+    if (no->terminal) {
+        registrar_palavra(v, profundidade, profundidade);
+    }
+
+    for (int c = 1; c <= TRIE_RAJADA_LETRAS; c++) {
+        const void* filho = no->filhos[c - 1];
+        if (!filho) {
+            continue;
+        }
+        if (!(no->recipientes & bit_de(c))) {
+            coletar_estatisticas_rec(filho, profundidade + 1, v);
+            continue;
+        }
+
+        const recipiente_rajada* recipiente = filho;
+        for (size_t i = 0; i < TRIE_RAJADA_BALDES; i++) {
+            const balde_rajada* balde = recipiente->baldes[i];
+            if (!balde) {
+                continue;
+            }
+            const char* entrada = balde->dados;
+            const char* fim = balde->dados + balde->usados;
+            for (; entrada < fim;
+                 entrada += tamanho_entrada(ler_tamanho(entrada))) {
+                registrar_palavra(v,
+                                  profundidade + 1,
+                                  profundidade + 1 + ler_tamanho(entrada));
+            }
+        }
+    }
+}
+
+/*
+ * Implementação:
+ * - Percorre a partir da raiz e calcula as médias.
+ */
+void trie_rajada_coletar_estatisticas(const trie_rajada* trie,
+                                      estatisticas_trie* estatisticas) {
+    *estatisticas = (estatisticas_trie){0};
+    if (!trie || trie->total_palavras == 0) {
+        return;
+    }
+
+    varredura_rajada v = {.saida = estatisticas};
+    coletar_estatisticas_rec(trie->raiz, 0, &v);
+
+    if (v.palavras > 0) {
+        estatisticas->profundidade_media =
+            (double) v.soma_profundidades / (double) v.palavras;
+        estatisticas->comprimento_medio =
+            (double) v.soma_comprimentos / (double) v.palavras;
+    }
+}
+
+/*
+ * Implementação:
+ * - Nós e recipientes inteiros mais os bytes de entradas.
+ */
+size_t trie_rajada_bytes_usados(const trie_rajada* trie) {
+    return (trie->nos * sizeof(no_rajada)) +
+           (trie->total_recipientes * sizeof(recipiente_rajada)) +
+           trie->bytes_baldes;
+}
+
+/*
+ * Implementação:
+ * - Nós e recipientes inteiros mais a capacidade dos baldes.
+ */
+size_t trie_rajada_bytes_reservados(const trie_rajada* trie) {
+    return (trie->nos * sizeof(no_rajada)) +
+           (trie->total_recipientes * sizeof(recipiente_rajada)) +
+           trie->capacidade_baldes;
+}
@@ -5,6 +5,8 @@
 
 #include "util.h"
 
+#include "normalizacao.h"
+
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
@@ -75,6 +77,38 @@ void string_para_minusculo(char* s) {
     }
 }
 
+/*
+ * Implementação:
+ * - Ignora espaços nas pontas do trecho.
+ * - Copia o restante com normalizar_letras, que converte A-Z para
+ *   minúsculo e para no primeiro caractere fora de a-z/A-Z.
+ * - Rejeita palavras com mais de NORMALIZACAO_MAX_LETRAS letras sem
+ *   copiá-las.
+ * - Em caso de rejeição, destino fica com a cópia parcial.
+ */
+int normalizar_trecho(const char* trecho, size_t tamanho, char* destino) {
+    const char* inicio = trecho;
+    const char* fim = trecho + tamanho;
+
+    while (inicio < fim && isspace((unsigned char) *inicio)) {
+        inicio++;
+    }
+    while (fim > inicio && isspace((unsigned char) *(fim - 1))) {
+        fim--;
+    }
+
+    size_t tamanho_palavra = (size_t) (fim - inicio);
+    if (tamanho_palavra > NORMALIZACAO_MAX_LETRAS) {
+        destino[0] = '\0';
+        return 0;
+    }
+
+    size_t letras = normalizar_letras(inicio, tamanho_palavra, destino);
+    destino[letras] = '\0';
+
+    return letras == tamanho_palavra;
+}
+
 /*
  * Implementação:
  * - Realiza a cópia caractere a caractere da string.
@@ -90,3 +124,55 @@ char* string_dup(const char* s) {
     }
     return d;
 }
+
+/*
+ * Implementação:
+ * - Assume capacidade inicial como 8.
+ * - Quando tamanho for igual a capacidade, capacidade é dobrada.
+ */
+bool lista_push(lista_palavras* l, const char* palavra) {
+    if (l->tamanho == l->capacidade) {
+        size_t nova_cap = l->capacidade ? l->capacidade * 2 : 8;
+        char** tmp =
+            (char**) realloc((void*) l->palavras, nova_cap * sizeof *tmp);
+        if (!tmp) {
+            return false;
+        }
+        l->palavras = tmp;
+        l->capacidade = nova_cap;
+    }
+
+    char* dup = string_dup(palavra);
+    if (!dup) {
+        return false;
+    }
+
+    l->palavras[l->tamanho++] = dup;
+    return true;
+}
+
+/*
+ * Implementação:
+ * - Função utilitária para garantir crescimento seguro de buffer.
+ * - Assume capacidade inicial de 32.
+ * - Quando necessário, dobra a capacidade.
+ */
+bool garantir_tamanho_buffer(char** buf, size_t* cap, size_t necessario) {
+    if (necessario <= *cap) {
+        return true;
+    }
+
+    size_t nova_cap = *cap ? *cap * 2 : 32;
+    while (nova_cap < necessario) {
+        nova_cap *= 2;
+    }
+
+    char* tmp = realloc(*buf, nova_cap);
+    if (!tmp) {
+        return false;
+    }
+
+    *buf = tmp;
+    *cap = nova_cap;
+    return true;
+}